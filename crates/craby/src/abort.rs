@@ -0,0 +1,72 @@
+//! Cooperative cancellation of `Promise` methods.
+//!
+//! A method with an `AbortSignal` parameter receives an [`AbortSignal`] that is aborted when the
+//! JavaScript `AbortSignal` passed to the call fires `abort`. The promise is rejected right away and
+//! the call is skipped if it has not started yet, while a running method polls the signal to stop early:
+//!
+//! ```rust,ignore
+//! fn checksum(&mut self, path: &str, signal: AbortSignal) -> Promise<Number> {
+//!     let mut hash = 0;
+//!     for chunk in read_chunks(path)? {
+//!         signal.throw_if_aborted()?;
+//!         hash = update(hash, &chunk);
+//!     }
+//!     promise::resolve(hash)
+//! }
+//! ```
+use std::sync::{
+    atomic::{AtomicBool, Ordering},
+    Arc,
+};
+
+/// Error message of the rejected promise of an aborted call.
+pub const ABORTED: &str = "This operation was aborted";
+
+/// Cancellation state of a call, shared with the JavaScript `AbortSignal` it was made with.
+#[derive(Clone, Default)]
+pub struct AbortSignal {
+    aborted: Arc<AtomicBool>,
+}
+
+impl AbortSignal {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Returns `true` once the call was aborted.
+    pub fn aborted(&self) -> bool {
+        self.aborted.load(Ordering::Acquire)
+    }
+
+    /// Returns an error once the call was aborted (eg. `signal.throw_if_aborted()?`).
+    pub fn throw_if_aborted(&self) -> Result<(), anyhow::Error> {
+        if self.aborted() {
+            anyhow::bail!(ABORTED);
+        }
+        Ok(())
+    }
+
+    /// Aborts the call (called by the C++ side when the JavaScript `AbortSignal` fires `abort`).
+    pub fn abort(&self) {
+        self.aborted.store(true, Ordering::Release);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_abort() {
+        let signal = AbortSignal::new();
+        let cloned = signal.clone();
+
+        assert!(!cloned.aborted());
+        assert!(cloned.throw_if_aborted().is_ok());
+
+        signal.abort();
+
+        assert!(cloned.aborted());
+        assert_eq!(cloned.throw_if_aborted().unwrap_err().to_string(), ABORTED);
+    }
+}
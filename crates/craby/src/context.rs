@@ -1,3 +1,7 @@
+use std::path::{Component, Path};
+
+use crate::mmap::MappedFile;
+
 /// The context of the Craby Module.
 pub struct Context {
     /// This is a unique identifier(pointer address) for the current TurboModule instance.
@@ -18,4 +22,26 @@ impl Context {
             data_path: data_path.to_string(),
         }
     }
+
+    /// Runs `f` with a cleared scratch buffer reused across the calls on the current thread (see [`crate::scratch`]).
+    pub fn scratch<R>(&self, f: impl FnOnce(&mut Vec<u8>) -> R) -> R {
+        crate::scratch::with_scratch(f)
+    }
+
+    /// Maps the file at `path`, relative to [`Context::data_path`] (see [`crate::mmap`]).
+    ///
+    /// Absolute paths and paths with `..` are rejected, so only files within the data directory are mapped.
+    pub fn map_file(&self, path: impl AsRef<Path>) -> Result<MappedFile, anyhow::Error> {
+        let path = path.as_ref();
+        if !path
+            .components()
+            .all(|c| matches!(c, Component::Normal(..) | Component::CurDir))
+        {
+            anyhow::bail!("Path must be relative to the data path: {}", path.display());
+        }
+
+        let path = Path::new(&self.data_path).join(path);
+        MappedFile::open(&path)
+            .map_err(|e| anyhow::anyhow!("Failed to map {}: {e}", path.display()))
+    }
 }
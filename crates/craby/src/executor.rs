@@ -0,0 +1,427 @@
+//! Lightweight executor for the futures of `async` methods (`@executor async`).
+//!
+//! Futures are polled by a handful of worker threads shared by all modules and only hold a worker while
+//! they are being polled, so thousands of pending calls don't need thousands of threads.
+//!
+//! These threads (`craby-async-N` and `craby-timer`) are not the workers of the generated C++ executor, so the
+//! `[executor]` section of `craby.toml` (count, priority, affinity, names) doesn't apply to them.
+//!
+//! The executor has no I/O reactor. Await futures that are woken from other threads (channels, [`sleep`],
+//! libraries that drive their own reactor), not futures that require a specific runtime (eg. Tokio).
+//!
+//! ```rust,ignore
+//! fn fetch_report(&mut self, id: Number) -> AsyncPromise<String> {
+//!     let client = self.client.clone();
+//!     Box::pin(async move {
+//!         let report = client.fetch(id).await?;
+//!         craby::executor::sleep(Duration::from_millis(100)).await;
+//!         promise::resolve(report)
+//!     })
+//! }
+//! ```
+use std::{
+    cmp::Reverse,
+    collections::{BinaryHeap, VecDeque},
+    future::Future,
+    pin::Pin,
+    sync::{
+        atomic::{AtomicBool, AtomicU64, Ordering},
+        Arc, Condvar, Mutex, OnceLock,
+    },
+    task::{Context, Poll, Wake, Waker},
+    thread,
+    time::{Duration, Instant},
+};
+
+use crate::types::Promise;
+
+/// Maximum number of worker threads.
+pub const MAX_WORKERS: usize = 4;
+
+/// Boxed future returned by `async` methods.
+pub type AsyncPromise<T> = Pin<Box<dyn Future<Output = Promise<T>> + Send + 'static>>;
+
+type BoxFuture = Pin<Box<dyn Future<Output = ()> + Send + 'static>>;
+
+struct Task {
+    future: Mutex<Option<BoxFuture>>,
+    /// `true` while the task is in the run queue (wakes are coalesced)
+    queued: AtomicBool,
+}
+
+impl Task {
+    fn schedule(self: Arc<Self>) {
+        if !self.queued.swap(true, Ordering::AcqRel) {
+            executor().push(self);
+        }
+    }
+
+    fn run(self: Arc<Self>) {
+        let mut future = self.future.lock().unwrap();
+        // Cleared while holding the lock: a wake from now on queues the task again and the next poll
+        // happens after this one, a wake before it is coalesced into this poll
+        self.queued.store(false, Ordering::Release);
+
+        let waker = Waker::from(self.clone());
+        let mut cx = Context::from_waker(&waker);
+        if let Some(fut) = future.as_mut() {
+            if fut.as_mut().poll(&mut cx).is_ready() {
+                *future = None;
+            }
+        }
+    }
+}
+
+impl Wake for Task {
+    fn wake(self: Arc<Self>) {
+        self.schedule();
+    }
+
+    fn wake_by_ref(self: &Arc<Self>) {
+        self.clone().schedule();
+    }
+}
+
+struct Executor {
+    queue: Mutex<VecDeque<Arc<Task>>>,
+    available: Condvar,
+}
+
+impl Executor {
+    fn push(&self, task: Arc<Task>) {
+        self.queue.lock().unwrap().push_back(task);
+        self.available.notify_one();
+    }
+
+    fn work(&self) {
+        loop {
+            let task = {
+                let mut queue = self.queue.lock().unwrap();
+                loop {
+                    match queue.pop_front() {
+                        Some(task) => break task,
+                        None => queue = self.available.wait(queue).unwrap(),
+                    }
+                }
+            };
+            task.run();
+        }
+    }
+}
+
+fn executor() -> &'static Executor {
+    static EXECUTOR: OnceLock<Executor> = OnceLock::new();
+    static STARTED: OnceLock<()> = OnceLock::new();
+
+    let instance = EXECUTOR.get_or_init(|| Executor {
+        queue: Mutex::new(VecDeque::new()),
+        available: Condvar::new(),
+    });
+
+    STARTED.get_or_init(|| {
+        let count = thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(2)
+            .clamp(2, MAX_WORKERS);
+
+        for index in 0..count {
+            thread::Builder::new()
+                .name(format!("craby-async-{index}"))
+                .spawn(|| executor().work())
+                .expect("Failed to spawn executor worker");
+        }
+    });
+
+    instance
+}
+
+/// Runs the future on the executor.
+pub fn spawn(future: impl Future<Output = ()> + Send + 'static) {
+    let task = Arc::new(Task {
+        future: Mutex::new(Some(Box::pin(future))),
+        queued: AtomicBool::new(false),
+    });
+    task.schedule();
+}
+
+/// Runs the future of an `async` method on the executor and calls `complete` with its result.
+///
+/// A panic while polling the future completes it with an error, so `complete` is always called once.
+pub fn spawn_promise<T: Send + 'static>(
+    future: AsyncPromise<T>,
+    complete: impl FnOnce(Promise<T>) + Send + 'static,
+) {
+    spawn(CatchUnwind {
+        future,
+        complete: Some(Box::new(complete)),
+    });
+}
+
+struct CatchUnwind<T> {
+    future: AsyncPromise<T>,
+    complete: Option<Box<dyn FnOnce(Promise<T>) + Send>>,
+}
+
+impl<T> Future for CatchUnwind<T> {
+    type Output = ();
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<()> {
+        let ret = match catch_panic!(self.future.as_mut().poll(cx)) {
+            Ok(Poll::Pending) => return Poll::Pending,
+            Ok(Poll::Ready(ret)) => ret,
+            Err(err) => Err(err),
+        };
+
+        if let Some(complete) = self.complete.take() {
+            complete(ret);
+        }
+        Poll::Ready(())
+    }
+}
+
+/// Future that completes after the duration.
+pub fn sleep(duration: Duration) -> Sleep {
+    Sleep {
+        deadline: Instant::now() + duration,
+        waker: None,
+    }
+}
+
+/// Future returned by [`sleep`].
+pub struct Sleep {
+    deadline: Instant,
+    /// Waker shared with the timer entry, registered on the first pending poll
+    waker: Option<Arc<Mutex<Option<Waker>>>>,
+}
+
+impl Future for Sleep {
+    type Output = ();
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<()> {
+        if Instant::now() >= self.deadline {
+            return Poll::Ready(());
+        }
+
+        match &self.waker {
+            // Already registered (eg. a spurious poll): only swap the waker if the task moved
+            Some(waker) => {
+                let mut waker = waker.lock().unwrap();
+                if !waker.as_ref().is_some_and(|w| w.will_wake(cx.waker())) {
+                    *waker = Some(cx.waker().clone());
+                }
+            }
+            None => {
+                let waker = Arc::new(Mutex::new(Some(cx.waker().clone())));
+                timer().register(self.deadline, waker.clone());
+                self.waker = Some(waker);
+            }
+        }
+        Poll::Pending
+    }
+}
+
+impl Drop for Sleep {
+    fn drop(&mut self) {
+        // The timer entry stays until its deadline, it must not wake the task anymore
+        if let Some(waker) = &self.waker {
+            waker.lock().unwrap().take();
+        }
+    }
+}
+
+struct Timer {
+    // Min-heap of the deadlines, the sequence number keeps the entries ordered without comparing wakers
+    entries: Mutex<BinaryHeap<Reverse<(Instant, u64, WakerEntry)>>>,
+    changed: Condvar,
+}
+
+struct WakerEntry(Arc<Mutex<Option<Waker>>>);
+
+impl PartialEq for WakerEntry {
+    fn eq(&self, _: &Self) -> bool {
+        true
+    }
+}
+
+impl Eq for WakerEntry {}
+
+impl PartialOrd for WakerEntry {
+    fn partial_cmp(&self, other: &Self) -> Option<std::cmp::Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+impl Ord for WakerEntry {
+    fn cmp(&self, _: &Self) -> std::cmp::Ordering {
+        std::cmp::Ordering::Equal
+    }
+}
+
+impl Timer {
+    fn register(&self, deadline: Instant, waker: Arc<Mutex<Option<Waker>>>) {
+        static SEQ: AtomicU64 = AtomicU64::new(0);
+        let seq = SEQ.fetch_add(1, Ordering::Relaxed);
+
+        self.entries
+            .lock()
+            .unwrap()
+            .push(Reverse((deadline, seq, WakerEntry(waker))));
+        self.changed.notify_one();
+    }
+
+    fn work(&self) {
+        let mut entries = self.entries.lock().unwrap();
+        loop {
+            let now = Instant::now();
+            while let Some(Reverse((deadline, ..))) = entries.peek() {
+                if *deadline > now {
+                    break;
+                }
+                let Reverse((_, _, WakerEntry(entry))) = entries.pop().unwrap();
+                let waker = entry.lock().unwrap().take();
+                if let Some(waker) = waker {
+                    waker.wake();
+                }
+            }
+
+            entries = match entries.peek() {
+                Some(Reverse((deadline, ..))) => {
+                    let timeout = deadline.saturating_duration_since(now);
+                    self.changed.wait_timeout(entries, timeout).unwrap().0
+                }
+                None => self.changed.wait(entries).unwrap(),
+            };
+        }
+    }
+}
+
+fn timer() -> &'static Timer {
+    static TIMER: OnceLock<Timer> = OnceLock::new();
+    static STARTED: OnceLock<()> = OnceLock::new();
+
+    let instance = TIMER.get_or_init(|| Timer {
+        entries: Mutex::new(BinaryHeap::new()),
+        changed: Condvar::new(),
+    });
+
+    STARTED.get_or_init(|| {
+        thread::Builder::new()
+            .name("craby-timer".to_string())
+            .spawn(|| timer().work())
+            .expect("Failed to spawn timer");
+    });
+
+    instance
+}
+
+#[cfg(test)]
+mod tests {
+    use std::sync::mpsc;
+
+    use super::*;
+
+    struct NoopWaker;
+
+    impl Wake for NoopWaker {
+        fn wake(self: Arc<Self>) {}
+    }
+
+    // Wakes itself on every poll until it was polled `remaining` times
+    struct YieldNow {
+        remaining: usize,
+    }
+
+    impl Future for YieldNow {
+        type Output = ();
+
+        fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<()> {
+            if self.remaining == 0 {
+                return Poll::Ready(());
+            }
+            self.remaining -= 1;
+            cx.waker().wake_by_ref();
+            Poll::Pending
+        }
+    }
+
+    #[test]
+    fn test_spawn_promise() {
+        let (tx, rx) = mpsc::channel();
+
+        for i in 0..100 {
+            let tx = tx.clone();
+            spawn_promise(
+                Box::pin(async move {
+                    sleep(Duration::from_millis(10)).await;
+                    Ok(i)
+                }),
+                move |ret| tx.send(ret.unwrap()).unwrap(),
+            );
+        }
+
+        let mut results = (0..100)
+            .map(|_| rx.recv_timeout(Duration::from_secs(5)).unwrap())
+            .collect::<Vec<_>>();
+        results.sort();
+
+        assert_eq!(results, (0..100).collect::<Vec<_>>());
+    }
+
+    #[test]
+    fn test_spawn_promise_panic() {
+        let (tx, rx) = mpsc::channel();
+
+        spawn_promise::<()>(Box::pin(async move { panic!("Boom!") }), move |ret| {
+            tx.send(ret.unwrap_err().to_string()).unwrap()
+        });
+
+        assert_eq!(rx.recv_timeout(Duration::from_secs(5)).unwrap(), "Boom!");
+    }
+
+    #[test]
+    fn test_wake_while_polling() {
+        let (tx, rx) = mpsc::channel();
+
+        for i in 0..100 {
+            let tx = tx.clone();
+            spawn(async move {
+                YieldNow { remaining: 100 }.await;
+                tx.send(i).unwrap();
+            });
+        }
+
+        let mut results = (0..100)
+            .map(|_| rx.recv_timeout(Duration::from_secs(5)).unwrap())
+            .collect::<Vec<_>>();
+        results.sort();
+
+        assert_eq!(results, (0..100).collect::<Vec<_>>());
+    }
+
+    #[test]
+    fn test_sleep() {
+        let (tx, rx) = mpsc::channel();
+        let started = Instant::now();
+
+        spawn(async move {
+            sleep(Duration::from_millis(50)).await;
+            tx.send(started.elapsed()).unwrap();
+        });
+
+        assert!(rx.recv_timeout(Duration::from_secs(5)).unwrap() >= Duration::from_millis(50));
+    }
+
+    #[test]
+    fn test_sleep_registers_once() {
+        let mut sleep = Box::pin(sleep(Duration::from_secs(60)));
+        let waker = Waker::from(Arc::new(NoopWaker));
+        let mut cx = Context::from_waker(&waker);
+
+        for _ in 0..10 {
+            assert!(sleep.as_mut().poll(&mut cx).is_pending());
+        }
+
+        // Held by the future and a single timer entry
+        assert_eq!(Arc::strong_count(sleep.waker.as_ref().unwrap()), 2);
+    }
+}
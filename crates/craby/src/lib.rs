@@ -3,12 +3,25 @@ pub mod macros;
 
 /// This module provides the prelude for Craby Modules.
 pub mod prelude {
+    pub use crate::abort::AbortSignal;
     pub use crate::context::*;
+    pub use crate::executor::AsyncPromise;
+    pub use crate::mmap::MappedFile;
+    pub use crate::shared::{SharedMemory, SharedState};
+    pub use crate::stream::ByteStream;
     pub use crate::types::*;
     pub use craby_macro::craby_module;
 }
 
+pub mod abort;
 pub mod context;
+pub mod executor;
+pub mod mmap;
+pub mod pool;
+pub mod scratch;
+pub mod shared;
+pub mod simd;
+pub mod stream;
 pub mod types;
 
 // craby_marco crate
@@ -0,0 +1,232 @@
+//! Memory-mapped files for reading large files without copying them into the heap.
+//!
+//! A method returning `MappedFile` hands JavaScript an `ArrayBuffer` backed by the mapping, so the pages are
+//! loaded from the file when they are read and the file is never copied (eg. databases or model files):
+//!
+//! ```rust,ignore
+//! fn load_model(&mut self) -> MappedFile {
+//!     self.ctx.map_file("model.bin").expect("failed to map the model")
+//! }
+//! ```
+//!
+//! The pages are mapped copy-on-write: JavaScript can write the `ArrayBuffer`, but the writes stay in private copies
+//! of the written pages and never reach the file.
+//! The file is unmapped when the `ArrayBuffer` is garbage-collected.
+//!
+//! Reading a page past the end of a file that was truncated after it was mapped raises `SIGBUS`, which also
+//! crashes the app. Replace mapped files instead of rewriting them in place: write a temporary file and
+//! rename it over the mapped one (the mapping keeps the previous file).
+use std::{fs::File, io, path::Path};
+
+/// Private (copy-on-write) mapping of a whole file (see the module docs).
+pub struct MappedFile {
+    ptr: *mut u8,
+    len: usize,
+}
+
+// The mapping is owned by the `MappedFile`, Rust only reads it through shared references
+unsafe impl Send for MappedFile {}
+unsafe impl Sync for MappedFile {}
+
+impl MappedFile {
+    /// Maps the whole file at `path`.
+    ///
+    /// Changes to the file after it is mapped may or may not be visible, and truncating it raises `SIGBUS` on the
+    /// next read of the truncated pages: do not write files that are mapped, replace them (see the module docs).
+    pub fn open(path: impl AsRef<Path>) -> io::Result<Self> {
+        let file = File::open(path)?;
+        let len = usize::try_from(file.metadata()?.len())
+            .map_err(|_| io::Error::new(io::ErrorKind::InvalidInput, "file is too large to map"))?;
+
+        Self::map(&file, len)
+    }
+
+    /// Address of the mapping.
+    pub fn data(&self) -> usize {
+        self.ptr as usize
+    }
+
+    /// Size of the mapping in bytes.
+    pub fn size(&self) -> usize {
+        self.len
+    }
+
+    /// Contents of the file.
+    pub fn as_slice(&self) -> &[u8] {
+        // An empty file has no mapping, `ptr` is dangling
+        unsafe { std::slice::from_raw_parts(self.ptr, self.len) }
+    }
+
+    #[cfg(unix)]
+    fn map(file: &File, len: usize) -> io::Result<Self> {
+        use std::os::fd::AsRawFd;
+
+        // `mmap` rejects empty mappings
+        if len == 0 {
+            return Ok(Self::empty());
+        }
+
+        // Writable so that the `ArrayBuffer` given to JavaScript can be written, `MAP_PRIVATE` keeps the writes out of the
+        // file (the file itself is opened read-only)
+        let ptr = unsafe {
+            libc::mmap(
+                std::ptr::null_mut(),
+                len,
+                libc::PROT_READ | libc::PROT_WRITE,
+                libc::MAP_PRIVATE,
+                file.as_raw_fd(),
+                0,
+            )
+        };
+        if ptr == libc::MAP_FAILED {
+            return Err(io::Error::last_os_error());
+        }
+
+        Ok(MappedFile {
+            ptr: ptr as *mut u8,
+            len,
+        })
+    }
+
+    /// Platforms without `mmap` read the file into a leaked buffer, released on drop.
+    #[cfg(not(unix))]
+    fn map(file: &File, len: usize) -> io::Result<Self> {
+        use std::io::Read;
+
+        if len == 0 {
+            return Ok(Self::empty());
+        }
+
+        let mut buf = Vec::with_capacity(len);
+        (&*file).take(len as u64).read_to_end(&mut buf)?;
+        let buf = Box::leak(buf.into_boxed_slice());
+
+        Ok(MappedFile {
+            ptr: buf.as_mut_ptr(),
+            len: buf.len(),
+        })
+    }
+
+    fn empty() -> Self {
+        MappedFile {
+            ptr: std::ptr::NonNull::dangling().as_ptr(),
+            len: 0,
+        }
+    }
+}
+
+impl std::ops::Deref for MappedFile {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        self.as_slice()
+    }
+}
+
+impl Drop for MappedFile {
+    fn drop(&mut self) {
+        if self.len == 0 {
+            return;
+        }
+
+        #[cfg(unix)]
+        unsafe {
+            libc::munmap(self.ptr as *mut libc::c_void, self.len);
+        }
+
+        #[cfg(not(unix))]
+        unsafe {
+            drop(Box::from_raw(std::ptr::slice_from_raw_parts_mut(
+                self.ptr, self.len,
+            )));
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn temp_file(name: &str, contents: &[u8]) -> std::path::PathBuf {
+        let path = std::env::temp_dir().join(format!("craby-mmap-{}-{name}", std::process::id()));
+        std::fs::write(&path, contents).unwrap();
+        path
+    }
+
+    #[test]
+    fn test_map_file() {
+        let path = temp_file("data", b"hello, craby");
+        let file = MappedFile::open(&path).unwrap();
+
+        assert_eq!(file.size(), 12);
+        assert_eq!(&*file, b"hello, craby");
+
+        drop(file);
+        std::fs::remove_file(path).unwrap();
+    }
+
+    #[test]
+    fn test_map_file_copy_on_write() {
+        let path = temp_file("cow", b"abc");
+        let file = MappedFile::open(&path).unwrap();
+
+        // Writes through the mapping (eg. from JavaScript) don't reach the file
+        unsafe { *(file.data() as *mut u8) = b'x' };
+
+        assert_eq!(&*file, b"xbc");
+        assert_eq!(std::fs::read(&path).unwrap(), b"abc");
+
+        drop(file);
+        std::fs::remove_file(path).unwrap();
+    }
+
+    #[test]
+    fn test_map_empty_file() {
+        let path = temp_file("empty", b"");
+        let file = MappedFile::open(&path).unwrap();
+
+        assert_eq!(file.size(), 0);
+        assert!(file.is_empty());
+
+        drop(file);
+        std::fs::remove_file(path).unwrap();
+    }
+
+    #[test]
+    fn test_map_replaced_file() {
+        let path = temp_file("replaced", b"abc");
+        let file = MappedFile::open(&path).unwrap();
+
+        // A file replaced by a rename doesn't change the mapping of the previous one
+        let replacement = temp_file("replacement", b"x");
+        std::fs::rename(&replacement, &path).unwrap();
+
+        assert_eq!(&*file, b"abc");
+        assert_eq!(std::fs::read(&path).unwrap(), b"x");
+
+        drop(file);
+        std::fs::remove_file(path).unwrap();
+    }
+
+    #[test]
+    fn test_context_map_file() {
+        let path = temp_file("context", b"data");
+        let dir = path.parent().unwrap().to_str().unwrap();
+        let ctx = crate::context::Context::new(0, dir);
+
+        let file = ctx.map_file(path.file_name().unwrap()).unwrap();
+        assert_eq!(&*file, b"data");
+
+        assert!(ctx.map_file(&path).is_err());
+        assert!(ctx.map_file("../etc/hosts").is_err());
+
+        drop(file);
+        std::fs::remove_file(path).unwrap();
+    }
+
+    #[test]
+    fn test_map_missing_file() {
+        let err = MappedFile::open("/nonexistent/craby-mmap").err().unwrap();
+        assert_eq!(err.kind(), io::ErrorKind::NotFound);
+    }
+}
@@ -0,0 +1,192 @@
+//! Reusable byte buffer pool for `ArrayBuffer` return values.
+//!
+//! Returning an `ArrayBuffer` hands the `Vec<u8>` over to JavaScript. When the `ArrayBuffer`
+//! is garbage-collected, the buffer is given back to this pool instead of being freed,
+//! so the next [`take`] with a similar size reuses the allocation.
+//!
+//! The pool is disabled by default. Call [`enable`] once (e.g. in the module constructor) to opt in.
+//!
+//! ```rust,ignore
+//! craby::pool::enable(4);
+//!
+//! fn process_frame(&mut self, frame: &mut [u8]) -> ArrayBuffer {
+//!     let mut out = craby::pool::take(frame.len());
+//!     out.extend_from_slice(frame);
+//!     out
+//! }
+//! ```
+use std::sync::{
+    atomic::{AtomicU64, Ordering},
+    Mutex,
+};
+
+/// Smallest pooled size class (4 KiB). Smaller buffers are not worth pooling.
+const MIN_CLASS_SHIFT: u32 = 12;
+/// Largest pooled size class (64 MiB).
+const MAX_CLASS_SHIFT: u32 = 26;
+const NUM_CLASSES: usize = (MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1) as usize;
+
+struct Pool {
+    /// Maximum number of idle buffers kept per size class (`0` = disabled)
+    max_per_class: usize,
+    /// Idle buffers, indexed by size class
+    classes: Vec<Vec<Vec<u8>>>,
+}
+
+static POOL: Mutex<Pool> = Mutex::new(Pool {
+    max_per_class: 0,
+    classes: Vec::new(),
+});
+
+static HITS: AtomicU64 = AtomicU64::new(0);
+static MISSES: AtomicU64 = AtomicU64::new(0);
+static RECYCLED: AtomicU64 = AtomicU64::new(0);
+static DISCARDED: AtomicU64 = AtomicU64::new(0);
+
+/// Pool usage counters, used to size the pool.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct PoolStats {
+    /// `take` calls served by an idle buffer
+    pub hits: u64,
+    /// `take` calls that had to allocate
+    pub misses: u64,
+    /// Buffers given back to the pool
+    pub recycled: u64,
+    /// Buffers freed because their size class was full or out of range
+    pub discarded: u64,
+}
+
+fn lock() -> std::sync::MutexGuard<'static, Pool> {
+    // The pool holds no invariants that a panic could break
+    POOL.lock().unwrap_or_else(|e| e.into_inner())
+}
+
+/// Size class that can serve a request of `capacity` bytes (rounded up).
+fn class_for_take(capacity: usize) -> Option<usize> {
+    let shift = capacity
+        .max(1)
+        .next_power_of_two()
+        .trailing_zeros()
+        .max(MIN_CLASS_SHIFT);
+    (shift <= MAX_CLASS_SHIFT).then(|| (shift - MIN_CLASS_SHIFT) as usize)
+}
+
+/// Size class a buffer of `capacity` bytes can be stored in (rounded down).
+fn class_for_recycle(capacity: usize) -> Option<usize> {
+    if capacity < (1 << MIN_CLASS_SHIFT) {
+        return None;
+    }
+    let shift = usize::BITS - 1 - capacity.leading_zeros();
+    (shift <= MAX_CLASS_SHIFT).then(|| (shift - MIN_CLASS_SHIFT) as usize)
+}
+
+/// Enables the pool, keeping up to `max_per_class` idle buffers per size class.
+pub fn enable(max_per_class: usize) {
+    let mut pool = lock();
+    pool.max_per_class = max_per_class;
+    pool.classes.resize_with(NUM_CLASSES, Vec::new);
+    pool.classes
+        .iter_mut()
+        .for_each(|class| class.truncate(max_per_class));
+}
+
+/// Disables the pool and frees all idle buffers.
+pub fn disable() {
+    let mut pool = lock();
+    pool.max_per_class = 0;
+    pool.classes.clear();
+}
+
+/// Returns an empty `Vec<u8>` with at least `capacity` bytes of capacity.
+///
+/// Same as `Vec::with_capacity(capacity)`, but reuses an idle buffer if the pool is enabled.
+pub fn take(capacity: usize) -> Vec<u8> {
+    let mut pool = lock();
+    if pool.max_per_class == 0 {
+        return Vec::with_capacity(capacity);
+    }
+
+    let Some(class) = class_for_take(capacity) else {
+        MISSES.fetch_add(1, Ordering::Relaxed);
+        return Vec::with_capacity(capacity);
+    };
+
+    if let Some(buf) = pool.classes[class].pop() {
+        HITS.fetch_add(1, Ordering::Relaxed);
+        return buf;
+    }
+    drop(pool);
+
+    MISSES.fetch_add(1, Ordering::Relaxed);
+    // Allocate the full size class so the buffer can be reused for any request in this class
+    Vec::with_capacity(1 << (class as u32 + MIN_CLASS_SHIFT))
+}
+
+/// Gives a buffer back to the pool. The buffer is freed if the pool is disabled or full.
+///
+/// Called by the generated bridging code when a returned `ArrayBuffer` is garbage-collected.
+pub fn recycle(mut buf: Vec<u8>) {
+    let mut pool = lock();
+    if pool.max_per_class == 0 {
+        return;
+    }
+
+    let max_per_class = pool.max_per_class;
+    match class_for_recycle(buf.capacity()) {
+        Some(class) if pool.classes[class].len() < max_per_class => {
+            buf.clear();
+            pool.classes[class].push(buf);
+            RECYCLED.fetch_add(1, Ordering::Relaxed);
+        }
+        _ => {
+            drop(pool);
+            DISCARDED.fetch_add(1, Ordering::Relaxed);
+        }
+    }
+}
+
+/// Returns the pool usage counters.
+pub fn stats() -> PoolStats {
+    PoolStats {
+        hits: HITS.load(Ordering::Relaxed),
+        misses: MISSES.load(Ordering::Relaxed),
+        recycled: RECYCLED.load(Ordering::Relaxed),
+        discarded: DISCARDED.load(Ordering::Relaxed),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_size_classes() {
+        assert_eq!(class_for_take(1), Some(0));
+        assert_eq!(class_for_take(4096), Some(0));
+        assert_eq!(class_for_take(4097), Some(1));
+        assert_eq!(class_for_take(1 << 27), None);
+        assert_eq!(class_for_recycle(4095), None);
+        assert_eq!(class_for_recycle(8191), Some(0));
+        assert_eq!(class_for_recycle(8192), Some(1));
+        assert_eq!(class_for_recycle((1 << 26) + 1), Some(NUM_CLASSES - 1));
+        assert_eq!(class_for_recycle(1 << 27), None);
+    }
+
+    #[test]
+    fn test_take_and_recycle() {
+        enable(1);
+
+        let buf = take(5000);
+        assert!(buf.capacity() >= 8192);
+        let ptr = buf.as_ptr();
+        recycle(buf);
+
+        let before = stats();
+        let buf = take(6000);
+        assert_eq!(buf.as_ptr(), ptr);
+        assert!(buf.is_empty());
+        assert_eq!(stats().hits, before.hits + 1);
+
+        disable();
+    }
+}
@@ -0,0 +1,76 @@
+//! Per-thread scratch buffer for the temporaries of a method call.
+//!
+//! [`Context::scratch`](crate::context::Context::scratch) lends a cleared `Vec<u8>` that keeps its capacity
+//! across calls on the same thread, so building a temporary buffer (eg. to serialize or hash the arguments)
+//! doesn't allocate once the buffer has grown to the size of the calls.
+//!
+//! ```rust,ignore
+//! fn checksum(&mut self, text: &str) -> Number {
+//!     self.ctx.scratch(|buf| {
+//!         buf.extend(text.bytes().map(|b| b.to_ascii_lowercase()));
+//!         crc32(buf) as f64
+//!     })
+//! }
+//! ```
+use std::cell::RefCell;
+
+/// Capacity kept after a call, larger buffers are freed instead of being held by the thread.
+pub const MAX_RETAINED_CAPACITY: usize = 1 << 20;
+
+thread_local! {
+    static SCRATCH: RefCell<Vec<u8>> = const { RefCell::new(Vec::new()) };
+}
+
+/// Runs `f` with the cleared scratch buffer of the current thread.
+///
+/// A nested call gets a new buffer, the outer one is still lent.
+pub fn with_scratch<R>(f: impl FnOnce(&mut Vec<u8>) -> R) -> R {
+    SCRATCH.with(|scratch| match scratch.try_borrow_mut() {
+        Ok(mut buf) => {
+            buf.clear();
+            let ret = f(&mut buf);
+            if buf.capacity() > MAX_RETAINED_CAPACITY {
+                *buf = Vec::new();
+            }
+            ret
+        }
+        Err(_) => f(&mut Vec::new()),
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_with_scratch_reuses_the_buffer() {
+        let ptr = with_scratch(|buf| {
+            buf.extend_from_slice(b"hello");
+            buf.as_ptr() as usize
+        });
+
+        with_scratch(|buf| {
+            assert!(buf.is_empty());
+            assert!(buf.capacity() >= 5);
+            assert_eq!(buf.as_ptr() as usize, ptr);
+        });
+    }
+
+    #[test]
+    fn test_with_scratch_nested() {
+        with_scratch(|outer| {
+            outer.push(1);
+            with_scratch(|inner| {
+                assert!(inner.is_empty());
+                inner.push(2);
+            });
+            assert_eq!(outer, &[1]);
+        });
+    }
+
+    #[test]
+    fn test_with_scratch_drops_large_buffers() {
+        with_scratch(|buf| buf.resize(MAX_RETAINED_CAPACITY + 1, 0));
+        with_scratch(|buf| assert_eq!(buf.capacity(), 0));
+    }
+}
@@ -0,0 +1,230 @@
+//! Shared memory between Rust and JavaScript for state that JavaScript polls.
+//!
+//! A method returning `SharedState<T>` hands JavaScript typed array views of the state's memory,
+//! so JavaScript reads the latest value (`readSharedState` of `craby-modules`) without calling native.
+//! The Rust side keeps a clone of the [`SharedState`] and writes it from any thread:
+//!
+//! ```rust,ignore
+//! fn position(&mut self) -> SharedState<Position> {
+//!     self.position.clone()
+//! }
+//!
+//! // eg. on the sensor thread
+//! position.write(&Position { x, y });
+//! ```
+//!
+//! The memory is laid out as `[sequence, ...fields]`, 8 bytes each: the sequence is a `u64` counter and
+//! the fields are `f64`. Writes are ordered by a seqlock: the sequence is odd while a write is in progress
+//! and increases on every write, so readers retry instead of seeing fields of different writes.
+//!
+//! JavaScript gets the sequence and the fields as separate views (`Int32Array` of the low half of the
+//! sequence, `Float64Array` of the fields), loads the sequence with `Atomics.load` where the engine has it,
+//! and `readSharedState` returns a copy of the fields. JavaScript must not write the views: the fields
+//! would be overwritten by the next write of the Rust side.
+use std::{
+    marker::PhantomData,
+    sync::{
+        atomic::{fence, AtomicU64, Ordering},
+        Arc, Mutex,
+    },
+};
+
+/// Object type with `number` fields only, stored in a [`SharedState`].
+///
+/// Implemented by the generated code for the object types of `SharedState<T>`.
+pub trait SharedFields: Sized {
+    /// Number of fields
+    const COUNT: usize;
+
+    /// Stores the fields by their index in declaration order.
+    fn store_fields(&self, store: impl FnMut(usize, f64));
+
+    /// Creates the value from the fields loaded by their index in declaration order.
+    fn load_fields(load: impl FnMut(usize) -> f64) -> Self;
+}
+
+struct Memory {
+    /// `[sequence, ...fields]`, the fields as `f64` bits
+    slots: Box<[AtomicU64]>,
+    /// Serializes the writers (a seqlock allows a single writer at a time)
+    writer: Mutex<()>,
+}
+
+/// Untyped memory of a [`SharedState`], exposed to JavaScript as an `ArrayBuffer`.
+///
+/// The JavaScript `ArrayBuffer` holds a reference, so the memory outlives the module if JavaScript still uses it.
+pub struct SharedMemory {
+    memory: Arc<Memory>,
+}
+
+impl SharedMemory {
+    /// Address of the memory.
+    pub fn data(&self) -> usize {
+        self.memory.slots.as_ptr() as usize
+    }
+
+    /// Size of the memory in bytes.
+    pub fn size(&self) -> usize {
+        std::mem::size_of_val(&*self.memory.slots)
+    }
+}
+
+/// State of `T` shared with JavaScript, cloned to write it from other threads.
+pub struct SharedState<T: SharedFields> {
+    memory: Arc<Memory>,
+    _marker: PhantomData<fn(T) -> T>,
+}
+
+impl<T: SharedFields> SharedState<T> {
+    /// Creates a state with every field set to `0`.
+    pub fn new() -> Self {
+        // `0` is both the initial sequence and the bits of `0.0`
+        let slots = (0..T::COUNT + 1)
+            .map(|_| AtomicU64::new(0))
+            .collect::<Box<[_]>>();
+
+        Self {
+            memory: Arc::new(Memory {
+                slots,
+                writer: Mutex::new(()),
+            }),
+            _marker: PhantomData,
+        }
+    }
+
+    /// Writes the value, visible to the next read of JavaScript.
+    pub fn write(&self, value: &T) {
+        let slots = &self.memory.slots;
+        let _guard = self.memory.writer.lock().unwrap();
+        let seq = slots[0].load(Ordering::Relaxed);
+
+        slots[0].store(seq.wrapping_add(1), Ordering::Relaxed);
+        fence(Ordering::Release);
+        value.store_fields(|index, field| {
+            slots[index + 1].store(field.to_bits(), Ordering::Relaxed)
+        });
+        slots[0].store(seq.wrapping_add(2), Ordering::Release);
+    }
+
+    /// Reads the latest value.
+    pub fn read(&self) -> T {
+        let slots = &self.memory.slots;
+
+        loop {
+            let seq = slots[0].load(Ordering::Acquire);
+            let value =
+                T::load_fields(|index| f64::from_bits(slots[index + 1].load(Ordering::Relaxed)));
+            fence(Ordering::Acquire);
+
+            // Retry if a write was in progress or completed in the meantime
+            if seq % 2 == 0 && slots[0].load(Ordering::Relaxed) == seq {
+                return value;
+            }
+            std::hint::spin_loop();
+        }
+    }
+}
+
+impl<T: SharedFields> Default for SharedState<T> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<T: SharedFields> Clone for SharedState<T> {
+    fn clone(&self) -> Self {
+        Self {
+            memory: self.memory.clone(),
+            _marker: PhantomData,
+        }
+    }
+}
+
+impl<T: SharedFields> From<SharedState<T>> for SharedMemory {
+    fn from(state: SharedState<T>) -> Self {
+        SharedMemory {
+            memory: state.memory,
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::thread;
+
+    use super::*;
+
+    #[derive(Debug, PartialEq)]
+    struct Position {
+        x: f64,
+        y: f64,
+    }
+
+    impl SharedFields for Position {
+        const COUNT: usize = 2;
+
+        fn store_fields(&self, mut store: impl FnMut(usize, f64)) {
+            store(0, self.x);
+            store(1, self.y);
+        }
+
+        fn load_fields(mut load: impl FnMut(usize) -> f64) -> Self {
+            Self {
+                x: load(0),
+                y: load(1),
+            }
+        }
+    }
+
+    #[test]
+    fn test_shared_state() {
+        let state = SharedState::<Position>::new();
+        let memory = SharedMemory::from(state.clone());
+
+        assert_eq!(memory.size(), 3 * 8);
+        assert_eq!(state.read(), Position { x: 0.0, y: 0.0 });
+
+        state.write(&Position { x: 1.0, y: 2.0 });
+
+        let seq = unsafe { *(memory.data() as *const u64) };
+        let fields = unsafe { std::slice::from_raw_parts((memory.data() as *const f64).add(1), 2) };
+        assert_eq!(seq, 2);
+        assert_eq!(fields, [1.0, 2.0]);
+        assert_eq!(state.read(), Position { x: 1.0, y: 2.0 });
+    }
+
+    #[test]
+    fn test_shared_state_concurrent_writes() {
+        let state = SharedState::<Position>::new();
+
+        let writers = (0..4)
+            .map(|_| {
+                let state = state.clone();
+                thread::spawn(move || {
+                    for i in 0..1000 {
+                        state.write(&Position {
+                            x: i as f64,
+                            y: -(i as f64),
+                        });
+                    }
+                })
+            })
+            .collect::<Vec<_>>();
+
+        for _ in 0..1000 {
+            let position = state.read();
+            assert_eq!(position.x, -position.y);
+        }
+
+        for writer in writers {
+            writer.join().unwrap();
+        }
+        assert_eq!(
+            state.read(),
+            Position {
+                x: 999.0,
+                y: -999.0
+            }
+        );
+    }
+}
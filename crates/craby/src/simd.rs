@@ -0,0 +1,350 @@
+//! Bulk conversion kernels for numeric buffers.
+//!
+//! Typed arrays reach Rust as raw memory (eg. `&mut [f64]` for a `Float64Array`), converting them to a narrower
+//! element type is a loop over every element. The kernels convert a whole slice at once with NEON (`aarch64`)
+//! or SSE2 (`x86_64`), both baseline on their targets so no runtime detection is needed, and fall back to a
+//! scalar loop elsewhere. The results are the same as the `as` casts on every target.
+//!
+//! ```rust,ignore
+//! fn downsample(&mut self, samples: &mut [f64]) -> Float32Array {
+//!     craby::simd::clamp(samples, -1.0, 1.0);
+//!     craby::simd::to_f32(samples)
+//! }
+//! ```
+
+/// Converts `src` into `dst` like `x as f32` (rounded to the nearest value).
+///
+/// Panics if the slices have different lengths.
+pub fn f64_to_f32(src: &[f64], dst: &mut [f32]) {
+    assert_eq!(src.len(), dst.len(), "slices have different lengths");
+    let head = arch::f64_to_f32(src, dst);
+    for (s, d) in src[head..].iter().zip(&mut dst[head..]) {
+        *d = *s as f32;
+    }
+}
+
+/// Converts `src` into `dst` like `x as f64` (lossless).
+///
+/// Panics if the slices have different lengths.
+pub fn f32_to_f64(src: &[f32], dst: &mut [f64]) {
+    assert_eq!(src.len(), dst.len(), "slices have different lengths");
+    let head = arch::f32_to_f64(src, dst);
+    for (s, d) in src[head..].iter().zip(&mut dst[head..]) {
+        *d = *s as f64;
+    }
+}
+
+/// Converts `src` into `dst` like `x as i32`: truncated toward zero, saturated to the `i32` range and `NaN` to `0`.
+///
+/// Panics if the slices have different lengths.
+pub fn f64_to_i32(src: &[f64], dst: &mut [i32]) {
+    assert_eq!(src.len(), dst.len(), "slices have different lengths");
+    let head = arch::f64_to_i32(src, dst);
+    for (s, d) in src[head..].iter().zip(&mut dst[head..]) {
+        *d = *s as i32;
+    }
+}
+
+/// Converts `src` into `dst` like `x as i16`: truncated toward zero, saturated to the `i16` range and `NaN` to `0`
+/// (eg. samples scaled to `[-32768.0, 32767.0]` into 16-bit PCM).
+///
+/// Panics if the slices have different lengths.
+pub fn f64_to_i16(src: &[f64], dst: &mut [i16]) {
+    assert_eq!(src.len(), dst.len(), "slices have different lengths");
+    let head = arch::f64_to_i16(src, dst);
+    for (s, d) in src[head..].iter().zip(&mut dst[head..]) {
+        *d = *s as i16;
+    }
+}
+
+/// Returns the elements of `src` converted to `f32`.
+pub fn to_f32(src: &[f64]) -> Vec<f32> {
+    let mut dst = vec![0.0; src.len()];
+    f64_to_f32(src, &mut dst);
+    dst
+}
+
+/// Returns the elements of `src` converted to `f64`.
+pub fn to_f64(src: &[f32]) -> Vec<f64> {
+    let mut dst = vec![0.0; src.len()];
+    f32_to_f64(src, &mut dst);
+    dst
+}
+
+/// Returns the elements of `src` converted to `i32` (see [`f64_to_i32`]).
+pub fn to_i32(src: &[f64]) -> Vec<i32> {
+    let mut dst = vec![0; src.len()];
+    f64_to_i32(src, &mut dst);
+    dst
+}
+
+/// Returns the elements of `src` converted to `i16` (see [`f64_to_i16`]).
+pub fn to_i16(src: &[f64]) -> Vec<i16> {
+    let mut dst = vec![0; src.len()];
+    f64_to_i16(src, &mut dst);
+    dst
+}
+
+/// Clamps every element in place like `f64::clamp` (`NaN` stays `NaN`).
+///
+/// The loop has no branches, the compiler vectorizes it on every target.
+///
+/// Panics if `min > max` or either bound is `NaN`.
+pub fn clamp(values: &mut [f64], min: f64, max: f64) {
+    assert!(min <= max, "min must be less than or equal to max");
+    for v in values {
+        *v = v.clamp(min, max);
+    }
+}
+
+/// Interleaves two channels into `dst` (`[l0, r0, l1, r1, ..]`).
+///
+/// Panics if the channels have different lengths or `dst` is not twice as long.
+pub fn interleave<T: Copy>(left: &[T], right: &[T], dst: &mut [T]) {
+    assert_eq!(left.len(), right.len(), "channels have different lengths");
+    assert_eq!(dst.len(), left.len() * 2, "dst must hold both channels");
+    for ((frame, l), r) in dst.chunks_exact_mut(2).zip(left).zip(right) {
+        frame[0] = *l;
+        frame[1] = *r;
+    }
+}
+
+/// Splits interleaved frames (`[l0, r0, l1, r1, ..]`) into two channels.
+///
+/// Panics if the channels have different lengths or `src` is not twice as long.
+pub fn deinterleave<T: Copy>(src: &[T], left: &mut [T], right: &mut [T]) {
+    assert_eq!(left.len(), right.len(), "channels have different lengths");
+    assert_eq!(src.len(), left.len() * 2, "src must hold both channels");
+    for ((frame, l), r) in src.chunks_exact(2).zip(left).zip(right) {
+        *l = frame[0];
+        *r = frame[1];
+    }
+}
+
+/// The kernels convert 4 elements per step and return the number of converted elements,
+/// the caller converts the rest.
+#[cfg(target_arch = "aarch64")]
+mod arch {
+    use std::arch::aarch64::*;
+
+    pub fn f64_to_f32(src: &[f64], dst: &mut [f32]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                let lo = vcvt_f32_f64(vld1q_f64(s.as_ptr()));
+                let hi = vcvt_f32_f64(vld1q_f64(s.as_ptr().add(2)));
+                vst1q_f32(d.as_mut_ptr(), vcombine_f32(lo, hi));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    pub fn f32_to_f64(src: &[f32], dst: &mut [f64]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                let v = vld1q_f32(s.as_ptr());
+                vst1q_f64(d.as_mut_ptr(), vcvt_f64_f32(vget_low_f32(v)));
+                vst1q_f64(d.as_mut_ptr().add(2), vcvt_high_f64_f32(v));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    pub fn f64_to_i32(src: &[f64], dst: &mut [i32]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                // `fcvtzs` truncates, saturates and maps `NaN` to `0`, `sqxtn` saturates to 32 bits
+                let lo = vqmovn_s64(vcvtq_s64_f64(vld1q_f64(s.as_ptr())));
+                let hi = vqmovn_s64(vcvtq_s64_f64(vld1q_f64(s.as_ptr().add(2))));
+                vst1q_s32(d.as_mut_ptr(), vcombine_s32(lo, hi));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    pub fn f64_to_i16(src: &[f64], dst: &mut [i16]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                // Saturated to 32 bits as in `f64_to_i32`, then to 16 bits by another `sqxtn`
+                let lo = vqmovn_s64(vcvtq_s64_f64(vld1q_f64(s.as_ptr())));
+                let hi = vqmovn_s64(vcvtq_s64_f64(vld1q_f64(s.as_ptr().add(2))));
+                vst1_s16(d.as_mut_ptr(), vqmovn_s32(vcombine_s32(lo, hi)));
+            }
+        }
+        src.len() / 4 * 4
+    }
+}
+
+#[cfg(target_arch = "x86_64")]
+mod arch {
+    use std::arch::x86_64::*;
+
+    pub fn f64_to_f32(src: &[f64], dst: &mut [f32]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                let lo = _mm_cvtpd_ps(_mm_loadu_pd(s.as_ptr()));
+                let hi = _mm_cvtpd_ps(_mm_loadu_pd(s.as_ptr().add(2)));
+                _mm_storeu_ps(d.as_mut_ptr(), _mm_movelh_ps(lo, hi));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    pub fn f32_to_f64(src: &[f32], dst: &mut [f64]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                let v = _mm_loadu_ps(s.as_ptr());
+                _mm_storeu_pd(d.as_mut_ptr(), _mm_cvtps_pd(v));
+                _mm_storeu_pd(d.as_mut_ptr().add(2), _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    pub fn f64_to_i32(src: &[f64], dst: &mut [i32]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                let lo = cvtt_saturating(_mm_loadu_pd(s.as_ptr()));
+                let hi = cvtt_saturating(_mm_loadu_pd(s.as_ptr().add(2)));
+                _mm_storeu_si128(d.as_mut_ptr() as *mut __m128i, _mm_unpacklo_epi64(lo, hi));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    pub fn f64_to_i16(src: &[f64], dst: &mut [i16]) -> usize {
+        for (s, d) in src.chunks_exact(4).zip(dst.chunks_exact_mut(4)) {
+            unsafe {
+                let lo = cvtt_saturating(_mm_loadu_pd(s.as_ptr()));
+                let hi = cvtt_saturating(_mm_loadu_pd(s.as_ptr().add(2)));
+                // `packssdw` saturates the 32-bit values to 16 bits
+                let v = _mm_unpacklo_epi64(lo, hi);
+                _mm_storel_epi64(d.as_mut_ptr() as *mut __m128i, _mm_packs_epi32(v, v));
+            }
+        }
+        src.len() / 4 * 4
+    }
+
+    /// `cvttpd2dq` returns `i32::MIN` for `NaN` and out of range values,
+    /// `NaN` is zeroed and the values are clamped first to match `as i32`.
+    #[inline(always)]
+    unsafe fn cvtt_saturating(x: __m128d) -> __m128i {
+        let x = _mm_and_pd(x, _mm_cmpord_pd(x, x));
+        let x = _mm_min_pd(
+            _mm_max_pd(x, _mm_set1_pd(i32::MIN as f64)),
+            _mm_set1_pd(i32::MAX as f64),
+        );
+        _mm_cvttpd_epi32(x)
+    }
+}
+
+#[cfg(not(any(target_arch = "aarch64", target_arch = "x86_64")))]
+mod arch {
+    pub fn f64_to_f32(_: &[f64], _: &mut [f32]) -> usize {
+        0
+    }
+
+    pub fn f32_to_f64(_: &[f32], _: &mut [f64]) -> usize {
+        0
+    }
+
+    pub fn f64_to_i32(_: &[f64], _: &mut [i32]) -> usize {
+        0
+    }
+
+    pub fn f64_to_i16(_: &[f64], _: &mut [i16]) -> usize {
+        0
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    // The first 8 samples go through the kernels, the rest through the scalar tail
+    const SAMPLES: [f64; 11] = [
+        f64::NAN,
+        f64::INFINITY,
+        1e300,
+        -1e300,
+        3_000_000_000.0,
+        -3_000_000_000.0,
+        1.5,
+        -2.5,
+        0.1,
+        -0.0,
+        f64::NAN,
+    ];
+
+    #[test]
+    fn test_f64_to_f32() {
+        let dst = to_f32(&SAMPLES);
+
+        for (s, d) in SAMPLES.iter().zip(&dst) {
+            assert_eq!((*s as f32).to_bits(), d.to_bits(), "{s}");
+        }
+    }
+
+    #[test]
+    fn test_f32_to_f64() {
+        let src = to_f32(&SAMPLES);
+        let dst = to_f64(&src);
+
+        for (s, d) in src.iter().zip(&dst) {
+            assert_eq!((*s as f64).to_bits(), d.to_bits(), "{s}");
+        }
+    }
+
+    #[test]
+    fn test_f64_to_i32() {
+        let dst = to_i32(&SAMPLES);
+
+        for (s, d) in SAMPLES.iter().zip(&dst) {
+            assert_eq!(*s as i32, *d, "{s}");
+        }
+    }
+
+    #[test]
+    fn test_f64_to_i16() {
+        let dst = to_i16(&SAMPLES);
+
+        for (s, d) in SAMPLES.iter().zip(&dst) {
+            assert_eq!(*s as i16, *d, "{s}");
+        }
+
+        // In and just out of the `i16` range, where the 32-bit kernels don't saturate
+        let src = [32767.9, -32768.9, 32768.0, -32769.0, 40000.5, -40000.5, 123.7, -123.7, 65536.0];
+        let dst = to_i16(&src);
+
+        for (s, d) in src.iter().zip(&dst) {
+            assert_eq!(*s as i16, *d, "{s}");
+        }
+    }
+
+    #[test]
+    fn test_clamp() {
+        let mut values = SAMPLES;
+        clamp(&mut values, -1.0, 1.0);
+
+        assert!(values[0].is_nan());
+        assert_eq!(
+            &values[1..10],
+            &[1.0, 1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 0.1, -0.0]
+        );
+    }
+
+    #[test]
+    fn test_interleave() {
+        let left = [1, 2, 3];
+        let right = [4, 5, 6];
+        let mut frames = [0; 6];
+        interleave(&left, &right, &mut frames);
+
+        assert_eq!(frames, [1, 4, 2, 5, 3, 6]);
+
+        let mut l = [0; 3];
+        let mut r = [0; 3];
+        deinterleave(&frames, &mut l, &mut r);
+
+        assert_eq!((l, r), (left, right));
+    }
+}
@@ -0,0 +1,623 @@
+//! Bounded byte streams for transferring large payloads between Rust and JavaScript in chunks.
+//!
+//! A method returning `ByteStream` hands one end of a stream to JavaScript, which reads it with
+//! `read(size)` (or writes it with `write(chunk)`), while the Rust side keeps the other end.
+//! Chunks flow through a queue of at most `capacity` chunks, so neither side holds the whole payload:
+//!
+//! - [`readable`]: Rust writes with [`StreamWriter`], JavaScript reads.
+//!   [`StreamWriter`] blocks while the queue is full.
+//! - [`writable`]: JavaScript writes, Rust reads with [`StreamReader`].
+//!   `write()` resolves once the chunk is queued, so JavaScript waits while the queue is full.
+//!
+//! Chunks are allocated from the buffer pool ([`crate::pool`]). Chunks read by JavaScript become
+//! `ArrayBuffer`s without a copy and are recycled when garbage-collected.
+//!
+//! ```rust,ignore
+//! fn read_file(&mut self) -> ByteStream {
+//!     let path = PathBuf::from(&self.ctx.data_path).join("data.bin");
+//!     let (mut writer, stream) = craby::stream::readable(4);
+//!
+//!     std::thread::spawn(move || {
+//!         let res = File::open(path).and_then(|mut file| io::copy(&mut file, &mut writer));
+//!         if let Err(e) = res {
+//!             writer.abort(e);
+//!         }
+//!     });
+//!
+//!     stream
+//! }
+//! ```
+use std::{
+    collections::VecDeque,
+    fmt::Display,
+    io,
+    sync::{Arc, Condvar, Mutex, MutexGuard},
+};
+
+use crate::pool;
+
+/// Default size of the chunks filled by [`StreamWriter`] (64 KiB).
+pub const DEFAULT_CHUNK_SIZE: usize = 64 * 1024;
+
+const CLOSED: &str = "Stream is closed";
+
+/// Called once when the pending `read()`/`write()` of JavaScript can make progress.
+pub type Waker = Box<dyn FnOnce() + Send>;
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Direction {
+    /// JavaScript reads, Rust writes
+    Readable,
+    /// JavaScript writes, Rust reads
+    Writable,
+}
+
+struct State {
+    chunks: VecDeque<Vec<u8>>,
+    /// Bytes of the front chunk already taken by JavaScript reads
+    head: usize,
+    /// Maximum number of queued chunks
+    capacity: usize,
+    /// Chunk written by JavaScript while the queue was full
+    pending_write: Option<Vec<u8>>,
+    /// Waker of the pending JavaScript operation
+    waker: Option<Waker>,
+    /// The Rust end was dropped (end of stream for JavaScript reads)
+    rust_closed: bool,
+    /// The JavaScript end was closed or garbage-collected
+    js_closed: bool,
+    /// Error set by [`StreamWriter::abort`], rejects the next JavaScript read
+    error: Option<String>,
+}
+
+struct Shared {
+    state: Mutex<State>,
+    /// Notifies the Rust end when the queue changes
+    changed: Condvar,
+}
+
+impl Shared {
+    fn new(capacity: usize) -> Arc<Self> {
+        Arc::new(Shared {
+            state: Mutex::new(State {
+                chunks: VecDeque::new(),
+                head: 0,
+                capacity: capacity.max(1),
+                pending_write: None,
+                waker: None,
+                rust_closed: false,
+                js_closed: false,
+                error: None,
+            }),
+            changed: Condvar::new(),
+        })
+    }
+
+    fn lock(&self) -> MutexGuard<'_, State> {
+        // The state holds no invariants that a panic could break
+        self.state.lock().unwrap_or_else(|e| e.into_inner())
+    }
+
+    fn wait<'a>(&self, state: MutexGuard<'a, State>) -> MutexGuard<'a, State> {
+        self.changed.wait(state).unwrap_or_else(|e| e.into_inner())
+    }
+
+    /// Closes the Rust end and wakes the pending JavaScript operation.
+    fn close_rust(&self, error: Option<String>) {
+        let waker = {
+            let mut state = self.lock();
+            state.rust_closed = true;
+            if state.error.is_none() {
+                state.error = error;
+            }
+            state.waker.take()
+        };
+
+        if let Some(waker) = waker {
+            waker();
+        }
+    }
+}
+
+/// Creates a stream that Rust writes and JavaScript reads, queueing up to `capacity` chunks.
+pub fn readable(capacity: usize) -> (StreamWriter, ByteStream) {
+    let shared = Shared::new(capacity);
+    let writer = StreamWriter {
+        shared: shared.clone(),
+        chunk: Vec::new(),
+        chunk_size: DEFAULT_CHUNK_SIZE,
+    };
+    let stream = ByteStream {
+        shared,
+        direction: Direction::Readable,
+    };
+    (writer, stream)
+}
+
+/// Creates a stream that JavaScript writes and Rust reads, queueing up to `capacity` chunks.
+pub fn writable(capacity: usize) -> (StreamReader, ByteStream) {
+    let shared = Shared::new(capacity);
+    let reader = StreamReader {
+        shared: shared.clone(),
+        chunk: Vec::new(),
+        pos: 0,
+    };
+    let stream = ByteStream {
+        shared,
+        direction: Direction::Writable,
+    };
+    (reader, stream)
+}
+
+/// The JavaScript end of a stream, returned from methods declared as `ByteStream`.
+///
+/// Dropping it closes the stream.
+pub struct ByteStream {
+    shared: Arc<Shared>,
+    direction: Direction,
+}
+
+impl ByteStream {
+    /// Returns `true` if [`ByteStream::take`] can complete now.
+    /// Otherwise `waker` is called once a chunk is queued or the stream is closed.
+    ///
+    /// Called by the generated bridging code for `read()`.
+    pub fn poll_read(&self, waker: Waker) -> Result<bool, anyhow::Error> {
+        if self.direction != Direction::Readable {
+            anyhow::bail!("Stream is not readable");
+        }
+
+        let mut state = self.shared.lock();
+        if !state.chunks.is_empty() || state.rust_closed || state.js_closed {
+            return Ok(true);
+        }
+        if state.waker.is_some() {
+            anyhow::bail!("Another read is pending");
+        }
+        state.waker = Some(waker);
+
+        Ok(false)
+    }
+
+    /// Takes up to `size` bytes from the queue without blocking.
+    /// Returns an empty chunk at the end of the stream.
+    ///
+    /// Called by the generated bridging code for `read()`.
+    pub fn take(&self, size: usize) -> Result<Vec<u8>, anyhow::Error> {
+        let size = size.max(1);
+        let mut state = self.shared.lock();
+        let head = state.head;
+        let Some(front) = state.chunks.front() else {
+            return match state.error.take() {
+                Some(error) => Err(anyhow::anyhow!(error)),
+                None => Ok(Vec::new()),
+            };
+        };
+
+        // Smaller reads copy from the front chunk and move `head` forward, the chunk stays queued
+        if front.len() - head > size {
+            let mut part = pool::take(size);
+            part.extend_from_slice(&front[head..head + size]);
+            state.head += size;
+            return Ok(part);
+        }
+
+        let mut chunk = state.chunks.pop_front().unwrap();
+        state.head = 0;
+        drop(state);
+        if head > 0 {
+            chunk.drain(..head);
+        }
+        self.shared.changed.notify_all();
+
+        Ok(chunk)
+    }
+
+    /// Queues a copy of `chunk`. Returns `true` if it is queued now.
+    /// Otherwise the chunk is queued once the queue has room and `waker` is called.
+    ///
+    /// Called by the generated bridging code for `write()`.
+    pub fn write(&self, chunk: &[u8], waker: Waker) -> Result<bool, anyhow::Error> {
+        if self.direction != Direction::Writable {
+            anyhow::bail!("Stream is not writable");
+        }
+
+        let mut buf = pool::take(chunk.len());
+        buf.extend_from_slice(chunk);
+
+        let mut state = self.shared.lock();
+        if state.rust_closed || state.js_closed {
+            anyhow::bail!(CLOSED);
+        }
+        if state.pending_write.is_some() {
+            anyhow::bail!("Another write is pending");
+        }
+        if state.chunks.len() < state.capacity {
+            state.chunks.push_back(buf);
+            drop(state);
+            self.shared.changed.notify_all();
+            return Ok(true);
+        }
+        state.pending_write = Some(buf);
+        state.waker = Some(waker);
+
+        Ok(false)
+    }
+
+    /// Checks the pending write after its waker was called.
+    /// Fails if the stream was closed before the chunk could be queued.
+    ///
+    /// Called by the generated bridging code for `write()`.
+    pub fn finish_write(&self) -> Result<(), anyhow::Error> {
+        let pending = self.shared.lock().pending_write.take();
+        match pending {
+            Some(buf) => {
+                pool::recycle(buf);
+                Err(anyhow::anyhow!(CLOSED))
+            }
+            None => Ok(()),
+        }
+    }
+
+    /// Closes the stream. Queued chunks are dropped when JavaScript stops reading,
+    /// and [`StreamReader`] reaches the end of the stream when JavaScript stops writing.
+    pub fn close(&self) {
+        let (waker, dropped) = {
+            let mut state = self.shared.lock();
+            if state.js_closed {
+                return;
+            }
+            state.js_closed = true;
+            let dropped = match self.direction {
+                Direction::Readable => {
+                    state.head = 0;
+                    std::mem::take(&mut state.chunks)
+                }
+                Direction::Writable => VecDeque::new(),
+            };
+            (state.waker.take(), dropped)
+        };
+        self.shared.changed.notify_all();
+
+        dropped.into_iter().for_each(pool::recycle);
+        if let Some(waker) = waker {
+            waker();
+        }
+    }
+}
+
+impl Drop for ByteStream {
+    fn drop(&mut self) {
+        self.close();
+    }
+}
+
+/// The Rust end of a [`readable`] stream.
+///
+/// Writes are buffered into chunks of [`DEFAULT_CHUNK_SIZE`] bytes (see [`StreamWriter::chunk_size`]).
+/// Dropping the writer flushes the last chunk and ends the stream.
+pub struct StreamWriter {
+    shared: Arc<Shared>,
+    /// Chunk being filled
+    chunk: Vec<u8>,
+    chunk_size: usize,
+}
+
+impl StreamWriter {
+    /// Sets the size of the chunks filled by `write`.
+    pub fn chunk_size(mut self, chunk_size: usize) -> Self {
+        self.chunk_size = chunk_size.max(1);
+        self
+    }
+
+    /// Queues `chunk` as is, blocking while the queue is full.
+    ///
+    /// Fails with [`io::ErrorKind::BrokenPipe`] once JavaScript closed the stream.
+    pub fn write_chunk(&mut self, chunk: Vec<u8>) -> io::Result<()> {
+        self.flush_chunk()?;
+        self.push(chunk)
+    }
+
+    /// Ends the stream with an error. The next `read()` of JavaScript is rejected with `error`.
+    pub fn abort(mut self, error: impl Display) {
+        // Chunks that are already queued are still read first
+        let _ = self.flush_chunk();
+        self.shared.close_rust(Some(error.to_string()));
+    }
+
+    fn push(&mut self, chunk: Vec<u8>) -> io::Result<()> {
+        if chunk.is_empty() {
+            return Ok(());
+        }
+
+        let waker = {
+            let mut state = self.shared.lock();
+            while state.chunks.len() >= state.capacity && !state.js_closed {
+                state = self.shared.wait(state);
+            }
+            if state.js_closed {
+                return Err(io::Error::new(io::ErrorKind::BrokenPipe, CLOSED));
+            }
+            state.chunks.push_back(chunk);
+            state.waker.take()
+        };
+
+        if let Some(waker) = waker {
+            waker();
+        }
+
+        Ok(())
+    }
+
+    fn flush_chunk(&mut self) -> io::Result<()> {
+        if self.chunk.is_empty() {
+            return Ok(());
+        }
+        let chunk = std::mem::take(&mut self.chunk);
+        self.push(chunk)
+    }
+}
+
+impl io::Write for StreamWriter {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        if self.chunk.capacity() == 0 {
+            self.chunk = pool::take(self.chunk_size);
+        }
+
+        let len = buf.len().min(self.chunk_size - self.chunk.len());
+        self.chunk.extend_from_slice(&buf[..len]);
+        if self.chunk.len() >= self.chunk_size {
+            self.flush_chunk()?;
+        }
+
+        Ok(len)
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        self.flush_chunk()
+    }
+}
+
+impl Drop for StreamWriter {
+    fn drop(&mut self) {
+        let _ = self.flush_chunk();
+        self.shared.close_rust(None);
+    }
+}
+
+/// The Rust end of a [`writable`] stream.
+///
+/// Reads block until JavaScript writes a chunk, and reach the end of the stream once it closes
+/// the stream. Dropping the reader closes the stream for JavaScript.
+pub struct StreamReader {
+    shared: Arc<Shared>,
+    /// Chunk being read
+    chunk: Vec<u8>,
+    /// Read position in `chunk`
+    pos: usize,
+}
+
+impl StreamReader {
+    /// Takes the next chunk written by JavaScript, blocking while the queue is empty.
+    /// Returns `None` at the end of the stream.
+    ///
+    /// Give the chunk back with [`crate::pool::recycle`] when done to reuse its buffer.
+    pub fn read_chunk(&mut self) -> Option<Vec<u8>> {
+        if self.pos < self.chunk.len() {
+            let rest = self.chunk.split_off(self.pos);
+            pool::recycle(std::mem::take(&mut self.chunk));
+            self.pos = 0;
+            return Some(rest);
+        }
+
+        let (chunk, waker) = {
+            let mut state = self.shared.lock();
+            while state.chunks.is_empty() && !state.js_closed {
+                state = self.shared.wait(state);
+            }
+            let chunk = state.chunks.pop_front()?;
+            let waker = match state.pending_write.take() {
+                Some(pending) => {
+                    state.chunks.push_back(pending);
+                    state.waker.take()
+                }
+                None => None,
+            };
+            (chunk, waker)
+        };
+
+        if let Some(waker) = waker {
+            waker();
+        }
+
+        Some(chunk)
+    }
+}
+
+impl io::Read for StreamReader {
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        if self.pos >= self.chunk.len() {
+            pool::recycle(std::mem::take(&mut self.chunk));
+            self.pos = 0;
+            match self.read_chunk() {
+                Some(chunk) => self.chunk = chunk,
+                None => return Ok(0),
+            }
+        }
+
+        let len = buf.len().min(self.chunk.len() - self.pos);
+        buf[..len].copy_from_slice(&self.chunk[self.pos..self.pos + len]);
+        self.pos += len;
+
+        Ok(len)
+    }
+}
+
+impl Drop for StreamReader {
+    fn drop(&mut self) {
+        let dropped = std::mem::take(&mut self.shared.lock().chunks);
+        dropped.into_iter().for_each(pool::recycle);
+        self.shared.close_rust(None);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::{
+        io::{Read, Write},
+        sync::atomic::{AtomicUsize, Ordering},
+        thread,
+    };
+
+    use super::*;
+
+    fn counter() -> (Arc<AtomicUsize>, impl Fn() -> Waker) {
+        let count = Arc::new(AtomicUsize::new(0));
+        let waker = {
+            let count = count.clone();
+            move || -> Waker {
+                let count = count.clone();
+                Box::new(move || {
+                    count.fetch_add(1, Ordering::SeqCst);
+                })
+            }
+        };
+        (count, waker)
+    }
+
+    #[test]
+    fn test_readable() {
+        let (writer, stream) = readable(2);
+        let (woken, waker) = counter();
+
+        assert!(!stream.poll_read(waker()).unwrap());
+
+        let mut writer = writer.chunk_size(4);
+        writer.write_all(b"hello").unwrap();
+        assert_eq!(woken.load(Ordering::SeqCst), 1);
+
+        assert!(stream.poll_read(waker()).unwrap());
+        assert_eq!(stream.take(3).unwrap(), b"hel");
+        assert_eq!(stream.take(8).unwrap(), b"l");
+
+        drop(writer);
+        assert_eq!(stream.take(8).unwrap(), b"o");
+        assert!(stream.poll_read(waker()).unwrap());
+        assert!(stream.take(8).unwrap().is_empty());
+    }
+
+    #[test]
+    fn test_readable_small_reads() {
+        let (mut writer, stream) = readable(1);
+        let data = (0..=255).cycle().take(10_000).collect::<Vec<u8>>();
+        writer.write_chunk(data.clone()).unwrap();
+        drop(writer);
+
+        // Reads smaller than the chunk take it piece by piece
+        let mut read = vec![];
+        loop {
+            let chunk = stream.take(7).unwrap();
+            if chunk.is_empty() {
+                break;
+            }
+            assert!(chunk.len() <= 7);
+            read.extend(chunk);
+        }
+        assert_eq!(read, data);
+    }
+
+    #[test]
+    fn test_readable_backpressure() {
+        let (writer, stream) = readable(1);
+        let producer = thread::spawn(move || {
+            let mut writer = writer.chunk_size(2);
+            writer.write_all(b"abcdef").unwrap();
+        });
+
+        let (tx, rx) = std::sync::mpsc::channel();
+        let mut data = vec![];
+        loop {
+            let tx = tx.clone();
+            if !stream
+                .poll_read(Box::new(move || tx.send(()).unwrap()))
+                .unwrap()
+            {
+                rx.recv().unwrap();
+            }
+            let chunk = stream.take(16).unwrap();
+            if chunk.is_empty() {
+                break;
+            }
+            data.extend(chunk);
+        }
+
+        producer.join().unwrap();
+        assert_eq!(data, b"abcdef");
+    }
+
+    #[test]
+    fn test_readable_abort() {
+        let (mut writer, stream) = readable(2);
+        writer.write_all(b"ab").unwrap();
+        writer.abort("Failed to read");
+
+        assert_eq!(stream.take(8).unwrap(), b"ab");
+        assert_eq!(stream.take(8).unwrap_err().to_string(), "Failed to read");
+    }
+
+    #[test]
+    fn test_readable_closed_by_js() {
+        let (mut writer, stream) = readable(1);
+        writer.write_chunk(b"ab".to_vec()).unwrap();
+        drop(stream);
+
+        let err = writer.write_chunk(b"cd".to_vec()).unwrap_err();
+        assert_eq!(err.kind(), io::ErrorKind::BrokenPipe);
+    }
+
+    #[test]
+    fn test_writable() {
+        let (mut reader, stream) = writable(1);
+        let (woken, waker) = counter();
+
+        assert!(stream.write(b"ab", waker()).unwrap());
+        // Queue is full, the chunk is queued once the reader takes the previous one
+        assert!(!stream.write(b"cd", waker()).unwrap());
+        assert!(stream.write(b"ef", waker()).is_err());
+
+        let mut buf = [0u8; 1];
+        reader.read_exact(&mut buf).unwrap();
+        assert_eq!(&buf, b"a");
+        assert_eq!(woken.load(Ordering::SeqCst), 1);
+        assert!(stream.finish_write().is_ok());
+
+        stream.close();
+        let mut rest = vec![];
+        reader.read_to_end(&mut rest).unwrap();
+        assert_eq!(rest, b"bcd");
+    }
+
+    #[test]
+    fn test_writable_closed_by_rust() {
+        let (reader, stream) = writable(1);
+        let (woken, waker) = counter();
+
+        assert!(stream.write(b"ab", waker()).unwrap());
+        assert!(!stream.write(b"cd", waker()).unwrap());
+        drop(reader);
+
+        assert_eq!(woken.load(Ordering::SeqCst), 1);
+        assert!(stream.finish_write().is_err());
+        assert!(stream.write(b"ef", waker()).is_err());
+    }
+
+    #[test]
+    fn test_direction() {
+        let (_writer, readable) = readable(1);
+        let (_reader, writable) = writable(1);
+        let (_, waker) = counter();
+
+        assert!(readable.write(b"ab", waker()).is_err());
+        assert!(writable.poll_read(waker()).is_err());
+    }
+}
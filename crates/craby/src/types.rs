@@ -2,6 +2,11 @@ pub type Boolean = bool;
 pub type Number = f64;
 pub type String = std::string::String;
 pub type ArrayBuffer = std::vec::Vec<u8>;
+pub type Float64Array = std::vec::Vec<f64>;
+pub type Float32Array = std::vec::Vec<f32>;
+pub type Int32Array = std::vec::Vec<i32>;
+pub type Int16Array = std::vec::Vec<i16>;
+pub type Uint8Array = std::vec::Vec<u8>;
 pub type Array<T> = std::vec::Vec<T>;
 pub type Promise<T> = std::result::Result<T, anyhow::Error>;
 pub type Void = ();
@@ -1,40 +1,109 @@
-use std::{path::Path, process::Command};
+use std::{collections::HashMap, env, path::Path, process::Command};
 
-use craby_common::constants::crate_manifest_path;
+use craby_common::{config::BuildConfig, constants::crate_manifest_path};
 use log::{debug, error};
 
 use crate::constants::toolchain::Target;
 
-pub fn build_target(project_root: &Path, target: &Target) -> Result<(), anyhow::Error> {
+/// Builds all targets with a single Cargo invocation (`--target` for each target)
+///
+/// Cargo builds the targets in parallel in the shared target directory,
+/// so the host artifacts (build scripts, proc-macros) are built once and unchanged crates are not rebuilt
+///
+/// The optimizations of `[build]` are passed per target (`CARGO_TARGET_<TRIPLE>_RUSTFLAGS`, `CXXFLAGS_<TRIPLE>`),
+/// so the build scripts and proc-macros built for the host are not affected
+pub fn build_targets(
+    project_root: &Path,
+    targets: &[Target],
+    build: &BuildConfig,
+) -> Result<(), anyhow::Error> {
     let manifest_path = crate_manifest_path(project_root)
         .to_string_lossy()
         .to_string();
     debug!("Manifest path: {}", manifest_path);
 
-    let target_label = format!("({})", target);
-    debug!("Building for target {}", target_label);
+    let target_labels = targets.iter().map(|t| t.to_str()).collect::<Vec<_>>();
+    debug!("Building for targets ({})", target_labels.join(", "));
 
-    let args = [
+    let mut args = vec![
         "build",
         "--manifest-path",
         manifest_path.as_str(),
-        "--target",
-        target.to_str(),
         "--release",
     ];
+    // The NDK environments are suffixed with the target name, they never conflict
+    let mut envs = HashMap::new();
+    for target in targets {
+        args.extend(["--target", target.to_str()]);
+        if let Target::Android(abi) = target {
+            envs.extend(
+                abi.to_env()?
+                    .into_iter()
+                    .map(|(k, v)| (k, v.to_string_lossy().to_string())),
+            );
+        }
+        envs.extend(optimization_env(project_root, target, build)?);
+    }
 
-    let res = match &target {
-        Target::Android(abi) => Command::new("cargo")
-            .args(args)
-            .envs(abi.to_env()?)
-            .output(),
-        Target::Ios(_) => Command::new("cargo").args(args).output(),
-    }?;
+    let res = Command::new("cargo").args(args).envs(envs).output()?;
 
     if !res.status.success() {
         error!("{}", String::from_utf8_lossy(&res.stderr));
-        anyhow::bail!("Failed to build (Target: {})", target.to_str());
+        anyhow::bail!("Failed to build (Targets: {})", target_labels.join(", "));
     }
 
     Ok(())
 }
+
+/// Flags of the `[build]` optimizations for the target, appended to the ones already set in the environment
+///
+/// - `lto`: the Rust library is emitted as LLVM bitcode (`-Clinker-plugin-lto`) and the cxx bridge is compiled
+///   with `-flto=thin`, the generated `CMakeLists.txt` links them with the C++ module as a single LTO unit.
+///   Requires the NDK clang to be built on an LLVM at least as recent as `rustc` (see `rustc -vV`)
+/// - `profile_use`: the Rust library is optimized with the profile (`-Cprofile-use`)
+fn optimization_env(
+    project_root: &Path,
+    target: &Target,
+    build: &BuildConfig,
+) -> Result<HashMap<String, String>, anyhow::Error> {
+    let mut rustflags = vec![];
+    let mut cxxflags = vec![];
+
+    if build.lto {
+        if let Target::Android(_) = target {
+            rustflags.push("-Clinker-plugin-lto".to_string());
+            cxxflags.push("-flto=thin".to_string());
+        }
+    }
+
+    if let Some(profile) = &build.profile_use {
+        let profile = project_root.join(profile);
+        if !profile.try_exists()? {
+            anyhow::bail!("PGO profile not found: {}", profile.display());
+        }
+        rustflags.push(format!("-Cprofile-use={}", profile.display()));
+    }
+
+    let triple = target.to_str().replace('-', "_");
+    let mut envs = HashMap::new();
+    for (key, flags) in [
+        (
+            format!("CARGO_TARGET_{}_RUSTFLAGS", triple.to_uppercase()),
+            rustflags,
+        ),
+        (format!("CXXFLAGS_{}", triple), cxxflags),
+    ] {
+        if flags.is_empty() {
+            continue;
+        }
+
+        let value = match env::var(&key) {
+            Ok(curr) if !curr.is_empty() => format!("{} {}", curr, flags.join(" ")),
+            _ => flags.join(" "),
+        };
+        debug!("Build optimization: {}={}", key, value);
+        envs.insert(key, value);
+    }
+
+    Ok(envs)
+}
@@ -1,6 +1,24 @@
+/// Builds the cxx bridge (`src/ffi.rs`) of the module crate
+///
+/// The build script only reruns when the bridge or the headers in `include` change,
+/// editing the module implementation does not regenerate and recompile the bridge.
+/// The C++ compilation is cached with `sccache` when it is the `RUSTC_WRAPPER`.
+///
+/// Release builds hide the bridge symbols (`-fvisibility=hidden`), they are only called from the same library
+/// and the unused ones are removed by the final link (the sections are split by default).
+/// The `[build]` optimizations of `craby.toml` are passed by `craby build` (`CXXFLAGS_<TRIPLE>`).
 pub fn setup() {
-    cxx_build::bridge("src/ffi.rs")
-        .std("c++20")
-        .include("include")
-        .compile("cxxbridge")
+    println!("cargo:rerun-if-changed=src/ffi.rs");
+    println!("cargo:rerun-if-changed=include");
+
+    let mut build = cxx_build::bridge("src/ffi.rs");
+    build.std("c++20").include("include");
+
+    if std::env::var("PROFILE").as_deref() == Ok("release") {
+        build
+            .flag("-fvisibility=hidden")
+            .flag("-fvisibility-inlines-hidden");
+    }
+
+    build.compile("cxxbridge")
 }
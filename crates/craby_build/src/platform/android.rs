@@ -23,16 +23,19 @@ pub fn crate_libs(config: &CompleteConfig, build_targets: &[Target]) -> Result<(
             let artifacts = Artifacts::get_artifacts(config, target)?;
             let abi = abi.to_str();
 
-            artifacts.path_of(ArtifactType::Lib).iter().try_for_each(
-                |lib| -> Result<(), anyhow::Error> {
-                    info!(
-                        "Optimizing library... {}",
-                        format!("({})", artifacts.identifier).dimmed()
-                    );
-                    strip_lib(lib)?;
-                    Ok(())
-                },
-            )?;
+            // The symbols of the LLVM bitcode library (`[build] lto`) are needed by the final link
+            if !config.build.lto {
+                artifacts.path_of(ArtifactType::Lib).iter().try_for_each(
+                    |lib| -> Result<(), anyhow::Error> {
+                        info!(
+                            "Optimizing library... {}",
+                            format!("({})", artifacts.identifier).dimmed()
+                        );
+                        strip_lib(lib)?;
+                        Ok(())
+                    },
+                )?;
+            }
 
             // android/src/main/jni/src
             artifacts.copy_to(ArtifactType::Src, &jni_base_path.join("src"))?;
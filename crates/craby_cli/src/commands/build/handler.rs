@@ -4,7 +4,6 @@ use craby_build::platform::{android as android_build, ios as ios_build};
 use craby_codegen::codegen;
 use craby_common::{config::load_config, env::is_initialized};
 use log::{debug, info};
-use owo_colors::OwoColorize;
 
 use crate::{
     commands::build::validate_schema,
@@ -46,16 +45,11 @@ pub fn perform(opts: BuildOptions) -> anyhow::Result<()> {
     info!("Starting to build the Cargo project...");
     print_build_targets(&build_targets);
     with_spinner("Building Cargo projects...", |pb| {
-        for (i, target) in build_targets.iter().enumerate() {
-            pb.set_message(format!(
-                "[{}/{}] Building for target: {}",
-                i + 1,
-                build_targets.len(),
-                target.to_str().dimmed()
-            ));
-            craby_build::cargo::build::build_target(&opts.project_root, target)?;
-        }
-        Ok(())
+        pb.set_message(format!(
+            "Building for {} target(s) in parallel",
+            build_targets.len()
+        ));
+        craby_build::cargo::build::build_targets(&opts.project_root, &build_targets, &config.build)
     })?;
     info!("Cargo project build completed successfully");
 
@@ -19,7 +19,10 @@ use craby_common::{config::load_config, constants::craby_tmp_dir, env::is_initia
 use log::{debug, info};
 use owo_colors::OwoColorize;
 
-use crate::utils::{file::write_file, schema::print_schema};
+use crate::utils::{
+    file::{write_file, WriteResult},
+    schema::print_schema,
+};
 
 #[derive(Debug)]
 pub struct CodegenOptions {
@@ -65,14 +68,11 @@ pub fn perform(opts: CodegenOptions) -> anyhow::Result<()> {
         root: opts.project_root.clone(),
         schemas,
         android_package_name: config.android.package_name,
+        stats: config.codegen.stats,
+        executor: config.executor,
+        lto: config.build.lto,
     };
 
-    debug!("Cleaning up...");
-    AndroidGenerator::cleanup(&ctx)?;
-    IosGenerator::cleanup(&ctx)?;
-    RsGenerator::cleanup(&ctx)?;
-    CxxGenerator::cleanup(&ctx)?;
-
     let mut generate_res = vec![];
     let generators: Vec<Box<dyn GeneratorInvoker>> = vec![
         Box::new(AndroidGenerator::new()),
@@ -86,7 +86,14 @@ pub fn perform(opts: CodegenOptions) -> anyhow::Result<()> {
         generate_res.extend(generator.invoke_generate(&ctx)?);
     }
 
+    debug!("Cleaning up...");
+    AndroidGenerator::cleanup(&ctx, &generate_res)?;
+    IosGenerator::cleanup(&ctx, &generate_res)?;
+    RsGenerator::cleanup(&ctx, &generate_res)?;
+    CxxGenerator::cleanup(&ctx, &generate_res)?;
+
     let mut generated_cnt = 0;
+    let mut unchanged_cnt = 0;
     let mut preserved_files = vec![];
     for res in generate_res {
         let content = if res.overwrite {
@@ -96,29 +103,40 @@ pub fn perform(opts: CodegenOptions) -> anyhow::Result<()> {
         };
 
         let should_overwrite = opts.overwrite && res.overwrite;
-        if write_file(&res.path, &content, should_overwrite)? {
-            generated_cnt += 1;
-            debug!("File generated: {}", res.path.display());
-        } else {
-            // Save the content to a temporary directory if it's not written
-            let file_name = res.path.file_name().unwrap();
-            let dest = tmp_dir.join(file_name);
-            debug!("Saving to temporary directory: {}", dest.display());
-            write_file(&dest, &content, true)?;
-
-            if res.overwrite {
-                preserved_files.push(
-                    res.path
-                        .strip_prefix(&opts.project_root)?
-                        .to_string_lossy()
-                        .to_string(),
-                );
+        match write_file(&res.path, &content, should_overwrite)? {
+            WriteResult::Written => {
+                generated_cnt += 1;
+                debug!("File generated: {}", res.path.display());
+            }
+            WriteResult::Unchanged => {
+                unchanged_cnt += 1;
+                debug!("File unchanged: {}", res.path.display());
+            }
+            WriteResult::Skipped => {
+                // Save the content to a temporary directory if it's not written
+                let file_name = res.path.file_name().unwrap();
+                let dest = tmp_dir.join(file_name);
+                debug!("Saving to temporary directory: {}", dest.display());
+                write_file(&dest, &content, true)?;
+
+                if res.overwrite {
+                    preserved_files.push(
+                        res.path
+                            .strip_prefix(&opts.project_root)?
+                            .to_string_lossy()
+                            .to_string(),
+                    );
+                }
             }
         }
     }
 
     let elapsed = start_time.elapsed().as_millis();
-    info!("{} files generated", generated_cnt);
+    info!(
+        "{} files generated {}",
+        generated_cnt,
+        format!("({} unchanged)", unchanged_cnt).dimmed()
+    );
 
     let preserved_file_cnt = preserved_files.len();
     if preserved_file_cnt > 0 {
@@ -1,8 +1,27 @@
 use std::{fs, path::PathBuf};
 
-pub fn write_file(file_path: &PathBuf, content: &String, overwrite: bool) -> anyhow::Result<bool> {
-    if !overwrite && file_path.try_exists()? {
-        return Ok(false);
+#[derive(Debug, PartialEq)]
+pub enum WriteResult {
+    Written,
+    /// The file already has the same content, it is not rewritten to keep its modification time
+    Unchanged,
+    /// The file exists and `overwrite` is `false`
+    Skipped,
+}
+
+pub fn write_file(
+    file_path: &PathBuf,
+    content: &String,
+    overwrite: bool,
+) -> anyhow::Result<WriteResult> {
+    if file_path.try_exists()? {
+        if !overwrite {
+            return Ok(WriteResult::Skipped);
+        }
+
+        if fs::read(file_path)? == content.as_bytes() {
+            return Ok(WriteResult::Unchanged);
+        }
     }
 
     if let Some(parent) = file_path.parent() {
@@ -12,5 +31,5 @@ pub fn write_file(file_path: &PathBuf, content: &String, overwrite: bool) -> any
     }
 
     fs::write(file_path, content)?;
-    Ok(true)
+    Ok(WriteResult::Written)
 }
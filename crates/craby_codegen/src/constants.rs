@@ -9,11 +9,46 @@ pub mod specs {
     pub const REGISTRY_GET_ENFORCING: &str = "getEnforcing";
 
     pub const RESERVED_TYPE_ARRAY_BUFFER: &str = "ArrayBuffer";
+    pub const RESERVED_TYPE_FLOAT64_ARRAY: &str = "Float64Array";
+    pub const RESERVED_TYPE_FLOAT32_ARRAY: &str = "Float32Array";
+    pub const RESERVED_TYPE_INT32_ARRAY: &str = "Int32Array";
+    pub const RESERVED_TYPE_INT16_ARRAY: &str = "Int16Array";
+    pub const RESERVED_TYPE_UINT8_ARRAY: &str = "Uint8Array";
     pub const RESERVED_TYPE_PROMISE: &str = "Promise";
+    pub const RESERVED_TYPE_LAZY_ARRAY: &str = "LazyArray";
+    pub const RESERVED_TYPE_BYTE_STREAM: &str = "ByteStream";
+    pub const RESERVED_TYPE_MAPPED_FILE: &str = "MappedFile";
+    pub const RESERVED_TYPE_ABORT_SIGNAL: &str = "AbortSignal";
+    pub const RESERVED_TYPE_SHARED_STATE: &str = "SharedState";
 
     /// `it_` is reserved for the `shared_ptr` of the module
     pub const RESERVED_ARG_NAME_MODULE: &str = "it_";
 
     /// `emit` is reserved for signals
     pub const RESERVED_METHOD_NAME_MODULE: &str = "emit";
+
+    /// `batch` is reserved for the batched calls of the module
+    pub const RESERVED_METHOD_NAME_BATCH: &str = "batch";
+
+    /// `__crabyStats` is reserved for the recorded stats of the module (`[codegen] stats`)
+    pub const RESERVED_METHOD_NAME_STATS: &str = "__crabyStats";
+
+    /// JSDoc tag for the execution policy of `Promise` methods (eg. `@executor concurrent`)
+    pub const EXECUTOR_TAG: &str = "@executor";
+    pub const EXECUTOR_SERIAL: &str = "serial";
+    pub const EXECUTOR_CONCURRENT: &str = "concurrent";
+    pub const EXECUTOR_JS_THREAD: &str = "js-thread";
+    pub const EXECUTOR_ASYNC: &str = "async";
+
+    /// JSDoc tag for numeric sync methods called without the generic conversions (eg. `@pure`)
+    pub const PURE_TAG: &str = "@pure";
+
+    /// JSDoc tag for the delivery policy of signals (eg. `@delivery latest`)
+    pub const DELIVERY_TAG: &str = "@delivery";
+    pub const DELIVERY_EVERY: &str = "every";
+    pub const DELIVERY_LATEST: &str = "latest";
+    pub const DELIVERY_BATCH: &str = "batch";
+
+    /// JSDoc tag for object types converted to JS as host objects with lazy field access
+    pub const LAZY_TAG: &str = "@lazy";
 }
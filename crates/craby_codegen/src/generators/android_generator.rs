@@ -321,6 +321,25 @@ impl AndroidTemplate {
             .iter()
             .map(|schema| format!("../cpp/{}.cpp", CxxModuleName::from(&schema.module_name)))
             .collect::<Vec<_>>();
+        let stats_libs = if ctx.stats {
+            // ATrace sections of `CrabyStats.hpp`
+            "\n  # ATrace (`[codegen] stats`)\n  android"
+        } else {
+            ""
+        };
+        let lto_options = if ctx.lto {
+            // The prebuilt library is LLVM bitcode (`[build] lto`), optimized with the C++ sources at link time
+            let options = formatdoc! {
+                r#"
+                # Cross-language LTO (`[build] lto`)
+                target_compile_options(cxx-{kebab_name} PRIVATE -flto=thin)
+                target_link_options(cxx-{kebab_name} PRIVATE -flto=thin)"#,
+                kebab_name = kebab_name,
+            };
+            format!("\n\n{}", options)
+        } else {
+            String::new()
+        };
 
         formatdoc! {
             r#"
@@ -355,11 +374,17 @@ impl AndroidTemplate {
             target_link_libraries(cxx-{kebab_name}
               # android
               ReactAndroid::reactnative
-              ReactAndroid::jsi
+              ReactAndroid::jsi{stats_libs}
               # {kebab_name}-lib
               {kebab_name}-lib
             )
 
+            # Only the JNI entry points are exported, unused sections of the libraries are removed
+            target_link_options(cxx-{kebab_name} PRIVATE
+              -Wl,--exclude-libs,ALL
+              -Wl,--gc-sections
+            ){lto_options}
+
             # From ReactAndroid/cmake-utils/folly-flags.cmake
             target_compile_definitions(cxx-{kebab_name} PRIVATE
               -DFOLLY_NO_CONFIG=1
@@ -376,6 +401,8 @@ impl AndroidTemplate {
             kebab_name = kebab_name,
             lib_name = lib_name,
             cxx_mod_cpp_files = indent_str(&cxx_mod_cpp_files.join("\n"), 2),
+            stats_libs = stats_libs,
+            lto_options = lto_options,
         }
     }
 
@@ -516,7 +543,7 @@ impl AndroidGenerator {
 }
 
 impl Generator<AndroidTemplate> for AndroidGenerator {
-    fn cleanup(_: &CodegenContext) -> Result<(), anyhow::Error> {
+    fn cleanup(_: &CodegenContext, _: &[TemplateResult]) -> Result<(), anyhow::Error> {
         Ok(())
     }
 
@@ -569,4 +596,21 @@ mod tests {
 
         assert_snapshot!(result);
     }
+
+    #[test]
+    fn test_android_generator_lto() {
+        let ctx = CodegenContext {
+            lto: true,
+            ..get_codegen_context()
+        };
+        let generator = AndroidGenerator::new();
+        let results = generator.generate(&ctx).unwrap();
+        let result = results
+            .iter()
+            .find(|res| res.path.file_name().unwrap() == "CMakeLists.txt")
+            .map(|res| format!("{}\n{}", res.path.display(), res.content))
+            .unwrap();
+
+        assert_snapshot!(result);
+    }
 }
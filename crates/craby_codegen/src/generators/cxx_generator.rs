@@ -1,16 +1,20 @@
 use std::fs;
 
 use craby_common::{
+    config::{CoreAffinity, ThreadPriority},
     constants::{cxx_bridge_include_dir, cxx_dir},
     utils::string::{camel_case, flat_case, pascal_case, snake_case},
 };
 use indoc::formatdoc;
 
 use crate::{
-    constants::specs::RESERVED_ARG_NAME_MODULE,
+    constants::specs::{
+        RESERVED_ARG_NAME_MODULE, RESERVED_METHOD_NAME_BATCH, RESERVED_METHOD_NAME_STATS,
+    },
+    parser::types::SignalDelivery,
     platform::cxx::CxxMethod,
     types::{CodegenContext, CxxModuleName, CxxNamespace, Schema},
-    utils::indent_str,
+    utils::{indent_str, perfect_hash},
 };
 
 use super::types::{Generator, GeneratorInvoker, Template, TemplateResult};
@@ -27,6 +31,14 @@ pub enum CxxFileType {
     UtilsHpp,
     /// CrabySignals.h
     SignalsH,
+    /// CrabyStreams.h
+    StreamsH,
+    /// CrabyFutures.h
+    FuturesH,
+    /// CrabyStats.hpp (`[codegen] stats`)
+    StatsHpp,
+    /// CrabyRuntime.hpp
+    RuntimeHpp,
 }
 
 impl CxxTemplate {
@@ -40,13 +52,14 @@ impl CxxTemplate {
         &self,
         project_name: &str,
         schema: &Schema,
+        stats: bool,
     ) -> Result<Vec<CxxMethod>, anyhow::Error> {
         let cxx_ns = CxxNamespace::from(project_name);
         let mod_name = CxxModuleName::from(&schema.module_name);
         let res = schema
             .methods
             .iter()
-            .map(|spec| spec.as_cxx_method(&cxx_ns, &mod_name))
+            .map(|spec| spec.as_cxx_method(&cxx_ns, &mod_name, stats, schema.locks_state()))
             .collect::<Result<Vec<_>, _>>()?;
 
         Ok(res)
@@ -79,7 +92,6 @@ impl CxxTemplate {
     /// #include "CxxMyTestModule.hpp"
     /// #include "cxx.h"
     /// #include "bridging-generated.hpp"
-    /// #include <thread>
     /// #include <react/bridging/Bridging.h>
     ///
     /// using namespace facebook;
@@ -88,13 +100,21 @@ impl CxxTemplate {
     /// namespace myproject {
     /// namespace modules {
     ///
+    /// static constexpr std::array<CxxMyTestModule::MethodEntry, 2> kMethods = {{
+    ///   {"batch", 1, &CxxMyTestModule::batch, false},
+    ///   {"multiply", 2, &CxxMyTestModule::multiply, true},
+    /// }};
+    ///
     /// CxxMyTestModule::CxxMyTestModule(
     ///     std::shared_ptr<react::CallInvoker> jsInvoker)
     ///     : TurboModule(CxxMyTestModule::kModuleName, jsInvoker) {
     ///   callInvoker_ = std::move(jsInvoker);
-    ///   threadPool_ = std::make_shared<craby::utils::ThreadPool>(10);
-    ///   methodMap_["multiply"] = MethodMetadata{2, &CxxMyTestModule::multiply};
+    ///   executor_ = std::make_shared<craby::mymodule::utils::ModuleExecutor>(maxConcurrency);
     /// }
+    ///
+    /// // `create()` looks up `kMethods` by the perfect hash of the name (`kSlots`),
+    /// // `module()` creates the Rust module on the first call
+    ///
     /// jsi::Value CxxMyTestModule::multiply(jsi::Runtime &rt,
     ///                                       react::TurboModule &turboModule,
     ///                                       const jsi::Value args[],
@@ -115,6 +135,7 @@ impl CxxTemplate {
     /// #include "CrabyUtils.hpp"
     /// #include "ffi.rs.h"
     /// #include <ReactCommon/TurboModule.h>
+    /// #include <array>
     /// #include <jsi/jsi.h>
     /// #include <memory>
     ///
@@ -126,6 +147,7 @@ impl CxxTemplate {
     /// public:
     ///   static constexpr const char *kModuleName = "MyTestModule";
     ///   static std::string dataPath;
+    ///   static size_t maxConcurrency;
     ///
     ///   CxxMyTestModule(std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
     ///   ~CxxMyTestModule();
@@ -136,7 +158,13 @@ impl CxxTemplate {
     ///            const facebook::jsi::Value args[], size_t count);
     ///
     /// protected:
+    ///   facebook::jsi::Value create(facebook::jsi::Runtime &rt, const facebook::jsi::PropNameID &propName) override;
+    ///   std::shared_ptr<craby::mymodule::bridging::MyTestModule> &module();
+    ///
     ///   std::shared_ptr<facebook::react::CallInvoker> callInvoker_;
+    ///
+    /// private:
+    ///   std::once_flag moduleOnce_;
     ///   std::shared_ptr<craby::mymodule::bridging::MyTestModule> module_;
     /// };
     ///
@@ -148,21 +176,26 @@ impl CxxTemplate {
         &self,
         schema: &Schema,
         project_name: &str,
+        stats: bool,
     ) -> Result<(String, String), anyhow::Error> {
         let cxx_ns = CxxNamespace::from(project_name);
         let cxx_mod = CxxModuleName::from(&schema.module_name);
         let project_ns = flat_case(project_name);
-        let cxx_methods = self.cxx_methods(project_name, schema)?;
-        let include_stmt = format!("#include \"{cxx_mod}.hpp\"");
+        let cxx_methods = self.cxx_methods(project_name, schema, stats)?;
+        let include_stmt = if stats {
+            format!("#include \"{cxx_mod}.hpp\"\n#include \"CrabyStats.hpp\"")
+        } else {
+            format!("#include \"{cxx_mod}.hpp\"")
+        };
 
-        // Assign method metadata with function pointer to the TurboModule's method map
+        // Entries of the method table, looked up by `create()` instead of filling `methodMap_` per instance
         //
         // ```cpp
-        // methodMap_["multiply"] = MethodMetadata{1, &CxxMyTestModule::multiply};
+        // {"multiply", 1, &CxxMyTestModule::multiply, true},
         // ```
         let mut method_maps = cxx_methods
             .iter()
-            .map(|method| format!("methodMap_[\"{}\"] = {};", method.name, method.metadata))
+            .map(|method| (method.name.clone(), method.metadata.clone()))
             .collect::<Vec<_>>();
 
         let mut method_defs = cxx_methods
@@ -194,13 +227,31 @@ impl CxxTemplate {
             };
             
             let register_stmt = if let Some(ref signal_enum) = signal_enum_name {
+                // Pending signal queues of the `latest` and `batch` signals
+                //
+                // ```cpp
+                // signalQueues_[static_cast<size_t>(SignalId::OnProgress)] = std::make_shared<craby::mymodule::utils::SignalQueue<bridging::MyModuleSignal>>(true);
+                // ```
+                let signal_queues = schema
+                    .signals
+                    .iter()
+                    .filter(|signal| signal.delivery != SignalDelivery::Every)
+                    .map(|signal| {
+                        format!(
+                            "signalQueues_[static_cast<size_t>(SignalId::{})] = std::make_shared<{cxx_ns}::utils::SignalQueue<bridging::{signal_enum}>>({});\n",
+                            pascal_case(&signal.name),
+                            signal.delivery == SignalDelivery::Latest,
+                        )
+                    })
+                    .collect::<String>();
+
                 formatdoc! {
                     r#"
-                    uintptr_t id = reinterpret_cast<uintptr_t>(this);
+                    {signal_queues}uintptr_t id = reinterpret_cast<uintptr_t>(this);
                     auto& manager = {cxx_ns}::signals::SignalManager::getInstance();
                     manager.registerDelegate(id,
-                      [this](const std::string& name, void* signal) {{
-                        this->emit(name, reinterpret_cast<bridging::{signal_enum}*>(signal));
+                      [this](uint32_t signalId, void* signal) {{
+                        this->emit(static_cast<SignalId>(signalId), reinterpret_cast<bridging::{signal_enum}*>(signal));
                       }}
                     );"#,
                     signal_enum = signal_enum,
@@ -214,16 +265,24 @@ impl CxxTemplate {
                 // Unregister from signal manager
                 uintptr_t id = reinterpret_cast<uintptr_t>(this);
                 auto& manager = {cxx_ns}::signals::SignalManager::getInstance();
-                manager.unregisterDelegate(id);"#,
+                manager.unregisterDelegate(id);
+
+                {{
+                  std::lock_guard<std::mutex> lock(listenersMutex_);
+                  for (auto& listeners : listeners_) {{
+                    listeners.clear();
+                  }}
+                }}"#,
             };
 
             for signal in &schema.signals {
                 let signal_name = &signal.name;
                 let cxx_signal_name = camel_case(&signal.name);
 
-                method_maps.push(formatdoc! {
-                    r#"methodMap_["{signal_name}"] = MethodMetadata{{1, &{cxx_mod}::{cxx_signal_name}}};"#,
-                });
+                method_maps.push((
+                    signal_name.clone(),
+                    format!("{{\"{signal_name}\", 1, &{cxx_mod}::{cxx_signal_name}, true}}"),
+                ));
 
                 method_defs.push(formatdoc! {
                     r#"
@@ -240,8 +299,8 @@ impl CxxTemplate {
                                           const jsi::Value args[],
                                           size_t count) {{
                       auto &thisModule = static_cast<{cxx_mod} &>(turboModule);
-                      auto callInvoker = thisModule.callInvoker_;
-                      auto {it} = thisModule.module_;
+                      auto &callInvoker = thisModule.callInvoker_;
+                      auto &{it} = thisModule.module();
 
                       try {{
                         if (1 != count) {{
@@ -251,27 +310,17 @@ impl CxxTemplate {
                         auto callback = args[0].asObject(rt).asFunction(rt);
                         auto callbackRef = std::make_shared<jsi::Function>(std::move(callback));
                         auto id = thisModule.nextListenerId_.fetch_add(1);
-                        auto name = "{signal_name}";
-
-                        if (thisModule.listenersMap_.find(name) == thisModule.listenersMap_.end()) {{
-                          thisModule.listenersMap_[name] = std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>();
-                        }}
+                        auto signalId = static_cast<size_t>(SignalId::{signal_id});
 
                         {{
                           std::lock_guard<std::mutex> lock(thisModule.listenersMutex_);
-                          thisModule.listenersMap_[name].emplace(id, callbackRef);
+                          thisModule.listeners_[signalId].emplace(id, callbackRef);
                         }}
 
                         auto modulePtr = &thisModule;
-                        auto cleanup = [modulePtr, name, id] {{
+                        auto cleanup = [modulePtr, signalId, id] {{
                           std::lock_guard<std::mutex> lock(modulePtr->listenersMutex_);
-                          auto eventMap = modulePtr->listenersMap_.find(name);
-                          if (eventMap != modulePtr->listenersMap_.end()) {{
-                            auto it = eventMap->second.find(id);
-                            if (it != eventMap->second.end()) {{
-                              eventMap->second.erase(it);
-                            }}
-                          }}
+                          modulePtr->listeners_[signalId].erase(id);
                           return jsi::Value::undefined();
                         }};
 
@@ -290,237 +339,568 @@ impl CxxTemplate {
                       }}
                     }}"#,
                     it = RESERVED_ARG_NAME_MODULE,
+                    signal_id = pascal_case(&signal.name),
                 });
             }
 
-            let signal_enum_name = if !schema.signals.is_empty() {
-                Some(format!("{}Signal", schema.module_name))
-            } else {
-                None
-            };
-            
-            method_defs.insert(0, if let Some(ref signal_enum) = signal_enum_name {
-              format!("void emit(std::string name, bridging::{}* signal);", signal_enum)
-            } else {
-                "void emit(std::string name);".to_string()
-            });
+            let signal_enum = format!("{}Signal", schema.module_name);
+
+            method_defs.insert(
+                0,
+                formatdoc! {
+                    r#"
+                    void emit(SignalId signalId, bridging::{signal_enum}* signal);
 
-            // Generate payload extraction conditions dynamically
-            let payload_extraction = if signal_enum_name.is_some() {
-                let mut conditions: Vec<String> = schema.signals
+                    static facebook::jsi::Value
+                    signalPayload(facebook::jsi::Runtime &rt,
+                        SignalId signalId,
+                        const bridging::{signal_enum} *signal);"#,
+                },
+            );
+
+            // Payload extraction of the signals with payload
+            //
+            // ```cpp
+            // case SignalId::OnProgress: {
+            //   auto payload = craby::mymodule::bridging::get_on_progress_payload(*signal);
+            //   return react::bridging::toJs(rt, std::move(payload));
+            // }
+            // ```
+            let payload_extraction = schema
+                .signals
+                .iter()
+                .filter(|signal| signal.payload_type.is_some())
+                .map(|signal| {
+                    formatdoc! {
+                        r#"
+                        case SignalId::{signal_id}: {{
+                          auto payload = craby::{project_ns}::bridging::{function_name}(*signal);
+                          return react::bridging::toJs(rt, std::move(payload));
+                        }}"#,
+                        signal_id = pascal_case(&signal.name),
+                        function_name = format!("get_{}_payload", snake_case(&signal.name)),
+                    }
+                })
+                .collect::<Vec<_>>();
+
+            // `[codegen] stats`: Delivery latency of the signals, from `emit` to the call of the listeners
+            //
+            // ```cpp
+            // static const std::array<craby::mymodule::stats::MethodRef, 1> signalStats = {{
+            //   craby::mymodule::stats::method(kModuleName, "onProgress"),
+            // }};
+            // ```
+            let (stats_decls, stats_captures, stats_record) = if stats {
+                let signal_stats = schema
+                    .signals
                     .iter()
-                    .filter_map(|signal| {
-                        signal.payload_type.as_ref().map(|_| {
-                            let function_name = format!("get_{}_payload", snake_case(&signal.name));
-                            formatdoc! {
-                                r#"else if (name == "{signal_name}") {{
-                                  auto payload = craby::{project_ns}::bridging::{function_name}(*signalPtr);
-                                  data = react::bridging::toJs(rt, payload);
-                                }}"#,
-                                signal_name = signal.name,
-                                function_name = function_name,
-                            }
-                        })
+                    .map(|signal| {
+                        format!(
+                            "  {cxx_ns}::stats::method(kModuleName, \"{}\"),\n",
+                            signal.name
+                        )
                     })
-                    .collect();
-                
-                if !conditions.is_empty() {
-                    // Replace first "else if" with "if"
-                    if let Some(first) = conditions.first_mut() {
-                        *first = first.replace("else if", "if");
+                    .collect::<String>();
+
+                (
+                    formatdoc! {
+                        r#"
+
+                        static const std::array<{cxx_ns}::stats::MethodRef, {count}> signalStats = {{{{
+                        {signal_stats}}}}};
+                        auto statsRef = signalStats[index];
+                        auto emitted = {cxx_ns}::stats::Clock::now();"#,
+                        count = schema.signals.len(),
                     }
-                    let joined = conditions.join(" ");
-                    indent_str(&joined, 10)
-                } else {
+                    .replace("\n", "\n  "),
+                    ", statsRef, emitted",
+                    format!("{cxx_ns}::stats::record(statsRef, {cxx_ns}::stats::Phase::Signal, emitted);"),
+                )
+            } else {
+                (String::new(), "", String::new())
+            };
+            // Recorded before the listeners are called, followed by the indentation of the next statement
+            let stats_record = |indent: usize| {
+                if stats_record.is_empty() {
                     String::new()
+                } else {
+                    format!("{stats_record}\n{}", " ".repeat(indent))
                 }
-            } else {
+            };
+            let payload_extraction = if payload_extraction.is_empty() {
                 String::new()
+            } else {
+                format!("{}\n", indent_str(&payload_extraction.join("\n"), 4))
             };
 
             method_impls.insert(
                 0,
-                if let Some(ref signal_enum) = signal_enum_name {
-                    formatdoc! {
-                        r#"
-                        void {cxx_mod}::emit(std::string name, bridging::{signal_enum}* signal) {{
-                          std::vector<std::shared_ptr<facebook::jsi::Function>> listeners;
-                          {{
-                            std::lock_guard<std::mutex> lock(listenersMutex_);
-                            auto it = listenersMap_.find(name);
-                            if (it != listenersMap_.end()) {{
-                              for (auto &[_, listener] : it->second) {{
-                                listeners.push_back(listener);
-                              }}
-                            }}
+                formatdoc! {
+                    r#"
+                    void {cxx_mod}::emit(SignalId signalId, bridging::{signal_enum}* signal) {{
+                      // Use shared_ptr to manage signal lifetime across async callbacks
+                      auto signalPtr = std::shared_ptr<bridging::{signal_enum}>(
+                        signal,
+                        [](bridging::{signal_enum}* ptr) {{
+                          // Use Rust FFI function to drop signal memory
+                          if (ptr != nullptr) {{
+                            craby::{project_ns}::bridging::drop_signal(ptr);
                           }}
+                        }}
+                      );
 
-                          // Prepare payload: extract from signal or use undefined
-                          auto payloadPtr = std::make_shared<facebook::jsi::Value>();
-                          
-                          if (signal == nullptr) {{
-                            *payloadPtr = facebook::jsi::Value::undefined();
-                          }} else {{
-                            // Use shared_ptr to manage signal lifetime across async callbacks
-                            auto signalPtr = std::shared_ptr<bridging::{signal_enum}>(
-                              signal,
-                              [](bridging::{signal_enum}* ptr) {{
-                                // Use Rust FFI function to drop signal memory
-                                if (ptr != nullptr) {{
-                                  craby::{project_ns}::bridging::drop_signal(ptr);
-                                }}
-                              }}
-                            );
-
-                            // Extract payload using FFI function and convert to jsi::Value
-                            // We'll need to capture signalPtr in the lambda
-                            for (auto& listener : listeners) {{
-                              try {{
-                                callInvoker_->invokeAsync([listener, signalPtr, name](jsi::Runtime &rt) {{
-                                  jsi::Value data = jsi::Value::undefined();
-                        {payload_extraction}
-                                  listener->call(rt, data);
-                                }});
-                              }} catch (const std::exception& err) {{
-                                // Noop
+                      auto index = static_cast<size_t>(signalId);{stats_decls}
+                      std::vector<std::shared_ptr<facebook::jsi::Function>> listeners;
+                      {{
+                        std::lock_guard<std::mutex> lock(listenersMutex_);
+                        for (auto &[_, listener] : listeners_[index]) {{
+                          listeners.push_back(listener);
+                        }}
+                      }}
+
+                      if (listeners.empty()) {{
+                        return;
+                      }}
+
+                      auto signalQueue = signalQueues_[index];
+                      if (!signalQueue) {{
+                        // `every`: Deliver each signal
+                        try {{
+                          callInvoker_->invokeAsync([listeners, signalPtr, signalId{stats_captures}](jsi::Runtime &rt) {{
+                            try {{
+                              auto data = signalPayload(rt, signalId, signalPtr.get());
+                              {stats_record_every}for (auto& listener : listeners) {{
+                                listener->call(rt, data);
                               }}
+                            }} catch (const jsi::JSError &err) {{
+                              throw err;
+                            }} catch (const std::exception &err) {{
+                              throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
                             }}
-                            return;
-                          }}
+                          }});
+                        }} catch (const std::exception& err) {{
+                          // Noop
+                        }}
+                        return;
+                      }}
 
-                          for (auto& listener : listeners) {{
-                            try {{
-                              callInvoker_->invokeAsync([listener, payloadPtr](jsi::Runtime &rt) {{
-                                try {{
-                                  listener->call(rt, *payloadPtr);
-                                }} catch (const jsi::JSError &err) {{
-                                  throw err;
-                                }} catch (const std::exception &err) {{
-                                  throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
-                                }}
-                              }});
-                            }} catch (const std::exception& err) {{
-                              // Noop
+                      // `latest` and `batch`: Schedule a single flush for the pending signals
+                      if (!signalQueue->push(std::move(signalPtr))) {{
+                        return;
+                      }}
+
+                      try {{
+                        callInvoker_->invokeAsync([listeners, signalQueue, signalId{stats_captures}](jsi::Runtime &rt) {{
+                          try {{
+                            auto signals = signalQueue->take();
+                            if (signals.empty()) {{
+                              return;
                             }}
-                          }}
-                        }}"#,
-                        signal_enum = signal_enum,
-                        project_ns = project_ns,
-                        cxx_mod = cxx_mod,
-                        cxx_ns = cxx_ns,
-                        payload_extraction = payload_extraction,
-                    }
-                } else {
-                    formatdoc! {
-                        r#"
-                        void {cxx_mod}::emit(std::string name) {{
-                          std::vector<std::shared_ptr<facebook::jsi::Function>> listeners;
-                          {{
-                            std::lock_guard<std::mutex> lock(listenersMutex_);
-                            auto it = listenersMap_.find(name);
-                            if (it != listenersMap_.end()) {{
-                              for (auto &[_, listener] : it->second) {{
-                                listeners.push_back(listener);
+
+                            jsi::Value data;
+                            if (signalQueue->isLatest()) {{
+                              data = signalPayload(rt, signalId, signals.back().get());
+                            }} else {{
+                              auto arr = jsi::Array(rt, signals.size());
+                              for (size_t i = 0; i < signals.size(); i++) {{
+                                arr.setValueAtIndex(rt, i, signalPayload(rt, signalId, signals[i].get()));
                               }}
+                              data = std::move(arr);
                             }}
-                          }}
 
-                          for (auto& listener : listeners) {{
-                            try {{
-                              callInvoker_->invokeAsync([listener, payloadPtr](jsi::Runtime &rt) {{
-                                try {{
-                                  listener->call(rt, *payloadPtr);
-                                }} catch (const jsi::JSError &err) {{
-                                  throw err;
-                                }} catch (const std::exception &err) {{
-                                  throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
-                                }}
-                              }});
-                            }} catch (const std::exception& err) {{
-                              // Noop
+                            {stats_record_queued}for (auto& listener : listeners) {{
+                              listener->call(rt, data);
                             }}
+                          }} catch (const jsi::JSError &err) {{
+                            throw err;
+                          }} catch (const std::exception &err) {{
+                            throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
                           }}
-                        }}"#,
-                    }
-                }
-            );
+                        }});
+                      }} catch (const std::exception& err) {{
+                        // Noop
+                      }}
+                    }}
+
+                    jsi::Value {cxx_mod}::signalPayload(jsi::Runtime &rt,
+                                                        SignalId signalId,
+                                                        const bridging::{signal_enum} *signal) {{
+                      if (signal == nullptr) {{
+                        return jsi::Value::undefined();
+                      }}
 
+                      switch (signalId) {{
+                    {payload_extraction}    default:
+                          return jsi::Value::undefined();
+                      }}
+                    }}"#,
+                    stats_record_every = stats_record(10),
+                    stats_record_queued = stats_record(8),
+                },
+            );
 
             (register_stmt, unregister_stmt)
         } else {
             (String::from("// No signals"), String::from("// No signals"))
         };
 
+        // Runs multiple calls of the module in one JSI call, dispatched by the method table
+        //
+        // ```ts
+        // MyModule.batch([{ method: 'multiply', args: [1, 2] }, { method: 'setState', args: [3] }]); // [2, undefined]
+        // ```
+        method_maps.push((
+            RESERVED_METHOD_NAME_BATCH.to_string(),
+            format!("{{\"{RESERVED_METHOD_NAME_BATCH}\", 1, &{cxx_mod}::batch, false}}"),
+        ));
+
+        method_defs.push(formatdoc! {
+            r#"
+            static facebook::jsi::Value
+            batch(facebook::jsi::Runtime &rt,
+                facebook::react::TurboModule &turboModule,
+                const facebook::jsi::Value args[], size_t count);"#,
+        });
+
+        method_impls.push(formatdoc! {
+            r#"
+            jsi::Value {cxx_mod}::batch(jsi::Runtime &rt,
+                                  react::TurboModule &turboModule,
+                                  const jsi::Value args[],
+                                  size_t count) {{
+              auto &thisModule = static_cast<{cxx_mod} &>(turboModule);
+
+              if (1 != count) {{
+                throw jsi::JSError(rt, "Expected 1 argument");
+              }}
+
+              try {{
+                auto props = {cxx_ns}::utils::RuntimeCache::propNames<{cxx_mod}>(rt, {{"method", "args"}});
+                auto ops = args[0].asObject(rt).asArray(rt);
+                auto size = ops.size(rt);
+                auto results = jsi::Array(rt, size);
+                std::vector<jsi::Value> opArgs;
+
+                for (size_t i = 0; i < size; i++) {{
+                  auto op = ops.getValueAtIndex(rt, i).asObject(rt);
+                  auto method = op.getProperty(rt, (*props)[0]).asString(rt).utf8(rt);
+                  auto entry = findMethod(method);
+                  if (entry == nullptr) {{
+                    throw jsi::JSError(rt, "Unknown method: " + method);
+                  }}
+                  // A nested `batch` or a `Promise` in the results would not run (or settle) within the batch
+                  if (!entry->batchable) {{
+                    throw jsi::JSError(rt, "Method cannot be batched: " + method);
+                  }}
+
+                  // Each call checks its arguments as if it was called directly
+                  auto arr = op.getProperty(rt, (*props)[1]).asObject(rt).asArray(rt);
+                  auto argCount = arr.size(rt);
+                  opArgs.clear();
+                  opArgs.reserve(argCount);
+                  for (size_t j = 0; j < argCount; j++) {{
+                    opArgs.push_back(arr.getValueAtIndex(rt, j));
+                  }}
+
+                  results.setValueAtIndex(rt, i, entry->invoker(rt, thisModule, opArgs.data(), argCount));
+                }}
+
+                return results;
+              }} catch (const jsi::JSError &err) {{
+                throw err;
+              }} catch (const std::exception &err) {{
+                throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
+              }}
+            }}"#,
+        });
+
+        // `[codegen] stats`: Recorded phases of the module's methods and signals (see `CrabyStats.hpp`)
+        //
+        // ```ts
+        // MyModule.__crabyStats(); // { multiply: { count: 2, errors: 0, fromJs: { ... }, rust: { ... }, toJs: { ... } } }
+        // ```
+        if stats {
+            method_maps.push((
+                RESERVED_METHOD_NAME_STATS.to_string(),
+                format!("{{\"{RESERVED_METHOD_NAME_STATS}\", 0, &{cxx_mod}::crabyStats, true}}"),
+            ));
+
+            method_defs.push(formatdoc! {
+                r#"
+                static facebook::jsi::Value
+                crabyStats(facebook::jsi::Runtime &rt,
+                    facebook::react::TurboModule &turboModule,
+                    const facebook::jsi::Value args[], size_t count);"#,
+            });
+
+            method_impls.push(formatdoc! {
+                r#"
+                jsi::Value {cxx_mod}::crabyStats(jsi::Runtime &rt,
+                                      react::TurboModule &turboModule,
+                                      const jsi::Value args[],
+                                      size_t count) {{
+                  return {cxx_ns}::stats::toJs(rt, kModuleName);
+                }}"#,
+            });
+        }
+
         let rs_module_name = pascal_case(&schema.module_name);
         let register_stmts = indent_str(&register_stmt, 2);
         let unregister_stmts = indent_str(&unregister_stmt, 2);
-        let method_mapping_stmts = indent_str(&method_maps.join("\n"), 2);
+        // Sorted by name for a stable order of `getPropertyNames()`
+        method_maps.sort_by(|(a, _), (b, _)| a.as_bytes().cmp(b.as_bytes()));
+        let method_count = method_maps.len();
+
+        // Perfect hash of the method names: `kSlots[hashName(name) >> kHashShift]` is the index of the method
+        //
+        // ```cpp
+        // static constexpr std::array<uint16_t, 8> kSlots = {{
+        //   kNoMethod, 1, kNoMethod, 0, kNoMethod, kNoMethod, kNoMethod, kNoMethod,
+        // }};
+        // ```
+        let names = method_maps
+            .iter()
+            .map(|(name, _)| name.as_str())
+            .collect::<Vec<_>>();
+        let hash = perfect_hash(&names);
+        let hash_seed = hash.seed;
+        let hash_shift = hash.shift;
+        let slot_count = hash.slots.len();
+        let hash_slots = indent_str(
+            &hash
+                .slots
+                .chunks(8)
+                .map(|chunk| {
+                    chunk
+                        .iter()
+                        .map(|slot| match slot {
+                            Some(index) => index.to_string(),
+                            None => "kNoMethod".to_string(),
+                        })
+                        .collect::<Vec<_>>()
+                        .join(", ")
+                        + ","
+                })
+                .collect::<Vec<_>>()
+                .join("\n"),
+            2,
+        );
+        let method_table = indent_str(
+            &method_maps
+                .into_iter()
+                .map(|(_, entry)| format!("{entry},"))
+                .collect::<Vec<_>>()
+                .join("\n"),
+            2,
+        );
         let method_impls = method_impls.join("\n\n");
         let cpp = formatdoc! {
             r#"
             std::string {cxx_mod}::dataPath = std::string();
+            size_t {cxx_mod}::maxConcurrency = 0;
+
+            // Methods of the module sorted by name, shared by every instance
+            static constexpr std::array<{cxx_mod}::MethodEntry, {method_count}> kMethods = {{{{
+            {method_table}
+            }}}};
+
+            // Perfect hash of the method names (FNV-1a, the seed is found by the codegen)
+            static constexpr uint32_t kHashSeed = {hash_seed};
+            static constexpr uint32_t kHashShift = {hash_shift};
+            static constexpr uint16_t kNoMethod = 0xFFFF;
+            static constexpr std::array<uint16_t, {slot_count}> kSlots = {{{{
+            {hash_slots}
+            }}}};
+
+            static constexpr uint32_t hashName(std::string_view name) {{
+              uint32_t hash = 2166136261u ^ kHashSeed;
+              for (char c : name) {{
+                hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+              }}
+              return hash;
+            }}
+
+            static_assert([] {{
+              for (size_t i = 0; i < kMethods.size(); i++) {{
+                if (kSlots[hashName(kMethods[i].name) >> kHashShift] != i) {{
+                  return false;
+                }}
+              }}
+              return true;
+            }}(), "Every method must have its own slot");
 
             {cxx_mod}::{cxx_mod}(
                 std::shared_ptr<react::CallInvoker> jsInvoker)
                 : TurboModule({cxx_mod}::kModuleName, jsInvoker) {{
             {register_stmts}
               callInvoker_ = std::move(jsInvoker);
-              module_ = std::shared_ptr<{cxx_ns}::bridging::{rs_module_name}>(
-                {cxx_ns}::bridging::create{rs_module_name}(
-                  reinterpret_cast<uintptr_t>(this),
-                  rust::Str(dataPath.data(), dataPath.size())).into_raw(),
-                []({cxx_ns}::bridging::{rs_module_name} *ptr) {{ rust::Box<{cxx_ns}::bridging::{rs_module_name}>::from_raw(ptr); }}
-              );
-              threadPool_ = std::make_shared<{cxx_ns}::utils::ThreadPool>(10);
-            {method_mapping_stmts}
+              executor_ = std::make_shared<{cxx_ns}::utils::ModuleExecutor>(maxConcurrency);
+              runtimeCache_ = std::make_shared<{cxx_ns}::utils::RuntimeCache>();
             }}
 
             {cxx_mod}::~{cxx_mod}() {{
               invalidate();
             }}
 
+            const {cxx_mod}::MethodEntry *{cxx_mod}::findMethod(std::string_view name) {{
+              auto slot = kSlots[hashName(name) >> kHashShift];
+              if (slot == kNoMethod || kMethods[slot].name != name) {{
+                return nullptr;
+              }}
+              return &kMethods[slot];
+            }}
+
+            jsi::Value {cxx_mod}::create(jsi::Runtime &rt, const jsi::PropNameID &propName) {{
+              if (runtime_.exchange(&rt) != &rt) {{
+                {cxx_ns}::utils::RuntimeCache::bind(rt, runtimeCache_);
+              }}
+              auto entry = findMethod(propName.utf8(rt));
+              if (entry == nullptr) {{
+                return jsi::Value::undefined();
+              }}
+
+              auto invoker = entry->invoker;
+              return jsi::Function::createFromHostFunction(
+                rt,
+                propName,
+                static_cast<unsigned int>(entry->argCount),
+                [this, invoker](jsi::Runtime &rt, const jsi::Value &thisVal, const jsi::Value *args, size_t count) {{
+                  return invoker(rt, *this, args, count);
+                }});
+            }}
+
+            std::vector<jsi::PropNameID> {cxx_mod}::getPropertyNames(jsi::Runtime &rt) {{
+              std::vector<jsi::PropNameID> names;
+              names.reserve(kMethods.size());
+              for (auto &entry : kMethods) {{
+                names.push_back(jsi::PropNameID::forAscii(rt, entry.name.data(), entry.name.size()));
+              }}
+              return names;
+            }}
+
+            std::shared_ptr<{cxx_ns}::bridging::{rs_module_name}> &{cxx_mod}::module() {{
+              // Not recreated after `invalidate()`, the method rethrows the error as a `jsi::JSError`
+              if (invalidated_.load()) {{
+                throw std::runtime_error("Module is invalidated");
+              }}
+
+              // Created on the first call of the module, not on its construction by the TurboModule registry
+              std::call_once(moduleOnce_, [this] {{
+                module_ = std::shared_ptr<{cxx_ns}::bridging::{rs_module_name}>(
+                  {cxx_ns}::bridging::create{rs_module_name}(
+                    reinterpret_cast<uintptr_t>(this),
+                    rust::Str(dataPath.data(), dataPath.size())).into_raw(),
+                  []({cxx_ns}::bridging::{rs_module_name} *ptr) {{ rust::Box<{cxx_ns}::bridging::{rs_module_name}>::from_raw(ptr); }}
+                );
+              }});
+              return module_;
+            }}
+
             void {cxx_mod}::invalidate() {{
               if (invalidated_.exchange(true)) {{
                 return;
               }}
 
-              invalidated_.store(true);
-              listenersMap_.clear();
+              // `jsi::PropNameID` must be released on the runtime's thread, before the runtime is destroyed
+              runtimeCache_.reset();
             
             {unregister_stmts}
 
-              // Shutdown thread pool
-              threadPool_->shutdown();
+              // Reject the promises of the queued tasks, the running ones finish on their own
+              executor_->shutdown();
             }}
             
             {method_impls}"#,
         };
 
         let method_defs = indent_str(&method_defs.join("\n\n"), 2);
+        let (signal_ids, signal_members) = if schema.signals.is_empty() {
+            (String::new(), String::new())
+        } else {
+            // Signal IDs, in the same order as the IDs passed from the generated Rust `emit`
+            //
+            // ```cpp
+            // enum class SignalId : uint32_t {
+            //   OnProgress = 0,
+            // };
+            // ```
+            let signal_ids = schema
+                .signals
+                .iter()
+                .enumerate()
+                .map(|(signal_id, signal)| format!("{} = {signal_id},", pascal_case(&signal.name)))
+                .collect::<Vec<_>>();
+            let signal_ids = formatdoc! {
+                r#"
+                enum class SignalId : uint32_t {{
+                {signal_ids}
+                }};
+                static constexpr size_t kSignalCount = {signal_count};"#,
+                signal_ids = indent_str(&signal_ids.join("\n"), 2),
+                signal_count = schema.signals.len(),
+            };
+            let signal_members = formatdoc! {
+                r#"
+                std::mutex listenersMutex_;
+                std::array<
+                  std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>,
+                  kSignalCount>
+                  listeners_;
+                std::array<
+                  std::shared_ptr<{cxx_ns}::utils::SignalQueue<bridging::{signal_enum}>>,
+                  kSignalCount>
+                  signalQueues_;"#,
+                signal_enum = format!("{}Signal", schema.module_name),
+            };
+            (
+                format!("\n\n{}", indent_str(&signal_ids, 2)),
+                format!("\n{}", indent_str(&signal_members, 2)),
+            )
+        };
         let hpp = formatdoc! {
             r#"
             class JSI_EXPORT {cxx_mod} : public facebook::react::TurboModule {{
             public:
               static constexpr const char *kModuleName = "{turbo_module_name}";
               static std::string dataPath;
+              // Max number of running async tasks of this module (`0` = limited by the shared executor's worker count)
+              static size_t maxConcurrency;{signal_ids}
+
+              struct MethodEntry {{
+                std::string_view name;
+                size_t argCount;
+                facebook::jsi::Value (*invoker)(
+                    facebook::jsi::Runtime &rt,
+                    facebook::react::TurboModule &turboModule,
+                    const facebook::jsi::Value args[], size_t count);
+                // `false` for `batch` and the methods returning a `Promise`, which `batch` rejects
+                bool batchable;
+              }};
 
               {cxx_mod}(std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
               ~{cxx_mod}();
 
               void invalidate();
+              std::vector<facebook::jsi::PropNameID> getPropertyNames(facebook::jsi::Runtime &rt) override;
+              static const MethodEntry *findMethod(std::string_view name);
             {method_defs}
 
             protected:
+              facebook::jsi::Value create(facebook::jsi::Runtime &rt, const facebook::jsi::PropNameID &propName) override;
+              std::shared_ptr<{cxx_ns}::bridging::{rs_module_name}> &module();
+
               std::shared_ptr<facebook::react::CallInvoker> callInvoker_;
-              std::shared_ptr<{cxx_ns}::bridging::{rs_module_name}> module_;
+              // Runtime the module is installed into (the main runtime or a worker runtime, see `CrabyRuntime.hpp`)
+              std::atomic<facebook::jsi::Runtime *> runtime_{{nullptr}};
+              // JSI values cached for `runtime_` (see `RuntimeCache`), released by `invalidate()`
+              std::shared_ptr<{cxx_ns}::utils::RuntimeCache> runtimeCache_;
               std::atomic<bool> invalidated_{{false}};
               std::atomic<size_t> nextListenerId_{{0}};
-              std::mutex listenersMutex_;
-              std::unordered_map<
-                std::string,
-                std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>>
-                listenersMap_;
-              std::shared_ptr<{cxx_ns}::utils::ThreadPool> threadPool_;
+              std::shared_ptr<{cxx_ns}::utils::ModuleExecutor> executor_;{signal_members}
+
+            private:
+              std::once_flag moduleOnce_;
+              std::shared_ptr<{cxx_ns}::bridging::{rs_module_name}> module_;
             }};"#,
             turbo_module_name = schema.module_name,
         };
@@ -552,8 +932,12 @@ impl CxxTemplate {
             #include "CrabyUtils.hpp"
             #include "ffi.rs.h"
             #include <ReactCommon/TurboModule.h>
+            #include <array>
             #include <jsi/jsi.h>
             #include <memory>
+            #include <mutex>
+            #include <string_view>
+            #include <vector>
             
             namespace craby {{
             namespace {project_ns} {{
@@ -587,13 +971,12 @@ impl CxxTemplate {
     ///
     /// template <>
     /// struct Bridging<rust::String> {
-    ///   static rust::String fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {
-    ///     auto str = value.asString(rt).utf8(rt);
-    ///     return rust::String(str);
+    ///   static rust::String fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    ///     return craby::mymodule::utils::stringFromJs(rt, value.asString(rt));
     ///   }
     ///
     ///   static jsi::Value toJs(jsi::Runtime& rt, const rust::String& value) {
-    ///     return react::bridging::toJs(rt, std::string(value));
+    ///     return jsi::String::createFromUtf8(rt, reinterpret_cast<const uint8_t*>(value.data()), value.size());
     ///   }
     /// };
     ///
@@ -610,14 +993,44 @@ impl CxxTemplate {
             .flatten()
             .collect::<Vec<_>>();
 
+        let mut extra_utils = vec![];
+        if Schema::has_byte_streams(&ctx.schemas) {
+            extra_utils.push(self.cxx_stream_utils(&ctx.project_name));
+        }
+        if Schema::has_abort_signals(&ctx.schemas) {
+            extra_utils.push(self.cxx_abort_utils(&ctx.project_name));
+        }
+        if Schema::has_futures(&ctx.schemas) {
+            extra_utils.push(self.cxx_future_utils(&ctx.project_name));
+        }
+        if Schema::has_shared_states(&ctx.schemas) {
+            extra_utils.push(self.cxx_shared_state_utils(&ctx.project_name));
+        }
+        if Schema::has_mapped_files(&ctx.schemas) {
+            extra_utils.push(self.cxx_mapped_file_utils(&ctx.project_name));
+        }
+
         let cxx_bridging = formatdoc! {
             r#"
             #pragma once
 
+            #include "CrabyUtils.hpp"
             #include "cxx.h"
             #include "ffi.rs.h"
             #include <react/bridging/Bridging.h>
+            #include <cstdint>
+            #include <cstring>
+            #include <initializer_list>
+            #include <memory>
+            #include <mutex>
+            #include <optional>
+            #include <string>
+            #include <string_view>
+            #include <type_traits>
+            #include <typeindex>
+            #include <unordered_map>
             #include <variant>
+            #include <vector>
 
             using namespace facebook;
 
@@ -628,7 +1041,10 @@ impl CxxTemplate {
               explicit RustVecBuffer(rust::Vec<uint8_t> vec)
                 : vec_(std::move(vec)) {{}}
 
-              ~RustVecBuffer() override = default;
+              // Give the buffer back to the Rust side buffer pool (`craby::pool`)
+              ~RustVecBuffer() override {{
+                {cxx_ns}::bridging::recycleBuffer(std::move(vec_));
+              }}
 
               size_t size() const override {{
                 return vec_.size();
@@ -644,312 +1060,2453 @@ impl CxxTemplate {
 
             }} // namespace {flat_name}
 
-            namespace facebook {{
-            namespace react {{
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
 
-            template <>
-            struct Bridging<std::monostate> {{
-              static std::monostate fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {{
-                return std::monostate{{}};
+            template <typename T>
+            class RustTypedVecBuffer : public jsi::MutableBuffer {{
+            public:
+              explicit RustTypedVecBuffer(rust::Vec<T> vec)
+                : vec_(std::move(vec)) {{}}
+
+              ~RustTypedVecBuffer() override = default;
+
+              size_t size() const override {{
+                return vec_.size() * sizeof(T);
               }}
 
-              static jsi::Value toJs(jsi::Runtime& rt, const std::monostate& value) {{
-                return jsi::Value::undefined();
+              uint8_t* data() override {{
+                return reinterpret_cast<uint8_t*>(const_cast<T*>(vec_.data()));
               }}
+
+            private:
+              rust::Vec<T> vec_;
             }};
 
-            template <>
-            struct Bridging<rust::Str> {{
-              static rust::Str fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {{
-                auto str = value.asString(rt).utf8(rt);
-                return rust::Str(str.data(), str.size());
+            // Name of the typed array with elements of type `T` (eg. `Float64Array` for `double`)
+            template <typename T>
+            constexpr const char* typedArrayName() {{
+              if constexpr (std::is_same_v<T, double>) {{
+                return "Float64Array";
+              }} else if constexpr (std::is_same_v<T, float>) {{
+                return "Float32Array";
+              }} else if constexpr (std::is_same_v<T, int32_t>) {{
+                return "Int32Array";
+              }} else if constexpr (std::is_same_v<T, int16_t>) {{
+                return "Int16Array";
+              }} else {{
+                static_assert(std::is_same_v<T, uint8_t>, "Unsupported typed array element type");
+                return "Uint8Array";
               }}
+            }}
 
-              static jsi::Value toJs(jsi::Runtime& rt, const rust::Str& value) {{
-                return react::bridging::toJs(rt, std::string(value.data(), value.size()));
+            // Borrows the elements of a typed array (eg. `Float64Array`) from its underlying `ArrayBuffer`.
+            // The slice is valid as long as the typed array object is alive.
+            // Throws if the value is not a typed array of `T` or its view is out of the bounds of the buffer.
+            template <typename T>
+            rust::Slice<T> typedArraySlice(jsi::Runtime& rt, const jsi::Object& typedArray) {{
+              constexpr auto name = typedArrayName<T>();
+              if (!typedArray.instanceOf(rt, rt.global().getPropertyAsFunction(rt, name))) {{
+                throw jsi::JSError(rt, std::string("Expected ") + name);
               }}
-            }};
 
-            template <>
-            struct Bridging<rust::String> {{
-              static rust::String fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {{
-                auto str = value.asString(rt).utf8(rt);
-                return rust::String(str.data(), str.size());
+              auto buffer = typedArray.getProperty(rt, "buffer").asObject(rt).getArrayBuffer(rt);
+              auto byteOffset = static_cast<size_t>(typedArray.getProperty(rt, "byteOffset").asNumber());
+              auto length = static_cast<size_t>(typedArray.getProperty(rt, "length").asNumber());
+              auto size = buffer.size(rt);
+              if (byteOffset > size || length > (size - byteOffset) / sizeof(T) || byteOffset % alignof(T) != 0) {{
+                throw jsi::JSError(rt, std::string("Out of bounds ") + name);
               }}
 
-              static jsi::Value toJs(jsi::Runtime& rt, const rust::String& value) {{
-                return react::bridging::toJs(rt, std::string(value.data(), value.size()));
-              }}
-            }};
+              return rust::Slice<T>(reinterpret_cast<T*>(buffer.data(rt) + byteOffset), length);
+            }}
 
-            template <>
-            struct Bridging<rust::Vec<uint8_t>> {{
-              static rust::Vec<uint8_t> fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {{
-                auto arrayBuffer = value.asObject(rt).getArrayBuffer(rt);
-                uint8_t* data = arrayBuffer.data(rt);
-                size_t size = arrayBuffer.size(rt);
-                rust::Vec<uint8_t> vec;
-                vec.reserve(size);
+            // Mutable slices borrowed by the arguments of a call.
+            // A slice overlapping a previous one (eg. two views of the same `ArrayBuffer`) is passed as a copy,
+            // so the Rust side never receives aliasing `&mut` slices. Writes through the copy are not visible to JS.
+            class BorrowedSlices {{
+            public:
+              template <typename T>
+              rust::Slice<T> borrow(rust::Slice<T> slice) {{
+                if (slice.empty()) {{
+                  return slice;
+                }}
 
-                std::memcpy(vec.data(), data, size);
+                auto begin = reinterpret_cast<uintptr_t>(slice.data());
+                auto end = begin + slice.size() * sizeof(T);
+                for (const auto& [otherBegin, otherEnd] : ranges_) {{
+                  if (begin < otherEnd && otherBegin < end) {{
+                    std::shared_ptr<T[]> copy(new T[slice.size()]);
+                    std::copy(slice.begin(), slice.end(), copy.get());
+                    copies_.push_back(copy);
+                    return rust::Slice<T>(copy.get(), slice.size());
+                  }}
+                }}
 
-                return vec;
+                ranges_.emplace_back(begin, end);
+                return slice;
               }}
 
-              static jsi::Value toJs(jsi::Runtime& rt, const rust::Vec<uint8_t>& vec) {{
-                auto buffer = std::make_shared<{flat_name}::RustVecBuffer>(std::move(vec));
-                return jsi::ArrayBuffer(rt, buffer);
-              }}
+            private:
+              std::vector<std::pair<uintptr_t, uintptr_t>> ranges_;
+              std::vector<std::shared_ptr<void>> copies_;
             }};
 
+            // Copies the elements into a new `rust::Vec` with a single `memcpy` on the Rust side
+            // (`push_back` makes two FFI calls per element: `reserve_total` and `set_len`)
             template <typename T>
-            struct Bridging<rust::Vec<T>> {{
-              static rust::Vec<T> fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {{
-                auto arr = value.asObject(rt).asArray(rt);
-                size_t len = arr.length(rt);
-                rust::Vec<T> vec;
-                vec.reserve(len);
+            rust::Vec<T> vecFromSlice(rust::Slice<const T> slice) {{
+              if constexpr (std::is_same_v<T, double>) {{
+                return {cxx_ns}::bridging::vecFromF64Slice(slice);
+              }} else if constexpr (std::is_same_v<T, float>) {{
+                return {cxx_ns}::bridging::vecFromF32Slice(slice);
+              }} else if constexpr (std::is_same_v<T, int32_t>) {{
+                return {cxx_ns}::bridging::vecFromI32Slice(slice);
+              }} else if constexpr (std::is_same_v<T, int16_t>) {{
+                return {cxx_ns}::bridging::vecFromI16Slice(slice);
+              }} else {{
+                static_assert(std::is_same_v<T, uint8_t>, "Unsupported typed array element type");
+                return {cxx_ns}::bridging::vecFromU8Slice(slice);
+              }}
+            }}
 
-                for (size_t i = 0; i < len; i++) {{
-                  auto element = arr.getValueAtIndex(rt, i);
-                  vec.push_back(react::bridging::fromJs<T>(rt, element, callInvoker));
-                }}
+            template <typename T>
+            rust::Vec<T> typedArrayFromJs(jsi::Runtime& rt, const jsi::Value& value) {{
+              auto slice = typedArraySlice<T>(rt, value.asObject(rt));
+              return vecFromSlice<T>(rust::Slice<const T>(slice.data(), slice.size()));
+            }}
 
-                return vec;
+            // Creates a typed array (eg. `new Float64Array(buffer)`) backed by the `rust::Vec` without copying.
+            template <typename T>
+            jsi::Value typedArrayToJs(jsi::Runtime& rt, rust::Vec<T> vec, const char* name) {{
+              std::shared_ptr<jsi::MutableBuffer> buffer;
+              if constexpr (std::is_same_v<T, uint8_t>) {{
+                buffer = std::make_shared<::{flat_name}::RustVecBuffer>(std::move(vec));
+              }} else {{
+                buffer = std::make_shared<RustTypedVecBuffer<T>>(std::move(vec));
               }}
 
-              static jsi::Array toJs(jsi::Runtime& rt, const rust::Vec<T>& vec) {{
-                auto arr = jsi::Array(rt, vec.size());
+              auto arrayBuffer = jsi::ArrayBuffer(rt, buffer);
+              return rt.global().getPropertyAsFunction(rt, name).callAsConstructor(rt, arrayBuffer);
+            }}
 
-                for (size_t i = 0; i < vec.size(); i++) {{
-                  auto jsElement = react::bridging::toJs(rt, vec[i]);
-                  arr.setValueAtIndex(rt, i, jsElement);
+            // UTF-8 copy of a JS string in the thread's `ScratchArena`, borrowed as `rust::Str` within the call.
+            // Not movable: the copy is released when it goes out of scope, in reverse order of the allocations.
+            // Non-ASCII strings (or all strings before JSI 14) are transcoded by the engine (`utf8`).
+            class ScratchUtf8 {{
+            public:
+              ScratchUtf8(jsi::Runtime& rt, const jsi::String& str)
+                : arena_(ScratchArena::local()), mark_(arena_.mark()) {{
+            #if JSI_VERSION >= 14
+                bool ascii = true;
+                auto append = [&](bool isAscii, const void* chunk, size_t num) {{
+                  ascii = ascii && isAscii;
+                  if (ascii) {{
+                    data_ = size_ == 0 ? arena_.allocate(num) : arena_.grow(data_, size_, size_ + num);
+                    std::memcpy(data_ + size_, chunk, num);
+                    size_ += num;
+                  }}
+                }};
+                str.getStringData(rt, append);
+                if (ascii) {{
+                  return;
                 }}
+                arena_.release(mark_);
+            #endif
+                fallback_ = str.utf8(rt);
+                data_ = fallback_.data();
+                size_ = fallback_.size();
+              }}
 
-                return arr;
+              ~ScratchUtf8() {{
+                arena_.release(mark_);
               }}
-            }};
-            {bridging_templates}
-            }} // namespace react
-            }} // namespace facebook"#,
-            flat_name = flat_case(&ctx.project_name),
+
+              ScratchUtf8(const ScratchUtf8&) = delete;
+              ScratchUtf8& operator=(const ScratchUtf8&) = delete;
+
+              operator rust::Str() const {{
+                return rust::Str(data_, size_);
+              }}
+
+            private:
+              ScratchArena& arena_;
+              ScratchArena::Mark mark_;
+              char* data_ = nullptr;
+              size_t size_ = 0;
+              std::string fallback_;
+            }};
+
+            // UTF-8 copy of a JS string, borrowed as `rust::Str` for the lifetime of the buffer.
+            // Moved into the tasks of `Promise` methods, which outlive the call (`ScratchUtf8` is used otherwise).
+            // ASCII strings are copied straight from the engine's string storage where JSI exposes it (`getStringData`),
+            // the others are transcoded by the engine (`utf8`).
+            class Utf8Buffer {{
+            public:
+              Utf8Buffer(jsi::Runtime& rt, const jsi::String& str) {{
+            #if JSI_VERSION >= 14
+                bool ascii = true;
+                auto append = [&](bool isAscii, const void* data, size_t num) {{
+                  ascii = ascii && isAscii;
+                  if (ascii) {{
+                    data_.append(static_cast<const char*>(data), num);
+                  }}
+                }};
+                str.getStringData(rt, append);
+                if (ascii) {{
+                  return;
+                }}
+            #endif
+                data_ = str.utf8(rt);
+              }}
+
+              operator rust::Str() const {{
+                return rust::Str(data_.data(), data_.size());
+              }}
+
+            private:
+              std::string data_;
+            }};
+
+            // Converts a JS string into a `rust::String`.
+            // A string delivered in a single chunk by `getStringData` is copied (or transcoded from UTF-16)
+            // straight into the Rust allocation, without an intermediate `std::string`.
+            inline rust::String stringFromJs(jsi::Runtime& rt, const jsi::String& str) {{
+            #if JSI_VERSION >= 14
+              std::optional<rust::String> ret;
+              bool chunked = false;
+              auto convert = [&](bool ascii, const void* data, size_t num) {{
+                if (ret || chunked) {{
+                  chunked = true;
+                  return;
+                }}
+                ret = ascii ? rust::String(static_cast<const char*>(data), num)
+                            : rust::String::lossy(static_cast<const char16_t*>(data), num);
+              }};
+              str.getStringData(rt, convert);
+              if (!chunked) {{
+                return ret ? std::move(*ret) : rust::String();
+              }}
+            #endif
+              auto utf8 = str.utf8(rt);
+              return rust::String(utf8.data(), utf8.size());
+            }}
+
+            // JSI values reused across the calls of a module instance (eg. the `jsi::PropNameID` tables of the struct fields).
+            //
+            // The cache is owned by the module and bound to the runtime it is installed into, on the thread of that runtime.
+            // Conversions find the cache of their runtime among the caches bound on the current thread, so lookups don't lock,
+            // and the values are released with the module (`invalidate()`) instead of outliving the runtime.
+            // Without a bound cache (eg. after `invalidate()`), the values are created for each conversion.
+            class RuntimeCache {{
+            public:
+              using Table = std::vector<jsi::PropNameID>;
+
+              // Binds the cache to `rt`, called on the thread of the runtime
+              static void bind(jsi::Runtime& rt, const std::shared_ptr<RuntimeCache>& cache) {{
+                auto& caches = boundCaches();
+                caches.erase(
+                  std::remove_if(caches.begin(), caches.end(), [](const auto& entry) {{ return entry.second.expired(); }}),
+                  caches.end());
+                caches.emplace_back(&rt, cache);
+              }}
+
+              // Cache bound to `rt` on the current thread (`nullptr` if none)
+              static std::shared_ptr<RuntimeCache> find(jsi::Runtime& rt) {{
+                for (const auto& [runtime, cache] : boundCaches()) {{
+                  if (runtime != &rt) {{
+                    continue;
+                  }}
+                  if (auto locked = cache.lock()) {{
+                    return locked;
+                  }}
+                }}
+                return nullptr;
+              }}
+
+              template <typename T>
+              static std::shared_ptr<const Table> propNames(jsi::Runtime& rt, std::initializer_list<const char*> names) {{
+                auto cache = find(rt);
+                if (cache) {{
+                  auto it = cache->tables_.find(std::type_index(typeid(T)));
+                  if (it != cache->tables_.end()) {{
+                    return it->second;
+                  }}
+                }}
+
+                auto table = std::make_shared<Table>();
+                table->reserve(names.size());
+                for (auto name : names) {{
+                  table->push_back(jsi::PropNameID::forUtf8(rt, name));
+                }}
+
+                if (cache) {{
+                  cache->tables_.emplace(std::type_index(typeid(T)), table);
+                }}
+                return table;
+              }}
+
+              // Function evaluated from the JS `source`, once per cache (`name` identifies it)
+              static std::shared_ptr<jsi::Function> function(jsi::Runtime& rt, std::string_view name, const char* source) {{
+                auto cache = find(rt);
+                if (cache) {{
+                  auto it = cache->functions_.find(name);
+                  if (it != cache->functions_.end()) {{
+                    return it->second;
+                  }}
+                }}
+
+                auto fn = std::make_shared<jsi::Function>(
+                  rt.evaluateJavaScript(std::make_shared<jsi::StringBuffer>(source), std::string(name))
+                    .asObject(rt)
+                    .asFunction(rt));
+
+                if (cache) {{
+                  cache->functions_.emplace(name, fn);
+                }}
+                return fn;
+              }}
+
+            private:
+              using BoundCaches = std::vector<std::pair<jsi::Runtime*, std::weak_ptr<RuntimeCache>>>;
+
+              static BoundCaches& boundCaches() {{
+                thread_local BoundCaches caches;
+                return caches;
+              }}
+
+              std::unordered_map<std::type_index, std::shared_ptr<const Table>> tables_;
+              std::unordered_map<std::string_view, std::shared_ptr<jsi::Function>> functions_;
+            }};
+
+            // Host object of a `@lazy` struct.
+            // Keeps the C++ value and converts a field (`Bridging<T>::getField`) only when it is read,
+            // so large results are not materialized as JS objects up front.
+            // The field is found by its name (`Bridging<T>::fieldIndex`) instead of comparing it with every field name.
+            template <typename T>
+            class StructHostObject : public jsi::HostObject {{
+            public:
+              explicit StructHostObject(T value)
+                : value_(std::make_shared<const T>(std::move(value))) {{}}
+
+              jsi::Value get(jsi::Runtime& rt, const jsi::PropNameID& name) override {{
+                auto index = react::Bridging<T>::fieldIndex(name.utf8(rt));
+                if (!index.has_value()) {{
+                  return jsi::Value::undefined();
+                }}
+
+                return react::Bridging<T>::getField(rt, *value_, *index);
+              }}
+
+              std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override {{
+                auto props = react::Bridging<T>::fieldNames(rt);
+                std::vector<jsi::PropNameID> names;
+                names.reserve(props->size());
+                for (const auto& prop : *props) {{
+                  names.emplace_back(rt, prop);
+                }}
+
+                return names;
+              }}
+
+              const T& value() const {{
+                return *value_;
+              }}
+
+            private:
+              std::shared_ptr<const T> value_;
+            }};
+
+            // Host object of a `LazyArray<T>` result.
+            // Keeps the `rust::Vec<T>` and converts an element only when its index is read.
+            template <typename T>
+            class LazyArrayHostObject : public jsi::HostObject {{
+            public:
+              explicit LazyArrayHostObject(rust::Vec<T> vec)
+                : vec_(std::move(vec)) {{}}
+
+              jsi::Value get(jsi::Runtime& rt, const jsi::PropNameID& name) override {{
+                auto prop = name.utf8(rt);
+                if (prop == "length") {{
+                  return jsi::Value(static_cast<double>(vec_.size()));
+                }}
+
+                auto index = toIndex(prop);
+                if (!index.has_value()) {{
+                  return jsi::Value::undefined();
+                }}
+
+                // Converted from a reference to the element, eg. a `rust::String` is read in place by `jsi::String::createFromUtf8`
+                return react::bridging::toJs(rt, vec_[*index]);
+              }}
+
+              std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override {{
+                std::vector<jsi::PropNameID> names;
+                names.reserve(vec_.size() + 1);
+                names.emplace_back(jsi::PropNameID::forAscii(rt, "length"));
+                for (size_t i = 0; i < vec_.size(); i++) {{
+                  names.emplace_back(jsi::PropNameID::forAscii(rt, std::to_string(i)));
+                }}
+
+                return names;
+              }}
+
+            private:
+              rust::Vec<T> vec_;
+
+              // Canonical array index (`"0"`, `"1"`, ..., no leading zeros) within bounds
+              std::optional<size_t> toIndex(const std::string& prop) const {{
+                if (prop.empty() || (prop.size() > 1 && prop[0] == '0')) {{
+                  return std::nullopt;
+                }}
+
+                size_t index = 0;
+                for (char c : prop) {{
+                  if (c < '0' || c > '9') {{
+                    return std::nullopt;
+                  }}
+                  index = index * 10 + (c - '0');
+                  if (index >= vec_.size()) {{
+                    return std::nullopt;
+                  }}
+                }}
+
+                return index;
+              }}
+            }};
+
+            template <typename T>
+            jsi::Value lazyArrayToJs(jsi::Runtime& rt, rust::Vec<T> vec) {{
+              auto hostObject = std::make_shared<LazyArrayHostObject<T>>(std::move(vec));
+              return jsi::Object::createFromHostObject(rt, std::move(hostObject));
+            }}
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby
+
+            namespace facebook {{
+            namespace react {{
+
+            template <>
+            struct Bridging<std::monostate> {{
+              static std::monostate fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {{
+                return std::monostate{{}};
+              }}
+
+              static jsi::Value toJs(jsi::Runtime& rt, const std::monostate& value) {{
+                return jsi::Value::undefined();
+              }}
+            }};
+
+            // `rust::Str` arguments are borrowed from a scoped `Utf8Buffer` by the method wrappers,
+            // so there is no `fromJs` that would return a `rust::Str` to a destroyed buffer.
+            template <>
+            struct Bridging<rust::Str> {{
+              static jsi::Value toJs(jsi::Runtime& rt, const rust::Str& value) {{
+                return jsi::String::createFromUtf8(rt, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+              }}
+            }};
+
+            template <>
+            struct Bridging<rust::String> {{
+              static rust::String fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {{
+                return {cxx_ns}::utils::stringFromJs(rt, value.asString(rt));
+              }}
+
+              // Creates the JS string from the UTF-8 bytes without an intermediate `std::string` copy
+              static jsi::Value toJs(jsi::Runtime& rt, const rust::String& value) {{
+                return jsi::String::createFromUtf8(rt, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+              }}
+            }};
+
+            template <>
+            struct Bridging<rust::Vec<uint8_t>> {{
+              static rust::Vec<uint8_t> fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {{
+                auto arrayBuffer = value.asObject(rt).getArrayBuffer(rt);
+                uint8_t* data = arrayBuffer.data(rt);
+                size_t size = arrayBuffer.size(rt);
+                rust::Vec<uint8_t> vec;
+                vec.reserve(size);
+
+                for (size_t i = 0; i < size; i++) {{
+                  vec.push_back(data[i]);
+                }}
+
+                return vec;
+              }}
+
+              static jsi::Value toJs(jsi::Runtime& rt, rust::Vec<uint8_t> vec) {{
+                auto buffer = std::make_shared<{flat_name}::RustVecBuffer>(std::move(vec));
+                return jsi::ArrayBuffer(rt, buffer);
+              }}
+            }};
+
+            template <typename T>
+            struct Bridging<rust::Vec<T>> {{
+              static rust::Vec<T> fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {{
+                auto arr = value.asObject(rt).asArray(rt);
+                size_t len = arr.length(rt);
+                rust::Vec<T> vec;
+                vec.reserve(len);
+
+                for (size_t i = 0; i < len; i++) {{
+                  auto element = arr.getValueAtIndex(rt, i);
+                  vec.push_back(react::bridging::fromJs<T>(rt, element, callInvoker));
+                }}
+
+                return vec;
+              }}
+
+              // Takes the `rust::Vec` by value so owned elements (strings, structs) are moved instead of copied
+              static jsi::Array toJs(jsi::Runtime& rt, rust::Vec<T> vec) {{
+                auto arr = jsi::Array(rt, vec.size());
+
+                for (size_t i = 0; i < vec.size(); i++) {{
+                  auto jsElement = react::bridging::toJs(rt, std::move(vec[i]));
+                  arr.setValueAtIndex(rt, i, jsElement);
+                }}
+
+                return arr;
+              }}
+            }};
+
+            // Large `Array<Number>` values are converted through a `Float64Array` in a single JSI call
+            // instead of one `getValueAtIndex`/`setValueAtIndex` call per element, then copied into the
+            // `rust::Vec` at once. JSI has no bulk read of array elements, so below `kBulkThreshold` the
+            // per-element calls are cheaper than the call into the engine (see `bench/main.cpp`).
+            // Both paths reject an element that is not a number, instead of coercing it.
+            template <>
+            struct Bridging<rust::Vec<double>> {{
+              static constexpr size_t kBulkThreshold = 64;
+              static constexpr const char* kNotNumber = "Expected an array of numbers";
+              // Copies the elements into a `Float64Array`, `null` if an element is not a number
+              static constexpr const char* kToFloat64Array =
+                "(function (arr) {{"
+                "  var len = arr.length;"
+                "  var out = new Float64Array(len);"
+                "  for (var i = 0; i < len; i++) {{"
+                "    var value = arr[i];"
+                "    if (typeof value !== 'number') return null;"
+                "    out[i] = value;"
+                "  }}"
+                "  return out;"
+                "}})";
+
+              static rust::Vec<double> fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {{
+                auto arr = value.asObject(rt).asArray(rt);
+                return arr.length(rt) < kBulkThreshold ? fromJsEach(rt, arr) : fromJsBulk(rt, arr);
+              }}
+
+              // One `getValueAtIndex` call per element
+              static rust::Vec<double> fromJsEach(jsi::Runtime& rt, const jsi::Array& arr) {{
+                size_t len = arr.length(rt);
+                rust::Vec<double> vec;
+                vec.reserve(len);
+
+                for (size_t i = 0; i < len; i++) {{
+                  auto element = arr.getValueAtIndex(rt, i);
+                  if (!element.isNumber()) {{
+                    throw jsi::JSError(rt, kNotNumber);
+                  }}
+                  vec.push_back(element.getNumber());
+                }}
+
+                return vec;
+              }}
+
+              // One call into the engine, then a single copy of the `Float64Array` elements
+              static rust::Vec<double> fromJsBulk(jsi::Runtime& rt, const jsi::Array& arr) {{
+                auto toFloat64Array = {cxx_ns}::utils::RuntimeCache::function(rt, "toFloat64Array", kToFloat64Array);
+                auto typedArray = toFloat64Array->call(rt, arr);
+                if (!typedArray.isObject()) {{
+                  throw jsi::JSError(rt, kNotNumber);
+                }}
+
+                return {cxx_ns}::utils::typedArrayFromJs<double>(rt, typedArray);
+              }}
+
+              static jsi::Array toJs(jsi::Runtime& rt, rust::Vec<double> vec) {{
+                if (vec.size() < kBulkThreshold) {{
+                  auto arr = jsi::Array(rt, vec.size());
+
+                  for (size_t i = 0; i < vec.size(); i++) {{
+                    arr.setValueAtIndex(rt, i, jsi::Value(vec[i]));
+                  }}
+
+                  return arr;
+                }}
+
+                // `Array.from(new Float64Array(buffer))`
+                auto typedArray = {cxx_ns}::utils::typedArrayToJs(rt, std::move(vec), "Float64Array");
+                auto array = rt.global().getPropertyAsObject(rt, "Array");
+
+                return array.getPropertyAsFunction(rt, "from")
+                  .callWithThis(rt, array, typedArray)
+                  .asObject(rt)
+                  .asArray(rt);
+              }}
+            }};
+            {bridging_templates}
+            }} // namespace react
+            }} // namespace facebook{extra_utils}"#,
+            flat_name = flat_case(&ctx.project_name),
+            cxx_ns = CxxNamespace::from(&ctx.project_name),
             bridging_templates = if bridging_templates.is_empty() { "".to_string() } else { format!("\n{}\n", bridging_templates.join("\n\n")) },
+            extra_utils = extra_utils.iter().map(|utils| format!("\n\n{utils}")).collect::<String>(),
         };
 
-        Ok(cxx_bridging)
+        Ok(cxx_bridging)
+    }
+
+    /// Generates the JS end of `ByteStream` results (after the `Bridging<T>` specializations it resolves promises with).
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace utils {
+    ///
+    /// class StreamReadOp : public streams::StreamOp { /* ... */ };
+    /// class StreamWriteOp : public streams::StreamOp { /* ... */ };
+    /// class ByteStreamHostObject : public jsi::HostObject { /* ... */ };
+    ///
+    /// inline jsi::Value byteStreamToJs(jsi::Runtime& rt,
+    ///                                  rust::Box<craby::mymodule::bridging::ByteStream> stream,
+    ///                                  const std::shared_ptr<react::CallInvoker>& callInvoker);
+    ///
+    /// } // namespace utils
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_stream_utils(&self, project_name: &str) -> String {
+        formatdoc! {
+            r#"
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
+
+            using ByteStreamRef = std::shared_ptr<rust::Box<{cxx_ns}::bridging::ByteStream>>;
+
+            // Pending `read(size)`, resolves with up to `size` bytes (an empty `ArrayBuffer` at the end of the stream)
+            class StreamReadOp : public {cxx_ns}::streams::StreamOp {{
+            public:
+              StreamReadOp(ByteStreamRef stream, size_t size, react::AsyncPromise<rust::Vec<uint8_t>> promise)
+                : stream_(std::move(stream)), size_(size), promise_(std::move(promise)) {{}}
+
+              void complete() noexcept override {{
+                try {{
+                  promise_.resolve({cxx_ns}::bridging::streamTake(**stream_, size_));
+                }} catch (const std::exception& err) {{
+                  promise_.reject(err.what());
+                }}
+              }}
+
+            private:
+              ByteStreamRef stream_;
+              size_t size_;
+              react::AsyncPromise<rust::Vec<uint8_t>> promise_;
+            }};
+
+            // Pending `write(chunk)`, resolves once the chunk is queued
+            class StreamWriteOp : public {cxx_ns}::streams::StreamOp {{
+            public:
+              StreamWriteOp(ByteStreamRef stream, react::AsyncPromise<std::monostate> promise)
+                : stream_(std::move(stream)), promise_(std::move(promise)) {{}}
+
+              void complete() noexcept override {{
+                try {{
+                  {cxx_ns}::bridging::streamFinishWrite(**stream_);
+                  promise_.resolve(std::monostate{{}});
+                }} catch (const std::exception& err) {{
+                  promise_.reject(err.what());
+                }}
+              }}
+
+            private:
+              ByteStreamRef stream_;
+              react::AsyncPromise<std::monostate> promise_;
+            }};
+
+            // Host object of a `ByteStream` result (`read(size)`, `write(chunk)` and `close()`).
+            // Pending operations keep the stream alive, it is closed when the last reference is released.
+            class ByteStreamHostObject : public jsi::HostObject {{
+            public:
+              ByteStreamHostObject(rust::Box<{cxx_ns}::bridging::ByteStream> stream, std::shared_ptr<react::CallInvoker> callInvoker)
+                : stream_(std::make_shared<rust::Box<{cxx_ns}::bridging::ByteStream>>(std::move(stream))),
+                  callInvoker_(std::move(callInvoker)) {{}}
+
+              jsi::Value get(jsi::Runtime& rt, const jsi::PropNameID& name) override {{
+                auto prop = name.utf8(rt);
+                if (prop == "read") {{
+                  return jsi::Function::createFromHostFunction(rt, name, 1, [stream = stream_, callInvoker = callInvoker_](
+                    jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {{
+                    if (count != 1 || !args[0].isNumber() || args[0].asNumber() < 1) {{
+                      throw jsi::JSError(rt, "Expected a positive size");
+                    }}
+
+                    react::AsyncPromise<rust::Vec<uint8_t>> promise(rt, callInvoker);
+                    auto op = new StreamReadOp(stream, static_cast<size_t>(args[0].asNumber()), promise);
+                    try {{
+                      // Not ready: the Rust side owns `op` and completes it, possibly right away on another thread
+                      if ({cxx_ns}::bridging::streamPollRead(**stream, reinterpret_cast<size_t>(op))) {{
+                        op->complete();
+                        delete op;
+                      }}
+                    }} catch (const std::exception& err) {{
+                      delete op;
+                      promise.reject(err.what());
+                    }}
+
+                    return react::bridging::toJs(rt, promise);
+                  }});
+                }}
+
+                if (prop == "write") {{
+                  return jsi::Function::createFromHostFunction(rt, name, 1, [stream = stream_, callInvoker = callInvoker_](
+                    jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {{
+                    if (count != 1 || !args[0].isObject() || !args[0].asObject(rt).isArrayBuffer(rt)) {{
+                      throw jsi::JSError(rt, "Expected an ArrayBuffer");
+                    }}
+
+                    // Copied into a pooled buffer before `write` returns
+                    auto buffer = args[0].asObject(rt).getArrayBuffer(rt);
+                    rust::Slice<const uint8_t> chunk(buffer.data(rt), buffer.size(rt));
+
+                    react::AsyncPromise<std::monostate> promise(rt, callInvoker);
+                    auto op = new StreamWriteOp(stream, promise);
+                    try {{
+                      if ({cxx_ns}::bridging::streamWrite(**stream, chunk, reinterpret_cast<size_t>(op))) {{
+                        op->complete();
+                        delete op;
+                      }}
+                    }} catch (const std::exception& err) {{
+                      delete op;
+                      promise.reject(err.what());
+                    }}
+
+                    return react::bridging::toJs(rt, promise);
+                  }});
+                }}
+
+                if (prop == "close") {{
+                  return jsi::Function::createFromHostFunction(rt, name, 0, [stream = stream_](
+                    jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {{
+                    {cxx_ns}::bridging::streamClose(**stream);
+                    return jsi::Value::undefined();
+                  }});
+                }}
+
+                return jsi::Value::undefined();
+              }}
+
+              std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override {{
+                std::vector<jsi::PropNameID> names;
+                names.emplace_back(jsi::PropNameID::forAscii(rt, "read"));
+                names.emplace_back(jsi::PropNameID::forAscii(rt, "write"));
+                names.emplace_back(jsi::PropNameID::forAscii(rt, "close"));
+
+                return names;
+              }}
+
+            private:
+              ByteStreamRef stream_;
+              std::shared_ptr<react::CallInvoker> callInvoker_;
+            }};
+
+            inline jsi::Value byteStreamToJs(jsi::Runtime& rt,
+                                             rust::Box<{cxx_ns}::bridging::ByteStream> stream,
+                                             const std::shared_ptr<react::CallInvoker>& callInvoker) {{
+              auto hostObject = std::make_shared<ByteStreamHostObject>(std::move(stream), callInvoker);
+              return jsi::Object::createFromHostObject(rt, std::move(hostObject));
+            }}
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+            cxx_ns = CxxNamespace::from(project_name),
+        }
+    }
+
+    /// Generates the `PromiseOp` of the `@executor async` methods.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace utils {
+    ///
+    /// template <typename T, typename R>
+    /// class PromiseOp : public futures::FutureOp { /* ... */ };
+    ///
+    /// template <typename T, typename R>
+    /// PromiseOp<T, R>* promiseOp(react::AsyncPromise<T> promise, R (*take)(size_t));
+    ///
+    /// } // namespace utils
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_future_utils(&self, project_name: &str) -> String {
+        formatdoc! {
+            r#"
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
+
+            // Resolves the promise of an `@executor async` method with the result taken by `take` (its `{{method}}Result` FFI function)
+            template <typename T, typename R>
+            class PromiseOp : public {cxx_ns}::futures::FutureOp {{
+            public:
+              PromiseOp(react::AsyncPromise<T> promise, R (*take)(size_t)) : promise_(std::move(promise)), take_(take) {{}}
+
+              void complete(size_t ret) noexcept override {{
+                try {{
+                  if constexpr (std::is_void_v<R>) {{
+                    take_(ret);
+                    promise_.resolve(std::monostate{{}});
+                  }} else {{
+                    promise_.resolve(take_(ret));
+                  }}
+                }} catch (const std::exception& err) {{
+                  promise_.reject(err.what());
+                }}
+              }}
+
+            private:
+              react::AsyncPromise<T> promise_;
+              R (*take_)(size_t);
+            }};
+
+            template <typename T, typename R>
+            PromiseOp<T, R>* promiseOp(react::AsyncPromise<T> promise, R (*take)(size_t)) {{
+              return new PromiseOp<T, R>(std::move(promise), take);
+            }}
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+            cxx_ns = CxxNamespace::from(project_name),
+        }
+    }
+
+    /// Generates the `AbortToken` of the `AbortSignal` parameters.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace utils {
+    ///
+    /// class AbortToken { /* ... */ };
+    ///
+    /// } // namespace utils
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_abort_utils(&self, project_name: &str) -> String {
+        formatdoc! {
+            r#"
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
+
+            // Cancellation token of an `AbortSignal` parameter, shared by the task and the `abort` listener.
+            // Converts to the `AbortSignal` of the Rust side when passed to the FFI function.
+            class AbortToken {{
+            public:
+              AbortToken()
+                : signal_(std::make_shared<rust::Box<{cxx_ns}::bridging::AbortSignal>>({cxx_ns}::bridging::createAbortSignal())) {{}}
+
+              // Aborts the token and rejects the promise once the JS `AbortSignal` is aborted (`null` and `undefined` are never aborted).
+              template <typename T>
+              void bind(jsi::Runtime& rt, const jsi::Value& value, react::AsyncPromise<T> promise) {{
+                if (value.isUndefined() || value.isNull()) {{
+                  return;
+                }}
+
+                auto signal = value.asObject(rt);
+                if (signal.getProperty(rt, "aborted").asBool()) {{
+                  abort(promise);
+                  return;
+                }}
+
+                auto signalRef = std::make_shared<jsi::Object>(std::move(signal));
+                auto listener = std::make_shared<jsi::Function>(jsi::Function::createFromHostFunction(
+                  rt, jsi::PropNameID::forAscii(rt, "onabort"), 0,
+                  [token = *this, promise](jsi::Runtime&, const jsi::Value&, const jsi::Value*, size_t) mutable -> jsi::Value {{
+                    token.abort(promise);
+                    return jsi::Value::undefined();
+                  }}));
+                auto addEventListener = signalRef->getPropertyAsFunction(rt, "addEventListener");
+                addEventListener.callWithThis(rt, *signalRef, jsi::String::createFromAscii(rt, "abort"), *listener);
+
+                // Remove the listener once the promise settles, it would otherwise live (with the promise) as long as the signal
+                auto unbind = jsi::Function::createFromHostFunction(
+                  rt, jsi::PropNameID::forAscii(rt, "unbind"), 0,
+                  [signalRef, listener](jsi::Runtime& rt, const jsi::Value&, const jsi::Value*, size_t) -> jsi::Value {{
+                    auto removeEventListener = signalRef->getPropertyAsFunction(rt, "removeEventListener");
+                    removeEventListener.callWithThis(rt, *signalRef, jsi::String::createFromAscii(rt, "abort"), *listener);
+                    return jsi::Value::undefined();
+                  }});
+                auto jsPromise = promise.get(rt);
+                jsPromise.getPropertyAsFunction(rt, "then").callWithThis(rt, jsPromise, unbind, unbind);
+              }}
+
+              bool aborted() const {{
+                return {cxx_ns}::bridging::abortSignalAborted(**signal_);
+              }}
+
+              operator const {cxx_ns}::bridging::AbortSignal &() const {{
+                return **signal_;
+              }}
+
+            private:
+              template <typename T>
+              void abort(react::AsyncPromise<T>& promise) {{
+                {cxx_ns}::bridging::abortSignalAbort(**signal_);
+                promise.reject("This operation was aborted");
+              }}
+
+              std::shared_ptr<rust::Box<{cxx_ns}::bridging::AbortSignal>> signal_;
+            }};
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+            cxx_ns = CxxNamespace::from(project_name),
+        }
+    }
+
+    /// Generates the `sharedStateToJs` of the `SharedState<T>` results.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace utils {
+    ///
+    /// class SharedMemoryBuffer : public jsi::MutableBuffer { /* ... */ };
+    ///
+    /// inline jsi::Value sharedStateToJs(jsi::Runtime& rt,
+    ///                                   rust::Box<craby::mymodule::bridging::SharedMemory> memory,
+    ///                                   std::initializer_list<const char*> fields);
+    ///
+    /// } // namespace utils
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_shared_state_utils(&self, project_name: &str) -> String {
+        formatdoc! {
+            r#"
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
+
+            // Memory of a `SharedState`, written by the Rust side (the buffer holds a reference, not a copy)
+            class SharedMemoryBuffer : public jsi::MutableBuffer {{
+            public:
+              explicit SharedMemoryBuffer(rust::Box<{cxx_ns}::bridging::SharedMemory> memory)
+                : memory_(std::move(memory)) {{}}
+
+              size_t size() const override {{
+                return {cxx_ns}::bridging::sharedMemorySize(*memory_);
+              }}
+
+              uint8_t* data() override {{
+                return reinterpret_cast<uint8_t*>({cxx_ns}::bridging::sharedMemoryData(*memory_));
+              }}
+
+            private:
+              rust::Box<{cxx_ns}::bridging::SharedMemory> memory_;
+            }};
+
+            // `{{ sequence, values, fields }}`: separate views of the `[sequence, ...fields]` memory (see `readSharedState` of `craby-modules`)
+            inline jsi::Value sharedStateToJs(jsi::Runtime& rt,
+                                              rust::Box<{cxx_ns}::bridging::SharedMemory> memory,
+                                              std::initializer_list<const char*> fields) {{
+              auto buffer = std::make_shared<SharedMemoryBuffer>(std::move(memory));
+              auto arrayBuffer = jsi::ArrayBuffer(rt, buffer);
+              auto global = rt.global();
+              // Low half of the `u64` sequence (the supported targets are little-endian), enough to detect a write
+              auto sequence = global.getPropertyAsFunction(rt, "Int32Array").callAsConstructor(rt, arrayBuffer, 0, 1);
+              auto values = global.getPropertyAsFunction(rt, "Float64Array")
+                              .callAsConstructor(rt, arrayBuffer, static_cast<int>(sizeof(uint64_t)));
+
+              auto names = jsi::Array(rt, fields.size());
+              size_t index = 0;
+              for (auto field : fields) {{
+                names.setValueAtIndex(rt, index++, jsi::String::createFromAscii(rt, field));
+              }}
+
+              auto state = jsi::Object(rt);
+              state.setProperty(rt, "sequence", std::move(sequence));
+              state.setProperty(rt, "values", std::move(values));
+              state.setProperty(rt, "fields", std::move(names));
+
+              return state;
+            }}
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+            cxx_ns = CxxNamespace::from(project_name),
+        }
+    }
+
+    /// Generates the `mappedFileToJs` of the `MappedFile` results.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace utils {
+    ///
+    /// class MappedFileBuffer : public jsi::MutableBuffer { /* ... */ };
+    ///
+    /// inline jsi::Value mappedFileToJs(jsi::Runtime& rt, rust::Box<craby::mymodule::bridging::MappedFile> file);
+    ///
+    /// } // namespace utils
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_mapped_file_utils(&self, project_name: &str) -> String {
+        formatdoc! {
+            r#"
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
+
+            // Copy-on-write pages of a memory-mapped file (JS writes never reach the file), unmapped by the Rust side when the
+            // buffer is released (no copy)
+            class MappedFileBuffer : public jsi::MutableBuffer {{
+            public:
+              explicit MappedFileBuffer(rust::Box<{cxx_ns}::bridging::MappedFile> file)
+                : file_(std::move(file)) {{}}
+
+              size_t size() const override {{
+                return {cxx_ns}::bridging::mappedFileSize(*file_);
+              }}
+
+              uint8_t* data() override {{
+                return reinterpret_cast<uint8_t*>({cxx_ns}::bridging::mappedFileData(*file_));
+              }}
+
+            private:
+              rust::Box<{cxx_ns}::bridging::MappedFile> file_;
+            }};
+
+            inline jsi::Value mappedFileToJs(jsi::Runtime& rt, rust::Box<{cxx_ns}::bridging::MappedFile> file) {{
+              auto buffer = std::make_shared<MappedFileBuffer>(std::move(file));
+              return jsi::ArrayBuffer(rt, buffer);
+            }}
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+            cxx_ns = CxxNamespace::from(project_name),
+        }
+    }
+
+    /// Generates the header for installing the modules into a secondary runtime.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// #pragma once
+    ///
+    /// #include "CxxMyTestModule.hpp"
+    /// #include <ReactCommon/CallInvoker.h>
+    /// #include <jsi/jsi.h>
+    /// #include <memory>
+    ///
+    /// namespace craby {
+    /// namespace myproject {
+    ///
+    /// inline facebook::jsi::Object createModuleObject(facebook::jsi::Runtime &rt,
+    ///                                                 std::shared_ptr<facebook::jsi::HostObject> module);
+    ///
+    /// inline void installModules(facebook::jsi::Runtime &rt, std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
+    ///   auto installed = facebook::jsi::Object(rt);
+    ///   installed.setProperty(
+    ///     rt,
+    ///     modules::CxxMyTestModule::kModuleName,
+    ///     createModuleObject(rt, std::make_shared<modules::CxxMyTestModule>(jsInvoker)));
+    ///   rt.global().setProperty(rt, "__crabyModules", std::move(installed));
+    /// }
+    ///
+    /// } // namespace myproject
+    /// } // namespace craby
+    /// ```
+    fn cxx_runtime(&self, ctx: &CodegenContext) -> String {
+        let flat_name = flat_case(&ctx.project_name);
+        let (includes, installs): (Vec<_>, Vec<_>) = ctx
+            .schemas
+            .iter()
+            .map(|schema| {
+                let cxx_mod = CxxModuleName::from(&schema.module_name);
+                let include = format!("#include \"{cxx_mod}.hpp\"");
+                let install = formatdoc! {
+                    r#"
+                    installed.setProperty(
+                      rt,
+                      modules::{cxx_mod}::kModuleName,
+                      createModuleObject(rt, std::make_shared<modules::{cxx_mod}>(jsInvoker)));"#,
+                };
+                (include, install)
+            })
+            .unzip();
+
+        formatdoc! {
+            r#"
+            #pragma once
+
+            {includes}
+            #include <ReactCommon/CallInvoker.h>
+            #include <jsi/jsi.h>
+            #include <memory>
+
+            namespace craby {{
+            namespace {flat_name} {{
+
+            // Object of a module installed by `installModules()`, shaped like the ones of `TurboModuleBinding`: a plain
+            // object with the host object as prototype. The methods are created once and set on the object, so calls
+            // don't go through `HostObject::get` (a new `jsi::Function` per lookup).
+            inline facebook::jsi::Object createModuleObject(facebook::jsi::Runtime &rt,
+                                                            std::shared_ptr<facebook::jsi::HostObject> module) {{
+              auto hostObject = facebook::jsi::Object::createFromHostObject(rt, module);
+              auto object = facebook::jsi::Object(rt);
+              for (auto &name : module->getPropertyNames(rt)) {{
+                object.setProperty(rt, name, hostObject.getProperty(rt, name));
+              }}
+              // Keeps the module alive as long as the object
+              object.setProperty(rt, "__proto__", std::move(hostObject));
+              return object;
+            }}
+
+            // Installs the modules into a secondary runtime (eg. a worklet or worker runtime on its own thread)
+            // as `global.__crabyModules[moduleName]`, so sync calls from that runtime don't block the main JS thread.
+            //
+            // - `jsInvoker` must run its callbacks on the thread of `rt`, signals and promises are delivered through it.
+            // - Each runtime gets its own instances of the modules, the Rust modules are not shared with the main runtime.
+            // - Install after the main runtime has loaded a module, the data path of the modules is resolved by then.
+            inline void installModules(facebook::jsi::Runtime &rt, std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {{
+              auto installed = facebook::jsi::Object(rt);
+            {installs}
+              rt.global().setProperty(rt, "__crabyModules", std::move(installed));
+            }}
+
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            includes = includes.join("\n"),
+            installs = indent_str(&installs.join("\n"), 2),
+        }
+    }
+
+    /// Generates the stats header (`[codegen] stats`).
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace stats {
+    ///
+    /// enum class Phase : size_t { FromJs, Rust, ToJs, Queue, Signal };
+    ///
+    /// // Per-thread histograms of the phases of each method
+    /// class Registry { /* ... */ };
+    ///
+    /// class Call { /* ... */ };
+    /// class AsyncCall { /* ... */ };
+    ///
+    /// inline jsi::Value toJs(jsi::Runtime &rt, const char *module);
+    ///
+    /// } // namespace stats
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_stats(&self, project_name: &str) -> String {
+        formatdoc! {
+            r#"
+            #pragma once
+
+            #include <jsi/jsi.h>
+            #include <algorithm>
+            #include <array>
+            #include <atomic>
+            #include <bit>
+            #include <chrono>
+            #include <cstdint>
+            #include <exception>
+            #include <memory>
+            #include <mutex>
+            #include <string>
+            #include <vector>
+
+            #if defined(__ANDROID__)
+            #include <android/trace.h>
+            #elif defined(__APPLE__)
+            #include <os/log.h>
+            #include <os/signpost.h>
+            #endif
+
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace stats {{
+
+            using Clock = std::chrono::steady_clock;
+
+            // Phases of a call, reported by `__crabyStats()`
+            enum class Phase : size_t {{
+              // Conversions of the arguments
+              FromJs,
+              // FFI call of the method
+              Rust,
+              // Conversion of the return value
+              ToJs,
+              // Wait of a `Promise` task for its thread
+              Queue,
+              // `emit` of a signal until its listeners are called on the JS thread
+              Signal,
+            }};
+
+            constexpr size_t kPhaseCount = 5;
+            // Bucket `i` counts the durations within `[2^i, 2^(i+1))` nanoseconds
+            constexpr size_t kBucketCount = 40;
+            constexpr uint32_t kMaxMethods = 1024;
+
+            // Method (or signal) registered by `method()`, not recorded once `kMaxMethods` are registered
+            struct MethodRef {{
+              uint32_t id;
+              const char *label;
+            }};
+
+            struct PhaseSummary {{
+              uint64_t count = 0;
+              uint64_t total = 0;
+              uint64_t max = 0;
+              std::array<uint64_t, kBucketCount> buckets{{}};
+
+              // Upper bound of the bucket of the percentile (eg. `0.99`), capped by the maximum
+              uint64_t percentile(double p) const noexcept {{
+                auto rank = static_cast<uint64_t>(p * static_cast<double>(count));
+                uint64_t seen = 0;
+                for (size_t i = 0; i < kBucketCount; i++) {{
+                  seen += buckets[i];
+                  if (seen > rank) {{
+                    return std::min<uint64_t>((uint64_t{{2}} << i) - 1, max);
+                  }}
+                }}
+                return max;
+              }}
+            }};
+
+            struct MethodSummary {{
+              std::string name;
+              uint64_t calls = 0;
+              uint64_t errors = 0;
+              std::array<PhaseSummary, kPhaseCount> phases{{}};
+            }};
+
+            // Counter written by a single thread and read from any thread.
+            // The owner is the only writer, so a relaxed load and store replace the read-modify-write.
+            class Counter {{
+            public:
+              void add(uint64_t n) noexcept {{
+                value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+              }}
+
+              void max(uint64_t n) noexcept {{
+                if (n > value_.load(std::memory_order_relaxed)) {{
+                  value_.store(n, std::memory_order_relaxed);
+                }}
+              }}
+
+              uint64_t load() const noexcept {{
+                return value_.load(std::memory_order_relaxed);
+              }}
+
+            private:
+              std::atomic<uint64_t> value_{{0}};
+            }};
+
+            // Durations of a phase recorded by one thread
+            class Histogram {{
+            public:
+              void record(uint64_t ns) noexcept {{
+                count_.add(1);
+                total_.add(ns);
+                max_.max(ns);
+                buckets_[std::min<size_t>(std::bit_width(ns | 1) - 1, kBucketCount - 1)].add(1);
+              }}
+
+              void mergeInto(PhaseSummary &summary) const noexcept {{
+                summary.count += count_.load();
+                summary.total += total_.load();
+                summary.max = std::max(summary.max, max_.load());
+                for (size_t i = 0; i < kBucketCount; i++) {{
+                  summary.buckets[i] += buckets_[i].load();
+                }}
+              }}
+
+            private:
+              Counter count_;
+              Counter total_;
+              Counter max_;
+              std::array<Counter, kBucketCount> buckets_;
+            }};
+
+            struct MethodHistograms {{
+              Counter calls;
+              Counter errors;
+              std::array<Histogram, kPhaseCount> phases;
+            }};
+
+            // Histograms of one thread, allocated on the first record of each method
+            class ThreadStats {{
+            public:
+              MethodHistograms &get(uint32_t id) {{
+                auto *histograms = methods_[id].load(std::memory_order_relaxed);
+                if (histograms == nullptr) {{
+                  histograms = new MethodHistograms();
+                  methods_[id].store(histograms, std::memory_order_release);
+                }}
+                return *histograms;
+              }}
+
+              const MethodHistograms *find(uint32_t id) const noexcept {{
+                return methods_[id].load(std::memory_order_acquire);
+              }}
+
+            private:
+              std::array<std::atomic<MethodHistograms *>, kMaxMethods> methods_{{}};
+            }};
+
+            // Registered methods and the histograms of every thread that recorded a call.
+            // Recording never locks: a thread only writes its own histograms, `snapshot()` sums them.
+            class Registry {{
+            public:
+              static Registry &getInstance() {{
+                // Never destroyed, tasks still running on the thread pool may record while the process exits
+                static auto *instance = new Registry();
+                return *instance;
+              }}
+
+              MethodRef add(const char *module, const char *name) {{
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (methods_.size() >= kMaxMethods) {{
+                  return MethodRef{{kMaxMethods, name}};
+                }}
+
+                auto id = static_cast<uint32_t>(methods_.size());
+                methods_.push_back(std::make_unique<Method>(Method{{module, name, std::string(module) + "." + name}}));
+                return MethodRef{{id, methods_.back()->label.c_str()}};
+              }}
+
+              ThreadStats &local() {{
+                thread_local ThreadStats *stats = nullptr;
+                if (stats == nullptr) {{
+                  std::lock_guard<std::mutex> lock(mutex_);
+                  threads_.push_back(std::make_unique<ThreadStats>());
+                  stats = threads_.back().get();
+                }}
+                return *stats;
+              }}
+
+              std::vector<MethodSummary> snapshot(const std::string &module) {{
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::vector<MethodSummary> summaries;
+                for (uint32_t id = 0; id < methods_.size(); id++) {{
+                  if (methods_[id]->module != module) {{
+                    continue;
+                  }}
+
+                  MethodSummary summary;
+                  summary.name = methods_[id]->name;
+                  for (auto &thread : threads_) {{
+                    if (auto *histograms = thread->find(id)) {{
+                      summary.calls += histograms->calls.load();
+                      summary.errors += histograms->errors.load();
+                      for (size_t i = 0; i < kPhaseCount; i++) {{
+                        histograms->phases[i].mergeInto(summary.phases[i]);
+                      }}
+                    }}
+                  }}
+                  summaries.push_back(std::move(summary));
+                }}
+                return summaries;
+              }}
+
+            private:
+              struct Method {{
+                std::string module;
+                std::string name;
+                std::string label;
+              }};
+
+              std::mutex mutex_;
+              std::vector<std::unique_ptr<Method>> methods_;
+              std::vector<std::unique_ptr<ThreadStats>> threads_;
+            }};
+
+            inline MethodRef method(const char *module, const char *name) {{
+              return Registry::getInstance().add(module, name);
+            }}
+
+            inline MethodHistograms *histograms(MethodRef method) noexcept {{
+              if (method.id >= kMaxMethods) {{
+                return nullptr;
+              }}
+              return &Registry::getInstance().local().get(method.id);
+            }}
+
+            inline void record(MethodRef method, Phase phase, Clock::time_point start, Clock::time_point end = Clock::now()) noexcept {{
+              if (auto *target = histograms(method)) {{
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                target->phases[static_cast<size_t>(phase)].record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+              }}
+            }}
+
+            // Trace section of a call on the calling thread (ATrace for Perfetto, os_signpost for Instruments).
+            // Nearly free while no trace is recorded.
+            class TraceSection {{
+            public:
+              explicit TraceSection(const char *label) noexcept {{
+            #if defined(__ANDROID__)
+                ATrace_beginSection(label);
+            #elif defined(__APPLE__)
+                id_ = os_signpost_id_generate(log());
+                os_signpost_interval_begin(log(), id_, "Call", "%{{public}}s", label);
+            #endif
+              }}
+
+              ~TraceSection() {{
+            #if defined(__ANDROID__)
+                ATrace_endSection();
+            #elif defined(__APPLE__)
+                os_signpost_interval_end(log(), id_, "Call");
+            #endif
+              }}
+
+              TraceSection(const TraceSection &) = delete;
+              TraceSection &operator=(const TraceSection &) = delete;
+
+            private:
+            #if defined(__APPLE__)
+              static os_log_t log() noexcept {{
+                static os_log_t log = os_log_create("rs.craby", "{flat_name}");
+                return log;
+              }}
+
+              os_signpost_id_t id_;
+            #endif
+            }};
+
+            // Phases of a `Promise` task, recorded on the thread that runs it (starting with the `Queue` wait)
+            class AsyncCall {{
+            public:
+              explicit AsyncCall(MethodRef method) noexcept : method_(method), last_(Clock::now()) {{}}
+
+              void mark(Phase phase) noexcept {{
+                auto now = Clock::now();
+                record(method_, phase, last_, now);
+                last_ = now;
+              }}
+
+            private:
+              MethodRef method_;
+              Clock::time_point last_;
+            }};
+
+            // Phases of a JSI call, recorded on the calling thread.
+            // `mark()` records the time since the previous mark, the rest is recorded as `ToJs` once the call returns
+            // (or as an error if it throws).
+            class Call {{
+            public:
+              explicit Call(MethodRef method) noexcept
+                : method_(method), trace_(method.label), exceptions_(std::uncaught_exceptions()), last_(Clock::now()) {{
+                if (auto *target = histograms(method_)) {{
+                  target->calls.add(1);
+                }}
+              }}
+
+              ~Call() {{
+                if (std::uncaught_exceptions() <= exceptions_) {{
+                  mark(Phase::ToJs);
+                }} else if (auto *target = histograms(method_)) {{
+                  target->errors.add(1);
+                }}
+              }}
+
+              Call(const Call &) = delete;
+              Call &operator=(const Call &) = delete;
+
+              void mark(Phase phase) noexcept {{
+                auto now = Clock::now();
+                record(method_, phase, last_, now);
+                last_ = now;
+              }}
+
+              AsyncCall async() const noexcept {{
+                return AsyncCall(method_);
+              }}
+
+            private:
+              MethodRef method_;
+              TraceSection trace_;
+              int exceptions_;
+              Clock::time_point last_;
+            }};
+
+            // `{{ [method]: {{ count, errors, fromJs, rust, toJs, queue, signal }} }}` of the module, durations in milliseconds
+            inline facebook::jsi::Value toJs(facebook::jsi::Runtime &rt, const char *module) {{
+              static constexpr std::array<const char *, kPhaseCount> kPhaseNames = {{"fromJs", "rust", "toJs", "queue", "signal"}};
+              auto ms = [](uint64_t ns) {{ return static_cast<double>(ns) / 1e6; }};
+
+              auto result = facebook::jsi::Object(rt);
+              for (auto &summary : Registry::getInstance().snapshot(module)) {{
+                auto signal = summary.phases[static_cast<size_t>(Phase::Signal)].count;
+                auto entry = facebook::jsi::Object(rt);
+                entry.setProperty(rt, "count", static_cast<double>(summary.calls + signal));
+                entry.setProperty(rt, "errors", static_cast<double>(summary.errors));
+
+                for (size_t i = 0; i < kPhaseCount; i++) {{
+                  auto &phase = summary.phases[i];
+                  if (phase.count == 0) {{
+                    continue;
+                  }}
+
+                  auto stats = facebook::jsi::Object(rt);
+                  stats.setProperty(rt, "count", static_cast<double>(phase.count));
+                  stats.setProperty(rt, "total", ms(phase.total));
+                  stats.setProperty(rt, "max", ms(phase.max));
+                  stats.setProperty(rt, "p50", ms(phase.percentile(0.5)));
+                  stats.setProperty(rt, "p90", ms(phase.percentile(0.9)));
+                  stats.setProperty(rt, "p99", ms(phase.percentile(0.99)));
+                  entry.setProperty(rt, kPhaseNames[i], std::move(stats));
+                }}
+
+                result.setProperty(rt, summary.name.c_str(), std::move(entry));
+              }}
+
+              return result;
+            }}
+
+            }} // namespace stats
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+        }
+    }
+
+    /// Generates C++ utils header file.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// #pragma once
+    ///
+    /// #include "cxx.h"
+    /// #include "ffi.rs.h"
+    /// #include <deque>
+    /// #include <mutex>
+    /// #include <thread>
+    ///
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace utils {
+    ///
+    /// // Move-only `void()` callable with inline storage
+    /// class Task { /* ... */ };
+    ///
+    /// // Settings of the `Executor` workers (`[executor]` of `craby.toml`)
+    /// struct WorkerOptions { /* ... */ };
+    ///
+    /// // Process-wide work-stealing executor shared by all modules
+    /// class Executor {
+    /// public:
+    ///   static Executor &getInstance();
+    ///   void submit(Job job);
+    ///   // ...
+    /// };
+    ///
+    /// // Per-thread bump allocator for the temporaries of a call
+    /// class ScratchArena { /* ... */ };
+    ///
+    /// // Per-module handle of the shared `Executor`, ordered by the execution policy
+    /// class ModuleExecutor : public std::enable_shared_from_this<ModuleExecutor> {
+    /// public:
+    ///   explicit ModuleExecutor(size_t maxConcurrency = 0);
+    ///   template <class F> void enqueue(F &&f);
+    ///   template <class F> void enqueueSerial(F &&f);
+    ///   std::unique_lock<std::shared_mutex> lock();
+    ///   std::shared_lock<std::shared_mutex> sharedLock();
+    ///   void shutdown();
+    ///   // ...
+    /// };
+    ///
+    /// inline std::string errorMessage(const std::exception &err) {
+    ///   const auto* rs_err = dynamic_cast<const rust::Error*>(&err);
+    ///   return std::string(rs_err ? rs_err->what() : err.what());
+    /// }
+    ///
+    /// } // namespace utils
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_utils(&self, ctx: &CodegenContext) -> Result<String, anyhow::Error> {
+        let flat_name = flat_case(&ctx.project_name);
+        let worker_threads = ctx.executor.threads.unwrap_or(0);
+        let worker_thread_name = &ctx.executor.thread_name;
+        let worker_priority = match ctx.executor.priority {
+            ThreadPriority::Default => "Default",
+            ThreadPriority::UserInitiated => "UserInitiated",
+            ThreadPriority::Utility => "Utility",
+            ThreadPriority::Background => "Background",
+        };
+        let worker_affinity = match ctx.executor.affinity {
+            CoreAffinity::Any => "Any",
+            CoreAffinity::Little => "Little",
+            CoreAffinity::Big => "Big",
+        };
+
+        Ok(formatdoc! {
+            r#"
+            #pragma once
+
+            #include "cxx.h"
+            #include "ffi.rs.h"
+            #include <algorithm>
+            #include <atomic>
+            #include <condition_variable>
+            #include <cstddef>
+            #include <cstdio>
+            #include <deque>
+            #include <memory>
+            #include <mutex>
+            #include <new>
+            #include <shared_mutex>
+            #include <thread>
+            #include <type_traits>
+            #include <utility>
+            #include <vector>
+
+            #if defined(__APPLE__)
+            #include <pthread.h>
+            #include <pthread/qos.h>
+            #elif defined(__ANDROID__) || defined(__linux__)
+            #include <pthread.h>
+            #include <sched.h>
+            #include <sys/resource.h>
+            #include <sys/syscall.h>
+            #include <unistd.h>
+            #endif
+
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace utils {{
+
+            // Move-only `void()` callable.
+            // Callables up to `kInlineSize` bytes (eg. the module, the promise and a few arguments) are stored inline,
+            // so enqueuing a task does not allocate.
+            // Callables with a `cancel()` member are cancelled instead of silently destroyed when the task is dropped
+            // (destroyed, overwritten or `cancel()`ed) before it runs.
+            class Task {{
+            public:
+              static constexpr size_t kInlineSize = 64;
+
+              Task() noexcept = default;
+
+              template <class F, class Fn = std::decay_t<F>, class = std::enable_if_t<!std::is_same_v<Fn, Task>>>
+              Task(F &&f) {{
+                if constexpr (sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+                              std::is_nothrow_move_constructible_v<Fn>) {{
+                  new (&storage_) Fn(std::forward<F>(f));
+                  ops_ = &kInlineOps<Fn>;
+                }} else {{
+                  *reinterpret_cast<Fn **>(&storage_) = new Fn(std::forward<F>(f));
+                  ops_ = &kHeapOps<Fn>;
+                }}
+              }}
+
+              Task(Task &&other) noexcept : ops_(other.ops_), invoked_(other.invoked_) {{
+                if (ops_) {{
+                  ops_->move(&other.storage_, &storage_);
+                  other.ops_ = nullptr;
+                }}
+              }}
+
+              Task &operator=(Task &&other) noexcept {{
+                if (this != &other) {{
+                  cancel();
+                  ops_ = other.ops_;
+                  invoked_ = other.invoked_;
+                  if (ops_) {{
+                    ops_->move(&other.storage_, &storage_);
+                    other.ops_ = nullptr;
+                  }}
+                }}
+                return *this;
+              }}
+
+              Task(const Task &) = delete;
+              Task &operator=(const Task &) = delete;
+
+              ~Task() {{
+                cancel();
+              }}
+
+              explicit operator bool() const noexcept {{
+                return ops_ != nullptr;
+              }}
+
+              void operator()() {{
+                invoked_ = true;
+                ops_->invoke(&storage_);
+              }}
+
+              // Drops the task, cancelling it if it has not run
+              void cancel() noexcept {{
+                if (ops_) {{
+                  if (!invoked_) {{
+                    ops_->cancel(&storage_);
+                  }}
+                  reset();
+                }}
+              }}
+
+            private:
+              struct Ops {{
+                void (*invoke)(void *);
+                void (*cancel)(void *);
+                void (*move)(void *from, void *to);
+                void (*destroy)(void *);
+              }};
+
+              template <class Fn>
+              static void invokeCancel(Fn &fn) noexcept {{
+                if constexpr (requires {{ fn.cancel(); }}) {{
+                  try {{
+                    fn.cancel();
+                  }} catch (...) {{
+                    // Noop
+                  }}
+                }}
+              }}
+
+              template <class Fn>
+              static constexpr Ops kInlineOps = {{
+                [](void *p) {{ (*static_cast<Fn *>(p))(); }},
+                [](void *p) {{ invokeCancel(*static_cast<Fn *>(p)); }},
+                [](void *from, void *to) {{
+                  new (to) Fn(std::move(*static_cast<Fn *>(from)));
+                  static_cast<Fn *>(from)->~Fn();
+                }},
+                [](void *p) {{ static_cast<Fn *>(p)->~Fn(); }},
+              }};
+
+              template <class Fn>
+              static constexpr Ops kHeapOps = {{
+                [](void *p) {{ (**static_cast<Fn **>(p))(); }},
+                [](void *p) {{ invokeCancel(**static_cast<Fn **>(p)); }},
+                [](void *from, void *to) {{ *static_cast<Fn **>(to) = *static_cast<Fn **>(from); }},
+                [](void *p) {{ delete *static_cast<Fn **>(p); }},
+              }};
+
+              void reset() {{
+                if (ops_) {{
+                  ops_->destroy(&storage_);
+                  ops_ = nullptr;
+                }}
+                invoked_ = false;
+              }}
+
+              alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+              const Ops *ops_ = nullptr;
+              bool invoked_ = false;
+            }};
+
+            // Task that calls `onCancel` if it is dropped before it runs (eg. to reject its promise on shutdown).
+            template <class Run, class Cancel>
+            struct CancellableTask {{
+              Run run;
+              Cancel onCancel;
+
+              void operator()() {{
+                run();
+              }}
+
+              void cancel() {{
+                onCancel();
+              }}
+            }};
+
+            template <class Run, class Cancel>
+            CancellableTask<std::decay_t<Run>, std::decay_t<Cancel>> withCancel(Run &&run, Cancel &&onCancel) {{
+              return {{std::forward<Run>(run), std::forward<Cancel>(onCancel)}};
+            }}
+
+            // Settings of the `Executor` workers (`[executor]` of `craby.toml`).
+            struct WorkerOptions {{
+              enum class Priority {{ Default, UserInitiated, Utility, Background }};
+              enum class Affinity {{ Any, Little, Big }};
+
+              // `0`: one worker per core of the affinity (at least 2)
+              static constexpr size_t kThreads = {worker_threads};
+              static constexpr const char *kThreadName = "{worker_thread_name}";
+              static constexpr Priority kPriority = Priority::{worker_priority};
+              static constexpr Affinity kAffinity = Affinity::{worker_affinity};
+            }};
+
+            #if defined(__ANDROID__) || defined(__linux__)
+            // CPUs of the affinity, split by their max frequency: `Little` is the slowest cluster, `Big` the others.
+            // Empty if the affinity is `Any` or all cores are the same.
+            inline const std::vector<int> &affinityCpus() {{
+              static const std::vector<int> cpus = [] {{
+                std::vector<int> selected;
+                if (WorkerOptions::kAffinity == WorkerOptions::Affinity::Any) {{
+                  return selected;
+                }}
+
+                std::vector<std::pair<int, long>> freqs;
+                long minFreq = 0;
+                long maxFreq = 0;
+                long count = sysconf(_SC_NPROCESSORS_CONF);
+                for (int cpu = 0; cpu < count && cpu < CPU_SETSIZE; ++cpu) {{
+                  char path[96];
+                  std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+                  FILE *file = std::fopen(path, "r");
+                  if (file == nullptr) {{
+                    continue;
+                  }}
+                  long freq = 0;
+                  if (std::fscanf(file, "%ld", &freq) == 1 && freq > 0) {{
+                    minFreq = freqs.empty() ? freq : std::min(minFreq, freq);
+                    maxFreq = std::max(maxFreq, freq);
+                    freqs.emplace_back(cpu, freq);
+                  }}
+                  std::fclose(file);
+                }}
+
+                if (minFreq == maxFreq) {{
+                  return selected;
+                }}
+                for (auto [cpu, freq] : freqs) {{
+                  if ((freq == minFreq) == (WorkerOptions::kAffinity == WorkerOptions::Affinity::Little)) {{
+                    selected.push_back(cpu);
+                  }}
+                }}
+                return selected;
+              }}();
+              return cpus;
+            }}
+            #endif
+
+            inline size_t configuredWorkerCount() {{
+              if (WorkerOptions::kThreads != 0) {{
+                return WorkerOptions::kThreads;
+              }}
+            #if defined(__ANDROID__) || defined(__linux__)
+              if (!affinityCpus().empty()) {{
+                return std::max<size_t>(2, affinityCpus().size());
+              }}
+            #endif
+              return std::max(2u, std::thread::hardware_concurrency());
+            }}
+
+            // Names the current worker (`<name>-<index>`) and applies its priority and affinity.
+            // Best effort: the worker runs with the default settings if the OS rejects them.
+            inline void configureWorker(size_t index) {{
+              // 15 characters and the terminator is the limit on Linux
+              char name[16];
+              std::snprintf(name, sizeof(name), "%s-%zu", WorkerOptions::kThreadName, index);
+
+            #if defined(__APPLE__)
+              pthread_setname_np(name);
+
+              switch (WorkerOptions::kPriority) {{
+              case WorkerOptions::Priority::Default:
+                break;
+              case WorkerOptions::Priority::UserInitiated:
+                pthread_set_qos_class_self_np(QOS_CLASS_USER_INITIATED, 0);
+                break;
+              case WorkerOptions::Priority::Utility:
+                pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+                break;
+              case WorkerOptions::Priority::Background:
+                pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+                break;
+              }}
+            #elif defined(__ANDROID__) || defined(__linux__)
+              pthread_setname_np(pthread_self(), name);
+
+              // Same values as `android.os.Process.THREAD_PRIORITY_*`
+              int nice = 0;
+              switch (WorkerOptions::kPriority) {{
+              case WorkerOptions::Priority::Default:
+                break;
+              case WorkerOptions::Priority::UserInitiated:
+                nice = -2;
+                break;
+              case WorkerOptions::Priority::Utility:
+                nice = 5;
+                break;
+              case WorkerOptions::Priority::Background:
+                nice = 10;
+                break;
+              }}
+              if (nice != 0) {{
+                // The nice value is per thread on Linux
+                setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice);
+              }}
+
+              if (!affinityCpus().empty()) {{
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                for (int cpu : affinityCpus()) {{
+                  CPU_SET(cpu, &set);
+                }}
+                sched_setaffinity(0, sizeof(set), &set);
+              }}
+            #endif
+            }}
+
+            class ModuleExecutor;
+            // Defined in `bridging-generated.hpp`
+            class RuntimeCache;
+
+            // Process-wide work-stealing executor shared by all modules.
+            //
+            // Each worker owns a deque: it pops its own tasks from the back and steals from the front of the others' deques.
+            // Tasks submitted from a worker go to its own deque, other tasks are distributed round-robin.
+            class Executor {{
+            public:
+              struct Job {{
+                Task task;
+                std::shared_ptr<ModuleExecutor> owner;
+                bool serial = false;
+              }};
+
+              static Executor &getInstance() {{
+                // Intentionally leaked, the workers live as long as the process
+                static Executor *instance = new Executor();
+                return *instance;
+              }}
+
+              size_t workerCount() const {{
+                return workers_.size();
+              }}
+
+              void submit(Job job) {{
+                size_t index = currentWorker_ != 0 ? currentWorker_ - 1
+                                                   : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+                {{
+                  std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+                  queues_[index]->jobs.push_back(std::move(job));
+                  pending_.fetch_add(1, std::memory_order_release);
+                }}
+
+                // Synchronize with the idle workers so the notification is not lost
+                {{ std::lock_guard<std::mutex> lock(idleMutex_); }}
+                idle_.notify_one();
+              }}
+
+            private:
+              struct Queue {{
+                std::mutex mutex;
+                std::deque<Job> jobs;
+              }};
+
+              Executor() {{
+                size_t count = configuredWorkerCount();
+                for (size_t i = 0; i < count; ++i) {{
+                  queues_.push_back(std::make_unique<Queue>());
+                }}
+                for (size_t i = 0; i < count; ++i) {{
+                  workers_.emplace_back([this, i] {{ run(i); }});
+                }}
+              }}
+
+              bool tryPop(size_t index, Job &job) {{
+                for (size_t i = 0; i < queues_.size(); ++i) {{
+                  auto &queue = *queues_[(index + i) % queues_.size()];
+                  std::lock_guard<std::mutex> lock(queue.mutex);
+                  if (queue.jobs.empty()) {{
+                    continue;
+                  }}
+
+                  // LIFO for the own deque (cache locality), FIFO when stealing (oldest task first)
+                  if (i == 0) {{
+                    job = std::move(queue.jobs.back());
+                    queue.jobs.pop_back();
+                  }} else {{
+                    job = std::move(queue.jobs.front());
+                    queue.jobs.pop_front();
+                  }}
+                  pending_.fetch_sub(1, std::memory_order_relaxed);
+                  return true;
+                }}
+                return false;
+              }}
+
+              void run(size_t index);
+
+              std::vector<std::unique_ptr<Queue>> queues_;
+              std::vector<std::thread> workers_;
+              std::atomic<size_t> next_{{0}};
+              std::atomic<size_t> pending_{{0}};
+              std::mutex idleMutex_;
+              std::condition_variable idle_;
+              // Index + 1 of the worker running on this thread (`0` if not a worker)
+              static inline thread_local size_t currentWorker_ = 0;
+            }};
+
+            // Per-module handle of the shared `Executor`.
+            //
+            // Orders the tasks of the module by the execution policy of the methods:
+            // - `serial`: one task at a time in the order enqueued
+            // - `concurrent` and methods without a policy: up to `maxConcurrency` tasks in parallel (`0` = limited by the worker count)
+            //
+            // Modules with `serial` or `concurrent` methods also hold the state lock around each of their Rust calls:
+            // `serial` tasks and the calls on the JS thread hold it exclusively (`lock()`), `concurrent` tasks hold it shared (`sharedLock()`).
+            // Other modules never take it, so their calls on the JS thread don't wait for their tasks.
+            class ModuleExecutor : public std::enable_shared_from_this<ModuleExecutor> {{
+            public:
+              explicit ModuleExecutor(size_t maxConcurrency = 0) : maxConcurrency_(maxConcurrency) {{}}
+
+              template <class F> void enqueue(F &&f) {{
+                Task task(std::forward<F>(f));
+                {{
+                  std::unique_lock<std::mutex> lock(mutex_);
+                  if (stop_) {{
+                    lock.unlock();
+                    task.cancel();
+                    return;
+                  }}
+                  if (maxConcurrency_ != 0 && running_ >= maxConcurrency_) {{
+                    backlog_.push_back(std::move(task));
+                    return;
+                  }}
+                  ++running_;
+                }}
+                Executor::getInstance().submit({{std::move(task), shared_from_this(), false}});
+              }}
+
+              template <class F> void enqueueSerial(F &&f) {{
+                Task task(std::forward<F>(f));
+                {{
+                  std::unique_lock<std::mutex> lock(mutex_);
+                  if (stop_) {{
+                    lock.unlock();
+                    task.cancel();
+                    return;
+                  }}
+                  if (serialRunning_) {{
+                    serialBacklog_.push_back(std::move(task));
+                    return;
+                  }}
+                  serialRunning_ = true;
+                }}
+                Executor::getInstance().submit({{std::move(task), shared_from_this(), true}});
+              }}
+
+              // Exclusive access to the module state, held for a Rust call only.
+              std::unique_lock<std::shared_mutex> lock() {{
+                return std::unique_lock<std::shared_mutex>(stateMutex_);
+              }}
+
+              // Shared access to the module state for the `concurrent` tasks, held for a Rust call only.
+              std::shared_lock<std::shared_mutex> sharedLock() {{
+                return std::shared_lock<std::shared_mutex>(stateMutex_);
+              }}
+
+              // Cancels the queued tasks, including the ones already submitted to the `Executor`.
+              //
+              // Does not wait for the running tasks (this is called on the JS thread): they hold their own
+              // reference to the module, so it is released by the last of them to finish.
+              void shutdown() {{
+                std::deque<Task> dropped;
+                {{
+                  std::lock_guard<std::mutex> lock(mutex_);
+                  stop_.store(true);
+                  std::swap(dropped, backlog_);
+                  for (auto &task : serialBacklog_) {{
+                    dropped.push_back(std::move(task));
+                  }}
+                  serialBacklog_.clear();
+                }}
+
+                for (auto &task : dropped) {{
+                  task.cancel();
+                }}
+              }}
+
+              // Called by the `Executor` to run a task of this module (the task takes the state lock itself).
+              void run(Task &task) {{
+                if (stop_.load()) {{
+                  task.cancel();
+                  return;
+                }}
+                task();
+              }}
+
+              // Called by the `Executor` when a task of this module has finished.
+              void onComplete(bool serial) {{
+                Task next;
+                {{
+                  std::lock_guard<std::mutex> lock(mutex_);
+                  auto &backlog = serial ? serialBacklog_ : backlog_;
+                  if (stop_ || backlog.empty()) {{
+                    if (serial) {{
+                      serialRunning_ = false;
+                    }} else {{
+                      --running_;
+                    }}
+                    return;
+                  }}
+                  next = std::move(backlog.front());
+                  backlog.pop_front();
+                }}
+                Executor::getInstance().submit({{std::move(next), shared_from_this(), serial}});
+              }}
+
+            private:
+              size_t maxConcurrency_;
+              // Number of running tasks enqueued by `enqueue` (`concurrent` and no policy)
+              size_t running_ = 0;
+              bool serialRunning_ = false;
+              // Written under `mutex_`, read without it by `run`
+              std::atomic<bool> stop_{{false}};
+              std::deque<Task> backlog_;
+              std::deque<Task> serialBacklog_;
+              std::mutex mutex_;
+              std::shared_mutex stateMutex_;
+            }};
+
+            inline void Executor::run(size_t index) {{
+              currentWorker_ = index + 1;
+              configureWorker(index);
+
+              while (true) {{
+                Job job;
+                if (tryPop(index, job)) {{
+                  try {{
+                    if (job.owner) {{
+                      job.owner->run(job.task);
+                    }} else {{
+                      job.task();
+                    }}
+                  }} catch (...) {{
+                    // Noop
+                  }}
+                  // Destroy the captures before the module can be notified as drained
+                  job.task = Task();
+                  if (job.owner) {{
+                    job.owner->onComplete(job.serial);
+                  }}
+                  continue;
+                }}
+
+                std::unique_lock<std::mutex> lock(idleMutex_);
+                idle_.wait(lock, [this] {{ return pending_.load(std::memory_order_acquire) > 0; }});
+              }}
+            }}
+
+            // Pending signals of a `latest` or `batch` signal until they are flushed on the JS thread.
+            template <typename T>
+            class SignalQueue {{
+            public:
+              explicit SignalQueue(bool latest) : latest_(latest) {{}}
+
+              // Returns `true` if no flush is scheduled yet, so the caller has to schedule one.
+              bool push(std::shared_ptr<T> signal) {{
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (latest_) {{
+                  pending_.clear();
+                }}
+                pending_.push_back(std::move(signal));
+                return !std::exchange(scheduled_, true);
+              }}
+
+              std::vector<std::shared_ptr<T>> take() {{
+                std::lock_guard<std::mutex> lock(mutex_);
+                scheduled_ = false;
+                return std::exchange(pending_, {{}});
+              }}
+
+              bool isLatest() const {{
+                return latest_;
+              }}
+
+            private:
+              bool latest_;
+              bool scheduled_ = false;
+              std::vector<std::shared_ptr<T>> pending_;
+              std::mutex mutex_;
+            }};
+
+            // Per-thread bump allocator for the temporaries of a call (eg. the UTF-8 copies of `rust::Str` arguments).
+            // Allocations are released in reverse order (`release()` to a previous `mark()`) and the chunks are kept,
+            // so the conversions of a call don't allocate once the arena has grown to the size of the calls.
+            // Chunks larger than `kMaxRetainedSize` (made for a single large allocation) are freed on release instead.
+            class ScratchArena {{
+            public:
+              struct Mark {{
+                size_t chunk;
+                size_t offset;
+              }};
+
+              static ScratchArena &local() {{
+                thread_local ScratchArena arena;
+                return arena;
+              }}
+
+              Mark mark() const noexcept {{
+                return Mark{{current_, offset_}};
+              }}
+
+              void release(Mark mark) noexcept {{
+                // Chunks after the current one are already trimmed, only the ones released by this mark are checked
+                for (auto index = mark.offset == 0 ? mark.chunk : mark.chunk + 1; index <= current_ && index < chunks_.size();
+                     ++index) {{
+                  auto &chunk = chunks_[index];
+                  if (chunk.size > kMaxRetainedSize) {{
+                    chunk.data.reset();
+                    chunk.size = 0;
+                  }}
+                }}
+                current_ = mark.chunk;
+                offset_ = mark.offset;
+              }}
+
+              char *allocate(size_t size) {{
+                if (current_ < chunks_.size() && chunks_[current_].size - offset_ >= size) {{
+                  auto data = chunks_[current_].data.get() + offset_;
+                  offset_ += size;
+                  return data;
+                }}
+
+                next(size);
+                offset_ = size;
+                return chunks_[current_].data.get();
+              }}
+
+              // Grows the latest allocation of the arena, moved to a new chunk if it doesn't fit in its chunk
+              char *grow(char *data, size_t size, size_t newSize) {{
+                auto &chunk = chunks_[current_];
+                if (data + newSize <= chunk.data.get() + chunk.size) {{
+                  offset_ += newSize - size;
+                  return data;
+                }}
+
+                auto moved = allocate(newSize);
+                std::copy(data, data + size, moved);
+                return moved;
+              }}
+
+            private:
+              static constexpr size_t kChunkSize = 16 * 1024;
+              // Size of the largest regular chunk, larger chunks are not kept once released
+              static constexpr size_t kMaxRetainedSize = kChunkSize << 4;
+
+              struct Chunk {{
+                std::unique_ptr<char[]> data;
+                size_t size = 0;
+              }};
+
+              void next(size_t size) {{
+                // Nothing is allocated in the current chunk at offset `0`, so it is reused (eg. after it was freed)
+                auto index = chunks_.empty() || offset_ == 0 ? current_ : current_ + 1;
+                if (index == chunks_.size()) {{
+                  chunks_.emplace_back();
+                }}
+
+                // Chunks after the current one are unused, a chunk too small for the allocation is replaced
+                auto &chunk = chunks_[index];
+                if (chunk.size < size) {{
+                  chunk.size = std::max(size, kChunkSize << std::min<size_t>(index, 4));
+                  chunk.data.reset(new char[chunk.size]);
+                }}
+                current_ = index;
+              }}
+
+              std::vector<Chunk> chunks_;
+              size_t current_ = 0;
+              size_t offset_ = 0;
+            }};
+
+            inline std::string errorMessage(const std::exception &err) {{
+              const auto* rs_err = dynamic_cast<const rust::Error*>(&err);
+              return std::string(rs_err ? rs_err->what() : err.what());
+            }}
+
+            }} // namespace utils
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+        })
     }
 
-    /// Generates C++ utils header file.
+    /// Generates the header of the `ByteStream` completion callback.
+    ///
+    /// A pending `read()`/`write()` is passed to the Rust side as the address of a `StreamOp`,
+    /// and the Rust side calls `onStreamReady` once with it when the stream can make progress.
     ///
     /// # Generated Code
     ///
     /// ```cpp
     /// #pragma once
     ///
-    /// #include "cxx.h"
-    /// #include "ffi.rs.h"
-    /// #include <condition_variable>
-    /// #include <functional>
-    /// #include <mutex>
-    /// #include <queue>
-    /// #include <thread>
-    /// #include <vector>
+    /// #include <cstddef>
+    /// #include <memory>
     ///
     /// namespace craby {
     /// namespace mymodule {
-    /// namespace utils {
-    ///
-    /// class ThreadPool {
-    /// private:
-    ///   bool stop;
-    ///   std::mutex mutex;
-    ///   std::condition_variable condition;
-    ///   std::queue<std::function<void()>> tasks;
-    ///   std::vector<std::thread> workers;
-    /// }
+    /// namespace streams {
     ///
+    /// class StreamOp {
     /// public:
-    ///   ThreadPool(size_t num_threads = 10) : stop(false) {
-    ///     for (size_t i = 0; i < num_threads; ++i) {
-    ///       workers.emplace_back([this] {
-    ///         while (true) {
-    ///           std::function<void()> task;
-    ///
-    ///           {
-    ///             std::unique_lock<std::mutex> lock(this->mutex);
-    ///             this->condition.wait(
-    ///                 lock, [this] { return this->stop || !this->tasks.empty(); });
-    ///
-    ///           if (this->stop && this->tasks.empty()) {
-    ///             return;
-    ///           }
-    ///
-    ///           task = std::move(this->tasks.front());
-    ///           this->tasks.pop();
-    ///         }
-    ///
-    ///         task();
-    ///       }
-    ///     });
-    ///   }
-    ///
-    ///   template <class F> void enqueue(F &&f) {
-    ///     {
-    ///       std::unique_lock<std::mutex> lock(mutex);
-    ///       if (stop) {
-    ///         return;
-    ///       }
-    ///       tasks.emplace(std::forward<F>(f));
-    ///     }
-    ///     condition.notify_one();
-    ///   }
-    ///
-    ///   void shutdown() {
-    ///     {
-    ///       std::unique_lock<std::mutex> lock(mutex);
-    ///       stop = true;
-    ///       std::queue<std::function<void()>> empty;
-    ///       std::swap(tasks, empty);
-    ///     }
-    ///
-    ///     condition.notify_all();
-    ///
-    ///     for (std::thread &worker : workers) {
-    ///       if (worker.joinable()) {
-    ///         worker.join();
-    ///       }
-    ///     }
-    ///   }
-    ///
-    ///   ~ThreadPool() {
-    ///     shutdown();
-    ///   }
+    ///   virtual ~StreamOp() = default;
+    ///   virtual void complete() noexcept = 0;
     /// };
     ///
-    /// inline std::string errorMessage(const std::exception &err) {
-    ///   const auto* rs_err = dynamic_cast<const rust::Error*>(&err);
-    ///   return std::string(rs_err ? rs_err->what() : err.what());
-    /// }
+    /// inline void onStreamReady(size_t op) { /* ... */ }
     ///
-    /// } // namespace utils
+    /// } // namespace streams
     /// } // namespace mymodule
     /// } // namespace craby
     /// ```
-    fn cxx_utils(&self, project_name: &str) -> Result<String, anyhow::Error> {
-        let flat_name = flat_case(project_name);
-
+    fn cxx_streams(&self, project_name: &str) -> Result<String, anyhow::Error> {
         Ok(formatdoc! {
             r#"
             #pragma once
 
-            #include "cxx.h"
-            #include "ffi.rs.h"
-            #include <condition_variable>
-            #include <functional>
-            #include <mutex>
-            #include <queue>
-            #include <thread>
-            #include <vector>
+            #include <cstddef>
+            #include <memory>
 
             namespace craby {{
             namespace {flat_name} {{
-            namespace utils {{
-
-            class ThreadPool {{
-            private:
-              bool stop;
-              std::mutex mutex;
-              std::condition_variable condition;
-              std::queue<std::function<void()>> tasks;
-              std::vector<std::thread> workers;
+            namespace streams {{
 
+            // Pending `read()`/`write()` of a `ByteStream`
+            class StreamOp {{
             public:
-              ThreadPool(size_t num_threads = 10) : stop(false) {{
-                for (size_t i = 0; i < num_threads; ++i) {{
-                  workers.emplace_back([this] {{
-                    while (true) {{
-                      std::function<void()> task;
-
-                      {{
-                        std::unique_lock<std::mutex> lock(this->mutex);
-                        this->condition.wait(
-                            lock, [this] {{ return this->stop || !this->tasks.empty(); }});
-
-                        if (this->stop && this->tasks.empty()) {{
-                          return;
-                        }}
-
-                        task = std::move(this->tasks.front());
-                        this->tasks.pop();
-                      }}
+              virtual ~StreamOp() = default;
+              // Called on the thread that made the stream ready (must not throw into the Rust side)
+              virtual void complete() noexcept = 0;
+            }};
 
-                      task();
-                    }}
-                  }});
-                }}
-              }}
+            // Called by the Rust side with the address of the pending `StreamOp`, which it owned until now
+            inline void onStreamReady(size_t op) {{
+              std::unique_ptr<StreamOp> pending(reinterpret_cast<StreamOp*>(op));
+              pending->complete();
+            }}
 
-              template <class F> void enqueue(F &&f) {{
-                {{
-                  std::unique_lock<std::mutex> lock(mutex);
-                  if (stop) {{
-                    return;
-                  }}
-                  tasks.emplace(std::forward<F>(f));
-                }}
-                condition.notify_one();
-              }}
+            }} // namespace streams
+            }} // namespace {flat_name}
+            }} // namespace craby"#,
+            flat_name = flat_case(project_name),
+        })
+    }
 
-              void shutdown() {{
-                {{
-                  std::unique_lock<std::mutex> lock(mutex);
-                  stop = true;
-                  std::queue<std::function<void()>> empty;
-                  std::swap(tasks, empty);
-                }}
+    /// Generates the header of the `@executor async` completion callback.
+    ///
+    /// The pending promise is passed to the Rust side as the address of a `FutureOp`,
+    /// and the Rust side calls `onFutureReady` once with it and the address of the future's result.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// #pragma once
+    ///
+    /// #include <cstddef>
+    /// #include <memory>
+    ///
+    /// namespace craby {
+    /// namespace mymodule {
+    /// namespace futures {
+    ///
+    /// class FutureOp {
+    /// public:
+    ///   virtual ~FutureOp() = default;
+    ///   virtual void complete(size_t ret) noexcept = 0;
+    /// };
+    ///
+    /// inline void onFutureReady(size_t op, size_t ret) { /* ... */ }
+    ///
+    /// } // namespace futures
+    /// } // namespace mymodule
+    /// } // namespace craby
+    /// ```
+    fn cxx_futures(&self, project_name: &str) -> Result<String, anyhow::Error> {
+        Ok(formatdoc! {
+            r#"
+            #pragma once
 
-                condition.notify_all();
+            #include <cstddef>
+            #include <memory>
 
-                for (std::thread &worker : workers) {{
-                  if (worker.joinable()) {{
-                    worker.join();
-                  }}
-                }}
-              }}
+            namespace craby {{
+            namespace {flat_name} {{
+            namespace futures {{
 
-              ~ThreadPool() {{
-                shutdown();
-              }}
+            // Pending `Promise` of an `@executor async` method
+            class FutureOp {{
+            public:
+              virtual ~FutureOp() = default;
+              // Called on the executor thread that completed the future (must not throw into the Rust side).
+              // `ret` must be passed to the `{{method}}Result` FFI function of the method exactly once.
+              virtual void complete(size_t ret) noexcept = 0;
             }};
 
-            inline std::string errorMessage(const std::exception &err) {{
-              const auto* rs_err = dynamic_cast<const rust::Error*>(&err);
-              return std::string(rs_err ? rs_err->what() : err.what());
+            // Called by the Rust side with the address of the pending `FutureOp`, which it owned until now
+            inline void onFutureReady(size_t op, size_t ret) {{
+              std::unique_ptr<FutureOp> pending(reinterpret_cast<FutureOp*>(op));
+              pending->complete(ret);
             }}
 
-            }} // namespace utils
+            }} // namespace futures
             }} // namespace {flat_name}
             }} // namespace craby"#,
+            flat_name = flat_case(project_name),
         })
     }
 
     /// Generates the signal manager header file for event emission.
     ///
+    /// Delegates live in fixed-size slot blocks, and a new block is chained on when every slot is taken.
+    /// `emit` only walks the blocks with atomic loads (no locking, no allocation), while
+    /// `registerDelegate`/`unregisterDelegate` serialize on a mutex and wait for in-flight emits to
+    /// leave a slot before reusing it.
+    ///
     /// # Generated Code
     ///
     /// ```cpp
     /// #pragma once
     ///
     /// #include "rust/cxx.h"
+    /// #include <array>
+    /// #include <atomic>
     /// #include <functional>
-    /// #include <memory>
     /// #include <mutex>
-    /// #include <unordered_map>
+    /// #include <thread>
     ///
     /// namespace craby {
     /// namespace mymodule {
     /// namespace signals {
     ///
+    /// using Delegate = std::function<void(uint32_t signalId, void* signal)>;
+    ///
     /// class SignalManager {
     /// public:
     ///   static SignalManager& getInstance() {
@@ -957,28 +3514,18 @@ impl CxxTemplate {
     ///     return instance;
     ///   }
     ///
-    ///   void emit(uintptr_t id, rust::Str name) const {
-    ///     std::lock_guard<std::mutex> lock(mutex_);
-    ///     auto it = delegates_.find(id);
-    ///     if (it != delegates_.end()) {
-    ///       it->second(std::string(name));
+    ///   void emit(uintptr_t id, uint32_t signalId, craby::mymodule::bridging::MyModuleSignal* signal) const {
+    ///     for (auto block = &head_; block != nullptr; block = block->next.load()) {
+    ///       // ...
     ///     }
     ///   }
     ///
-    ///   void registerDelegate(uintptr_t id, Delegate delegate) const {
-    ///     std::lock_guard<std::mutex> lock(mutex_);
-    ///     delegates_.insert_or_assign(id, delegate);
-    ///   }
+    ///   void registerDelegate(uintptr_t id, Delegate delegate) const { /* ... */ }
     ///
-    ///   void unregisterDelegate(uintptr_t id) const {
-    ///     std::lock_guard<std::mutex> lock(mutex_);
-    ///     delegates_.erase(id);
-    ///   }
+    ///   void unregisterDelegate(uintptr_t id) const { /* ... */ }
     ///
     /// private:
-    ///   SignalManager() = default;
-    ///   mutable std::unordered_map<uintptr_t, Delegate> delegates_;
-    ///   mutable std::mutex mutex_;
+    ///   // ...
     /// };
     ///
     /// } // namespace signals
@@ -998,10 +3545,11 @@ impl CxxTemplate {
           #pragma once
 
           #include "rust/cxx.h"
+          #include <array>
+          #include <atomic>
           #include <functional>
-          #include <memory>
           #include <mutex>
-          #include <unordered_map>
+          #include <thread>
 
           {forward_declarations}
 
@@ -1024,12 +3572,34 @@ impl CxxTemplate {
 
             void unregisterDelegate(uintptr_t id) const {{
               std::lock_guard<std::mutex> lock(mutex_);
-              delegates_.erase(id);
+              release(id);
             }}
 
           private:
+            // Slots per block of the table, the table grows by a block when every slot is taken
+            static constexpr size_t kBlockSize = 32;
+
+            {delegate_slot}
+
             SignalManager() = default;
-            {delegates_map}
+
+            void release(uintptr_t id) const {{
+              for (auto block = &head_; block != nullptr; block = block->next.load()) {{
+                for (auto& slot : block->slots) {{
+                  if (slot.id.load() != id) {{
+                    continue;
+                  }}
+                  slot.id.store(0);
+                  // Wait for in-flight emits to leave the delegate before releasing it
+                  while (slot.readers.load() != 0) {{
+                    std::this_thread::yield();
+                  }}
+                  slot.delegate = nullptr;
+                }}
+              }}
+            }}
+
+            mutable Block head_;
             mutable std::mutex mutex_;
           }};
 
@@ -1064,7 +3634,7 @@ impl CxxTemplate {
           signal_delegate_typedef = if signal_enum.is_some() {
               formatdoc! {
                   r#"
-                  using Delegate = std::function<void(const std::string& signalName, void* signal)>;"#
+                  using Delegate = std::function<void(uint32_t signalId, void* signal)>;"#
               }
           } else {
               String::new()
@@ -1072,11 +3642,20 @@ impl CxxTemplate {
           emit_impl = if let Some(ref enum_name) = signal_enum {
               formatdoc! {
                   r#"
-                  void emit(uintptr_t id, rust::Str name, craby::{flat_name}::bridging::{enum_name}* signal) const {{
-                      std::lock_guard<std::mutex> lock(mutex_);
-                      auto it = delegates_.find(id);
-                      if (it != delegates_.end()) {{
-                        it->second(std::string(name), reinterpret_cast<void*>(signal));
+                  void emit(uintptr_t id, uint32_t signalId, craby::{flat_name}::bridging::{enum_name}* signal) const {{
+                      for (auto block = &head_; block != nullptr; block = block->next.load()) {{
+                        for (auto& slot : block->slots) {{
+                          if (slot.id.load() != id) {{
+                            continue;
+                          }}
+                          slot.readers.fetch_add(1);
+                          ReaderGuard guard{{slot}};
+                          // Re-check after pinning the slot: the delegate may have been released in between
+                          if (slot.id.load() == id) {{
+                            slot.delegate(signalId, reinterpret_cast<void*>(signal));
+                            return;
+                          }}
+                        }}
                       }}
                     }}"#,
                   enum_name = enum_name,
@@ -1090,16 +3669,47 @@ impl CxxTemplate {
                   r#"
                   void registerDelegate(uintptr_t id, Delegate delegate) const {{
                       std::lock_guard<std::mutex> lock(mutex_);
-                      delegates_.insert_or_assign(id, delegate);
+                      release(id);
+                      for (auto block = &head_;; block = block->next.load()) {{
+                        for (auto& slot : block->slots) {{
+                          if (slot.id.load() == 0) {{
+                            // Publish the id after the delegate so that emit never sees a partial delegate
+                            slot.delegate = std::move(delegate);
+                            slot.id.store(id);
+                            return;
+                          }}
+                        }}
+                        if (block->next.load() == nullptr) {{
+                          // Every slot is taken: grow the table by a block
+                          block->next.store(new Block());
+                        }}
+                      }}
                     }}"#
               }
           } else {
               String::new()
           },
-          delegates_map = if signal_enum.is_some() {
+          delegate_slot = if signal_enum.is_some() {
               formatdoc! {
                   r#"
-                  mutable std::unordered_map<uintptr_t, Delegate> delegates_;"#
+                  struct Slot {{
+                      std::atomic<uintptr_t> id{{0}};
+                      std::atomic<uint32_t> readers{{0}};
+                      Delegate delegate;
+                    }};
+
+                    // Blocks are never freed (the manager lives as long as the process), so emit can walk them without locking
+                    struct Block {{
+                      std::array<Slot, kBlockSize> slots;
+                      std::atomic<Block*> next{{nullptr}};
+                    }};
+
+                    struct ReaderGuard {{
+                      Slot& slot;
+                      ~ReaderGuard() {{
+                        slot.readers.fetch_sub(1);
+                      }}
+                    }};"#
               }
           } else {
               String::new()
@@ -1121,7 +3731,7 @@ impl Template for CxxTemplate {
                 .schemas
                 .iter()
                 .map(|schema| -> Result<Vec<TemplateResult>, anyhow::Error> {
-                    let (cpp, hpp) = self.cxx_mod(schema, &ctx.project_name)?;
+                    let (cpp, hpp) = self.cxx_mod(schema, &ctx.project_name, ctx.stats)?;
                     let cxx_mod = CxxModuleName::from(&schema.module_name);
                     let cxx_base_path = cxx_dir(&ctx.root);
                     let files = vec![
@@ -1147,9 +3757,47 @@ impl Template for CxxTemplate {
             }],
             CxxFileType::UtilsHpp => vec![TemplateResult {
                 path: cxx_dir(&ctx.root).join("CrabyUtils.hpp"),
-                content: self.cxx_utils(&ctx.project_name)?,
+                content: self.cxx_utils(ctx)?,
                 overwrite: true,
             }],
+            CxxFileType::StreamsH => {
+                if Schema::has_byte_streams(&ctx.schemas) {
+                    vec![TemplateResult {
+                        path: cxx_bridge_include_dir(&ctx.root).join("CrabyStreams.h"),
+                        content: self.cxx_streams(&ctx.project_name)?,
+                        overwrite: true,
+                    }]
+                } else {
+                    Vec::default()
+                }
+            }
+            CxxFileType::FuturesH => {
+                if Schema::has_futures(&ctx.schemas) {
+                    vec![TemplateResult {
+                        path: cxx_bridge_include_dir(&ctx.root).join("CrabyFutures.h"),
+                        content: self.cxx_futures(&ctx.project_name)?,
+                        overwrite: true,
+                    }]
+                } else {
+                    Vec::default()
+                }
+            }
+            CxxFileType::RuntimeHpp => vec![TemplateResult {
+                path: cxx_dir(&ctx.root).join("CrabyRuntime.hpp"),
+                content: self.cxx_runtime(ctx),
+                overwrite: true,
+            }],
+            CxxFileType::StatsHpp => {
+                if ctx.stats {
+                    vec![TemplateResult {
+                        path: cxx_dir(&ctx.root).join("CrabyStats.hpp"),
+                        content: self.cxx_stats(&ctx.project_name),
+                        overwrite: true,
+                    }]
+                } else {
+                    Vec::default()
+                }
+            }
             CxxFileType::SignalsH => {
                 let has_signals = ctx.schemas.iter().any(|schema| !schema.signals.is_empty());
 
@@ -1182,7 +3830,7 @@ impl CxxGenerator {
 }
 
 impl Generator<CxxTemplate> for CxxGenerator {
-    fn cleanup(ctx: &CodegenContext) -> Result<(), anyhow::Error> {
+    fn cleanup(ctx: &CodegenContext, outputs: &[TemplateResult]) -> Result<(), anyhow::Error> {
         let cxx_dir = cxx_dir(&ctx.root);
 
         if cxx_dir.try_exists()? {
@@ -1192,6 +3840,7 @@ impl Generator<CxxTemplate> for CxxGenerator {
 
                 if file_name.starts_with("Cxx")
                     && (file_name.ends_with("Module.cpp") || file_name.ends_with("Module.hpp"))
+                    && !outputs.iter().any(|res| res.path == path)
                 {
                     fs::remove_file(&path)?;
                 }
@@ -1210,6 +3859,10 @@ impl Generator<CxxTemplate> for CxxGenerator {
             template.render(ctx, &CxxFileType::BridgingHpp)?,
             template.render(ctx, &CxxFileType::UtilsHpp)?,
             template.render(ctx, &CxxFileType::SignalsH)?,
+            template.render(ctx, &CxxFileType::StreamsH)?,
+            template.render(ctx, &CxxFileType::FuturesH)?,
+            template.render(ctx, &CxxFileType::StatsHpp)?,
+            template.render(ctx, &CxxFileType::RuntimeHpp)?,
         ]
         .into_iter()
         .flatten()
@@ -1231,9 +3884,10 @@ impl GeneratorInvoker for CxxGenerator {
 
 #[cfg(test)]
 mod tests {
+    use craby_common::config::ExecutorConfig;
     use insta::assert_snapshot;
 
-    use crate::tests::get_codegen_context;
+    use crate::{parser::native_spec_parser::try_parse_schema, tests::get_codegen_context};
 
     use super::*;
 
@@ -1250,4 +3904,114 @@ mod tests {
 
         assert_snapshot!(result);
     }
+
+    #[test]
+    fn test_cxx_generator_executor() {
+        let ctx = CodegenContext {
+            executor: ExecutorConfig {
+                threads: Some(4),
+                priority: ThreadPriority::Utility,
+                affinity: CoreAffinity::Little,
+                thread_name: "worker".to_string(),
+            },
+            ..get_codegen_context()
+        };
+        let generator = CxxGenerator::new();
+        let results = generator.generate(&ctx).unwrap();
+        let result = results
+            .iter()
+            .find(|res| res.path.file_name().unwrap() == "CrabyUtils.hpp")
+            .map(|res| format!("{}\n{}", res.path.display(), res.content))
+            .unwrap();
+
+        assert_snapshot!(result);
+    }
+
+    #[test]
+    fn test_cxx_generator_stats() {
+        let ctx = CodegenContext {
+            stats: true,
+            ..get_codegen_context()
+        };
+        let generator = CxxGenerator::new();
+        let results = generator.generate(&ctx).unwrap();
+        let result = results
+            .iter()
+            .filter(|res| {
+                let file_name = res.path.file_name().unwrap().to_string_lossy();
+                file_name == "CrabyStats.hpp" || file_name == "CxxCrabyTestModule.cpp"
+            })
+            .map(|res| format!("{}\n{}", res.path.display(), res.content))
+            .collect::<Vec<_>>()
+            .join("\n\n");
+
+        assert_snapshot!(result);
+    }
+
+    #[test]
+    fn test_cxx_generator_batchable_methods() {
+        let ctx = get_codegen_context();
+        let generator = CxxGenerator::new();
+        let results = generator.generate(&ctx).unwrap();
+        let cpp = results
+            .iter()
+            .find(|res| res.path.file_name().unwrap() == "CxxCrabyTestModule.cpp")
+            .unwrap();
+
+        // `batch` rejects itself and the methods returning a `Promise`
+        for method in &ctx.schemas[0].methods {
+            let fn_name = camel_case(&method.name);
+            let entry = format!("&CxxCrabyTestModule::{fn_name}, {}}},", !method.is_async());
+            assert!(cpp.content.contains(&entry), "{entry}");
+        }
+        assert!(cpp.content.contains("&CxxCrabyTestModule::batch, false},"));
+
+        // Rust errors of the batched calls are thrown as `jsi::JSError`, like the calls made directly
+        let batch = cpp
+            .content
+            .split("jsi::Value CxxCrabyTestModule::batch(")
+            .nth(1)
+            .unwrap();
+        assert!(batch.contains("if (!entry->batchable) {"));
+        assert!(batch.contains("catch (const std::exception &err) {"));
+    }
+
+    #[test]
+    fn test_cxx_generator_pure_method() {
+        let schemas = try_parse_schema(
+            "
+            import type { NativeModule } from 'craby-modules';
+            import { NativeModuleRegistry } from 'craby-modules';
+
+            export interface Spec extends NativeModule {
+                /** @pure */
+                add(a: number, b: number): number;
+            }
+
+            export default NativeModuleRegistry.getEnforcing<Spec>('Calculator');
+            ",
+        )
+        .unwrap();
+        let ctx = CodegenContext {
+            schemas,
+            ..get_codegen_context()
+        };
+        let generator = CxxGenerator::new();
+        let results = generator.generate(&ctx).unwrap();
+        let cpp = results
+            .iter()
+            .find(|res| res.path.file_name().unwrap() == "CxxCalculatorModule.cpp")
+            .unwrap();
+
+        // No module state lock on the fast path, errors are still thrown as `jsi::JSError`
+        let add = cpp
+            .content
+            .split("jsi::Value CxxCalculatorModule::add(")
+            .nth(1)
+            .and_then(|add| add.split("\n}\n").next())
+            .unwrap();
+        assert!(add.contains("args[0].asNumber(), args[1].asNumber()"));
+        assert!(!add.contains("lock"));
+        assert!(add.contains("catch (const std::exception &err) {"));
+    }
 }
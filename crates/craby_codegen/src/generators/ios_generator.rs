@@ -34,18 +34,24 @@ impl IosTemplate {
     /// @implementation CrabyMyAppModuleProvider
     ///
     /// + (void)load {
-    ///   const char *cDataPath = [[self getDataPath] UTF8String];
-    ///   std::string dataPath(cDataPath);
-    ///
-    ///   craby::myproject::modules::CxxMyTestModule::dataPath = dataPath;
-    ///
     ///   facebook::react::registerCxxModuleToGlobalModuleMap(
     ///       craby::myproject::modules::CxxMyTestModule::kModuleName,
     ///       [](std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
+    ///         [CrabyMyAppModuleProvider prepareDataPath];
     ///         return std::make_shared<craby::myproject::modules::CxxMyTestModule>(jsInvoker);
     ///       });
     /// }
     ///
+    /// + (void)prepareDataPath {
+    ///   static dispatch_once_t once;
+    ///   dispatch_once(&once, ^{
+    ///     const char *cDataPath = [[self getDataPath] UTF8String];
+    ///     std::string dataPath(cDataPath);
+    ///
+    ///     craby::myproject::modules::CxxMyTestModule::dataPath = dataPath;
+    ///   });
+    /// }
+    ///
     /// + (NSString *)getDataPath {
     ///   NSString *appGroupID = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"AppGroupID"];
     ///   NSString *dataPath = nil;
@@ -88,6 +94,7 @@ impl IosTemplate {
                 facebook::react::registerCxxModuleToGlobalModuleMap(
                     {cxx_mod_namespace}::kModuleName,
                     [](std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {{
+                      [{objc_provider} prepareDataPath];
                       return std::make_shared<{cxx_mod_namespace}>(jsInvoker);
                     }});"#,
             };
@@ -98,7 +105,7 @@ impl IosTemplate {
         });
 
         let cxx_includes = cxx_includes.join("\n");
-        let cxx_prepares = indent_str(&cxx_prepares.join("\n"), 2);
+        let cxx_prepares = indent_str(&cxx_prepares.join("\n"), 4);
         let cxx_registers = indent_str(&cxx_registers.join("\n"), 2);
         let content = formatdoc! {
             r#"
@@ -112,12 +119,18 @@ impl IosTemplate {
             @implementation {objc_provider}
 
             + (void)load {{
-              const char *cDataPath = [[self getDataPath] UTF8String];
-              std::string dataPath(cDataPath);
+            {cxx_registers}
+            }}
 
-            {cxx_prepares}
+            // Resolved once the first module is created instead of on `+load`, which runs before `main`
+            + (void)prepareDataPath {{
+              static dispatch_once_t once;
+              dispatch_once(&once, ^{{
+                const char *cDataPath = [[self getDataPath] UTF8String];
+                std::string dataPath(cDataPath);
 
-            {cxx_registers}
+            {cxx_prepares}
+              }});
             }}
 
             + (NSString *)getDataPath {{
@@ -187,7 +200,7 @@ impl IosGenerator {
 }
 
 impl Generator<IosTemplate> for IosGenerator {
-    fn cleanup(ctx: &CodegenContext) -> Result<(), anyhow::Error> {
+    fn cleanup(ctx: &CodegenContext, outputs: &[TemplateResult]) -> Result<(), anyhow::Error> {
         let src_path = ios_base_path(&ctx.root).join("src");
 
         if src_path.try_exists()? {
@@ -195,7 +208,7 @@ impl Generator<IosTemplate> for IosGenerator {
                 let path = entry?.path();
                 let file_name = path.file_name().unwrap().to_string_lossy().to_string();
 
-                if file_name.ends_with(".mm") {
+                if file_name.ends_with(".mm") && !outputs.iter().any(|res| res.path == path) {
                     fs::remove_file(&path)?;
                 }
 
@@ -80,6 +80,8 @@ impl RsTemplate {
         cxx_ns: &CxxNamespace,
         rs_cxx_bridges: &[RsCxxBridge],
         has_signals: bool,
+        has_streams: bool,
+        has_abort_signals: bool,
         schemas: &[Schema],
     ) -> String {
         let (impl_types, cxx_externs, struct_defs, enum_defs) = rs_cxx_bridges.iter().fold(
@@ -93,7 +95,111 @@ impl RsTemplate {
             },
         );
 
-        let cxx_extern_stmts = indent_str(&[impl_types, cxx_externs].concat().join("\n\n"), 4);
+        // Called by `RustVecBuffer` when a returned `ArrayBuffer` is garbage-collected,
+        // and by `vecFromSlice` to copy the elements of typed arrays (and large number arrays) at once
+        let buffer_externs = vec![formatdoc! {
+            r#"
+            #[cxx_name = "recycleBuffer"]
+            fn recycle_buffer(buf: Vec<u8>);
+
+            #[cxx_name = "vecFromF64Slice"]
+            fn vec_from_f64_slice(slice: &[f64]) -> Vec<f64>;
+
+            #[cxx_name = "vecFromF32Slice"]
+            fn vec_from_f32_slice(slice: &[f32]) -> Vec<f32>;
+
+            #[cxx_name = "vecFromI32Slice"]
+            fn vec_from_i32_slice(slice: &[i32]) -> Vec<i32>;
+
+            #[cxx_name = "vecFromI16Slice"]
+            fn vec_from_i16_slice(slice: &[i16]) -> Vec<i16>;
+
+            #[cxx_name = "vecFromU8Slice"]
+            fn vec_from_u8_slice(slice: &[u8]) -> Vec<u8>;"#,
+        }];
+
+        // Called by `ByteStreamHostObject` for `read()`, `write()` and `close()` of the JS end
+        let stream_externs = if has_streams {
+            vec![formatdoc! {
+                r#"
+                type ByteStream;
+
+                #[cxx_name = "streamPollRead"]
+                fn stream_poll_read(stream: &ByteStream, op: usize) -> Result<bool>;
+
+                #[cxx_name = "streamTake"]
+                fn stream_take(stream: &ByteStream, size: usize) -> Result<Vec<u8>>;
+
+                #[cxx_name = "streamWrite"]
+                fn stream_write(stream: &ByteStream, chunk: &[u8], op: usize) -> Result<bool>;
+
+                #[cxx_name = "streamFinishWrite"]
+                fn stream_finish_write(stream: &ByteStream) -> Result<()>;
+
+                #[cxx_name = "streamClose"]
+                fn stream_close(stream: &ByteStream);"#,
+            }]
+        } else {
+            vec![]
+        };
+
+        // Called by the generated `Promise` methods for the `AbortSignal` parameters
+        let abort_externs = if has_abort_signals {
+            vec![formatdoc! {
+                r#"
+                type AbortSignal;
+
+                #[cxx_name = "createAbortSignal"]
+                fn create_abort_signal() -> Box<AbortSignal>;
+
+                #[cxx_name = "abortSignalAbort"]
+                fn abort_signal_abort(signal: &AbortSignal);
+
+                #[cxx_name = "abortSignalAborted"]
+                fn abort_signal_aborted(signal: &AbortSignal) -> bool;"#,
+            }]
+        } else {
+            vec![]
+        };
+
+        // Called by `SharedMemoryBuffer` for the `ArrayBuffer` of a returned `SharedState`
+        let shared_externs = if Schema::has_shared_states(schemas) {
+            vec![formatdoc! {
+                r#"
+                type SharedMemory;
+
+                #[cxx_name = "sharedMemoryData"]
+                fn shared_memory_data(memory: &SharedMemory) -> usize;
+
+                #[cxx_name = "sharedMemorySize"]
+                fn shared_memory_size(memory: &SharedMemory) -> usize;"#,
+            }]
+        } else {
+            vec![]
+        };
+
+        // Called by `MappedFileBuffer` for the `ArrayBuffer` of a returned `MappedFile`
+        let mapped_externs = if Schema::has_mapped_files(schemas) {
+            vec![formatdoc! {
+                r#"
+                type MappedFile;
+
+                #[cxx_name = "mappedFileData"]
+                fn mapped_file_data(file: &MappedFile) -> usize;
+
+                #[cxx_name = "mappedFileSize"]
+                fn mapped_file_size(file: &MappedFile) -> usize;"#,
+            }]
+        } else {
+            vec![]
+        };
+
+        let cxx_extern_stmts = indent_str(
+            &[impl_types, cxx_externs, buffer_externs, stream_externs, abort_externs, shared_externs, mapped_externs]
+                .concat()
+                .join("\n\n"),
+            4,
+        );
         let cxx_extern = formatdoc! {
             r#"
             extern "Rust" {{
@@ -166,7 +272,7 @@ impl RsTemplate {
 
                     type SignalManager;
 
-                    unsafe fn emit(self: &SignalManager, id: usize, name: &str, signal: *mut {signal_type});
+                    unsafe fn emit(self: &SignalManager, id: usize, signal_id: u32, signal: *mut {signal_type});
                     
                     #[rust_name = "get_signal_manager"]
                     fn getSignalManager() -> &'static SignalManager;
@@ -177,6 +283,38 @@ impl RsTemplate {
             String::new()
         };
 
+        // Completes a pending `read()`/`write()` of a `ByteStream` (`streams::StreamOp`)
+        let cxx_stream_ops = if has_streams {
+            formatdoc! {
+                r#"
+                #[namespace = "{cxx_ns}::streams"]
+                unsafe extern "C++" {{
+                    include!("CrabyStreams.h");
+
+                    #[rust_name = "on_stream_ready"]
+                    fn onStreamReady(op: usize);
+                }}"#,
+            }
+        } else {
+            String::new()
+        };
+
+        // Completes the pending `Promise` of an `@executor async` method (`futures::FutureOp`)
+        let cxx_future_ops = if Schema::has_futures(schemas) {
+            formatdoc! {
+                r#"
+                #[namespace = "{cxx_ns}::futures"]
+                unsafe extern "C++" {{
+                    include!("CrabyFutures.h");
+
+                    #[rust_name = "on_future_ready"]
+                    fn onFutureReady(op: usize, ret: usize);
+                }}"#,
+            }
+        } else {
+            String::new()
+        };
+
         let code = indent_str(
             &[
                 struct_defs.join("\n\n"),
@@ -184,6 +322,8 @@ impl RsTemplate {
                 cxx_extern,
                 signal_ffi,
                 cxx_signal_manager,
+                cxx_stream_ops,
+                cxx_future_ops,
             ]
             .iter()
             .filter(|s| !s.is_empty())
@@ -249,7 +389,8 @@ impl RsTemplate {
             let (signal_members, pattern_matches, pattern_matches_with_data) = schema
                 .signals
                 .iter()
-                .map(|signal| {
+                .enumerate()
+                .map(|(signal_id, signal)| {
                     let member_name = pascal_case(&signal.name);
                     
                     // Create enum variant based on payload type
@@ -266,10 +407,9 @@ impl RsTemplate {
                     let enum_pattern_match = formatdoc! {
                         r#"{signal_enum_name}::{member_name} => {{
                             unsafe {{
-                                manager.emit(self.id(), "{raw}", std::ptr::null_mut());
+                                manager.emit(self.id(), {signal_id}, std::ptr::null_mut());
                             }}
                         }}"#,
-                        raw = signal.name,
                     };
                     
                     // if there is a data payload
@@ -279,11 +419,10 @@ impl RsTemplate {
                                 let signal = Box::new({signal_enum_name}::{member_name}(data));
                                 let signal_ptr = Box::into_raw(signal);
                                 unsafe {{
-                                    manager.emit(self.id(), "{raw}", signal_ptr);
+                                    manager.emit(self.id(), {signal_id}, signal_ptr);
                                 }}
                             }}"#,
                             signal_enum_name = signal_enum_name,
-                            raw = signal.name,
                         }
                     } else {
                         enum_pattern_match.clone()
@@ -483,9 +622,104 @@ impl RsTemplate {
             .collect::<Vec<String>>();
 
         let has_signals = ctx.schemas.iter().any(|schema| !schema.signals.is_empty());
+        let has_streams = Schema::has_byte_streams(&ctx.schemas);
+        let has_abort_signals = Schema::has_abort_signals(&ctx.schemas);
         let rs_cxx_bridges = self.rs_cxx_bridges(&ctx.schemas)?;
-        let cxx_impls = self.rs_cxx_impl(&rs_cxx_bridges);
-        let cxx_externs = self.rs_cxx_extern(&cxx_ns, &rs_cxx_bridges, has_signals, &ctx.schemas);
+        let mut cxx_impls = self.rs_cxx_impl(&rs_cxx_bridges);
+        cxx_impls.push(formatdoc! {
+            r#"
+            fn recycle_buffer(buf: Vec<u8>) {{
+                craby::pool::recycle(buf);
+            }}
+
+            fn vec_from_f64_slice(slice: &[f64]) -> Vec<f64> {{
+                slice.to_vec()
+            }}
+
+            fn vec_from_f32_slice(slice: &[f32]) -> Vec<f32> {{
+                slice.to_vec()
+            }}
+
+            fn vec_from_i32_slice(slice: &[i32]) -> Vec<i32> {{
+                slice.to_vec()
+            }}
+
+            fn vec_from_i16_slice(slice: &[i16]) -> Vec<i16> {{
+                slice.to_vec()
+            }}
+
+            fn vec_from_u8_slice(slice: &[u8]) -> Vec<u8> {{
+                let mut buf = craby::pool::take(slice.len());
+                buf.extend_from_slice(slice);
+                buf
+            }}"#,
+        });
+        if has_streams {
+            cxx_impls.push(formatdoc! {
+                r#"
+                fn stream_poll_read(stream: &ByteStream, op: usize) -> Result<bool, anyhow::Error> {{
+                    stream.poll_read(Box::new(move || on_stream_ready(op)))
+                }}
+
+                fn stream_take(stream: &ByteStream, size: usize) -> Result<Vec<u8>, anyhow::Error> {{
+                    stream.take(size)
+                }}
+
+                fn stream_write(stream: &ByteStream, chunk: &[u8], op: usize) -> Result<bool, anyhow::Error> {{
+                    stream.write(chunk, Box::new(move || on_stream_ready(op)))
+                }}
+
+                fn stream_finish_write(stream: &ByteStream) -> Result<(), anyhow::Error> {{
+                    stream.finish_write()
+                }}
+
+                fn stream_close(stream: &ByteStream) {{
+                    stream.close();
+                }}"#,
+            });
+        }
+        if has_abort_signals {
+            cxx_impls.push(formatdoc! {
+                r#"
+                fn create_abort_signal() -> Box<AbortSignal> {{
+                    Box::new(AbortSignal::new())
+                }}
+
+                fn abort_signal_abort(signal: &AbortSignal) {{
+                    signal.abort();
+                }}
+
+                fn abort_signal_aborted(signal: &AbortSignal) -> bool {{
+                    signal.aborted()
+                }}"#,
+            });
+        }
+        if Schema::has_shared_states(&ctx.schemas) {
+            cxx_impls.push(formatdoc! {
+                r#"
+                fn shared_memory_data(memory: &SharedMemory) -> usize {{
+                    memory.data()
+                }}
+
+                fn shared_memory_size(memory: &SharedMemory) -> usize {{
+                    memory.size()
+                }}"#,
+            });
+        }
+        if Schema::has_mapped_files(&ctx.schemas) {
+            cxx_impls.push(formatdoc! {
+                r#"
+                fn mapped_file_data(file: &MappedFile) -> usize {{
+                    file.data()
+                }}
+
+                fn mapped_file_size(file: &MappedFile) -> usize {{
+                    file.size()
+                }}"#,
+            });
+        }
+
+        let cxx_externs = self.rs_cxx_extern(&cxx_ns, &rs_cxx_bridges, has_signals, has_streams, has_abort_signals, &ctx.schemas);
         
         // Generate signal payload extraction function implementation
         let signal_payload_impls = if has_signals {
@@ -656,7 +890,7 @@ impl RsGenerator {
 }
 
 impl Generator<RsTemplate> for RsGenerator {
-    fn cleanup(_: &CodegenContext) -> Result<(), anyhow::Error> {
+    fn cleanup(_: &CodegenContext, _: &[TemplateResult]) -> Result<(), anyhow::Error> {
         Ok(())
     }
 
@@ -16,7 +16,10 @@ pub trait Generator<T>
 where
     T: Template,
 {
-    fn cleanup(ctx: &CodegenContext) -> Result<(), anyhow::Error>;
+    /// Removes stale files that are not part of `outputs` (the results of [`Generator::generate`])
+    ///
+    /// Outputs are kept so unchanged files are not rewritten and their dependents are not rebuilt
+    fn cleanup(ctx: &CodegenContext, outputs: &[TemplateResult]) -> Result<(), anyhow::Error>;
     fn generate(&self, ctx: &CodegenContext) -> Result<Vec<TemplateResult>, anyhow::Error>;
     fn template_ref(&self) -> &T;
 }
@@ -2,7 +2,7 @@ use log::debug;
 use oxc::{
     allocator::Allocator,
     ast::ast::*,
-    ast_visit::Visit,
+    ast_visit::{walk, Visit},
     diagnostics::OxcDiagnostic,
     parser::Parser,
     semantic::{Scoping, SemanticBuilder, SymbolId},
@@ -30,7 +30,26 @@ const INVALID_MIXED_ENUM_MEMBER: &str =
     "Enum member type must be single type (eg. only `number` or `string`)";
 const INVALID_REGISTRY_METHOD: &str = "Invalid NativeModuleRegistry method";
 const INVALID_RESERVED_ARG_NAME_ID: &str = "Reserved argument name `it_` is not allowed";
-const INVALID_RESERVED_METHOD_NAME_ID: &str = "Reserved method name `emit` is not allowed";
+const INVALID_RESERVED_METHOD_NAME_ID: &str =
+    "Reserved method names `emit`, `batch` and `__crabyStats` are not allowed";
+const INVALID_EXECUTOR_POLICY: &str =
+    "Invalid `@executor` policy (expected `serial`, `concurrent`, `js-thread` or `async`)";
+const INVALID_SYNC_EXECUTOR: &str = "`@executor` is only supported for methods returning Promise";
+const INVALID_LAZY_ARRAY: &str = "`LazyArray` is only supported as the return type of sync methods";
+const INVALID_BYTE_STREAM: &str =
+    "`ByteStream` is only supported as the return type of sync methods";
+const INVALID_MAPPED_FILE: &str =
+    "`MappedFile` is only supported as the return type of sync methods";
+const INVALID_ABORT_SIGNAL: &str =
+    "`AbortSignal` is only supported as a parameter of methods returning Promise";
+const INVALID_PURE_METHOD: &str =
+    "`@pure` is only supported for sync methods with `number` or `boolean` parameters and return type";
+const INVALID_PURE_LOCKED_METHOD: &str =
+    "`@pure` methods don't take the module state lock, so they can't be used with `@executor serial` or `concurrent`";
+const INVALID_SHARED_STATE: &str =
+    "`SharedState` is only supported as the return type of sync methods, with an object type of `number` fields";
+const INVALID_SIGNAL_DELIVERY: &str =
+    "Invalid `@delivery` policy (expected `every`, `latest` or `batch`)";
 
 pub struct NativeModuleAnalyzer<'a> {
     pub diagnostics: Vec<OxcDiagnostic>,
@@ -49,10 +68,14 @@ pub struct NativeModuleAnalyzer<'a> {
     decls: FxHashMap<SymbolId, TypeAnnotation>,
     /// NativeModule specs collected from the source code
     specs: FxHashMap<SymbolId, Spec>,
+    /// Comments of the source code, keyed by the start offset of the node they are attached to
+    comments: FxHashMap<u32, String>,
+    /// Span of the `export` declaration being visited (comments of exported types are attached to it)
+    export_span: Option<Span>,
 }
 
 impl<'a> NativeModuleAnalyzer<'a> {
-    fn new(scoping: &'a Scoping) -> Self {
+    fn new(scoping: &'a Scoping, comments: FxHashMap<u32, String>) -> Self {
         Self {
             scoping,
             diagnostics: vec![],
@@ -63,6 +86,8 @@ impl<'a> NativeModuleAnalyzer<'a> {
             specs: FxHashMap::default(),
             mods: FxHashMap::default(),
             decls: FxHashMap::default(),
+            comments,
+            export_span: None,
         }
     }
 
@@ -125,6 +150,7 @@ impl<'a> NativeModuleAnalyzer<'a> {
 
         let id = it.id.symbol_id();
         let name = it.id.name.to_string();
+        let lazy = self.has_decl_tag(it.span, LAZY_TAG);
 
         // Collect type alias
         let mut props = vec![];
@@ -146,7 +172,7 @@ impl<'a> NativeModuleAnalyzer<'a> {
 
         self.decls.insert(
             id,
-            TypeAnnotation::Object(ObjectTypeAnnotation { name, props }),
+            TypeAnnotation::Object(ObjectTypeAnnotation { name, props, lazy }),
         );
     }
 
@@ -166,6 +192,7 @@ impl<'a> NativeModuleAnalyzer<'a> {
 
         match &it.type_annotation {
             TSType::TSTypeLiteral(type_lit) => {
+                let lazy = self.has_decl_tag(it.span, LAZY_TAG);
                 let props = type_lit
                     .members
                     .iter()
@@ -185,7 +212,7 @@ impl<'a> NativeModuleAnalyzer<'a> {
                     Ok(props) => {
                         self.decls.insert(
                             id,
-                            TypeAnnotation::Object(ObjectTypeAnnotation { name, props }),
+                            TypeAnnotation::Object(ObjectTypeAnnotation { name, props, lazy }),
                         );
                     }
                     Err(e) => self.diagnostics.push(e),
@@ -388,7 +415,10 @@ impl<'a> NativeModuleAnalyzer<'a> {
             _ => return Err(error(INVALID_SPEC, sig.span)),
         };
 
-        if method_name == RESERVED_METHOD_NAME_MODULE {
+        if method_name == RESERVED_METHOD_NAME_MODULE
+            || method_name == RESERVED_METHOD_NAME_BATCH
+            || method_name == RESERVED_METHOD_NAME_STATS
+        {
             return Err(error(INVALID_RESERVED_METHOD_NAME_ID, sig.span));
         }
 
@@ -421,7 +451,7 @@ impl<'a> NativeModuleAnalyzer<'a> {
                     .as_ref()
                     .ok_or_else(|| error(INVALID_SPEC, param.span))?;
 
-                match self.try_into_type_annotation(&param_type_annotation.type_annotation) {
+                match self.try_into_param_type(&param_type_annotation.type_annotation) {
                     Ok(type_annotation) => Ok(Param {
                         name: param_name.to_string(),
                         type_annotation,
@@ -436,16 +466,99 @@ impl<'a> NativeModuleAnalyzer<'a> {
             .as_ref()
             .ok_or_else(|| error(INVALID_SPEC, sig.span))?;
 
-        match self.try_into_type_annotation(&ret_type.type_annotation) {
-            Ok(type_annotation) => Ok(Method {
-                name: method_name,
-                params,
-                ret_type: type_annotation,
-            }),
-            Err(e) => Err(error(&e.to_string(), sig.span)),
+        let ret_type = self
+            .try_into_ret_type(&ret_type.type_annotation)
+            .map_err(|e| error(&e.to_string(), sig.span))?;
+
+        let is_async = matches!(ret_type, TypeAnnotation::Promise(..));
+        if !is_async
+            && params
+                .iter()
+                .any(|param| param.type_annotation == TypeAnnotation::AbortSignal)
+        {
+            return Err(error(INVALID_ABORT_SIGNAL, sig.span));
+        }
+
+        let policy = match self.try_into_policy(sig.span) {
+            Ok(Some(_)) if !is_async => {
+                return Err(error(INVALID_SYNC_EXECUTOR, sig.span));
+            }
+            Ok(policy) => policy.unwrap_or_default(),
+            Err(e) => return Err(e),
+        };
+
+        let pure = self.get_tag_value(sig.span, PURE_TAG).is_some();
+        if pure
+            && (!(Method::is_pure_type(&ret_type) || ret_type == TypeAnnotation::Void)
+                || !params
+                    .iter()
+                    .all(|param| Method::is_pure_type(&param.type_annotation)))
+        {
+            return Err(error(INVALID_PURE_METHOD, sig.span));
+        }
+
+        Ok(Method {
+            name: method_name,
+            params,
+            ret_type,
+            policy,
+            pure,
+        })
+    }
+
+    /// Parses the `@executor` tag of the comment attached to the method signature.
+    ///
+    /// ```ts
+    /// /** @executor concurrent */
+    /// compute(arg: number): Promise<number>;
+    /// ```
+    fn try_into_policy(&self, span: Span) -> Result<Option<ExecutionPolicy>, OxcDiagnostic> {
+        match self.get_tag_value(span, EXECUTOR_TAG) {
+            None => Ok(None),
+            Some(EXECUTOR_SERIAL) => Ok(Some(ExecutionPolicy::Serial)),
+            Some(EXECUTOR_CONCURRENT) => Ok(Some(ExecutionPolicy::Concurrent)),
+            Some(EXECUTOR_JS_THREAD) => Ok(Some(ExecutionPolicy::JsThread)),
+            Some(EXECUTOR_ASYNC) => Ok(Some(ExecutionPolicy::Async)),
+            Some(_) => Err(error(INVALID_EXECUTOR_POLICY, span)),
+        }
+    }
+
+    /// Parses the `@delivery` tag of the comment attached to the signal property.
+    ///
+    /// ```ts
+    /// /** @delivery latest */
+    /// onProgress: Signal<ProgressEvent>;
+    /// ```
+    fn try_into_delivery(&self, span: Span) -> Result<SignalDelivery, OxcDiagnostic> {
+        match self.get_tag_value(span, DELIVERY_TAG) {
+            None | Some(DELIVERY_EVERY) => Ok(SignalDelivery::Every),
+            Some(DELIVERY_LATEST) => Ok(SignalDelivery::Latest),
+            Some(DELIVERY_BATCH) => Ok(SignalDelivery::Batch),
+            Some(_) => Err(error(INVALID_SIGNAL_DELIVERY, span)),
         }
     }
 
+    /// Returns `true` if the comment attached to the type declaration (or its `export` declaration) has the JSDoc tag.
+    ///
+    /// ```ts
+    /// /** @lazy */
+    /// export interface Record { ... }
+    /// ```
+    fn has_decl_tag(&self, span: Span, tag: &str) -> bool {
+        self.get_tag_value(span, tag).is_some()
+            || self
+                .export_span
+                .is_some_and(|export_span| self.get_tag_value(export_span, tag).is_some())
+    }
+
+    /// Returns the value of the JSDoc tag (eg. `@tag value`) in the comment attached to the node.
+    fn get_tag_value(&self, span: Span, tag: &str) -> Option<&str> {
+        let comment = self.comments.get(&span.start)?;
+        let (_, rest) = comment.split_once(tag)?;
+
+        Some(rest.split_whitespace().next().unwrap_or_default())
+    }
+
     fn try_into_signal(&mut self, sig: &TSPropertySignature<'a>) -> Result<Signal, OxcDiagnostic> {
         if sig.type_annotation.is_none() {
             return Err(error(INVALID_SPEC, sig.span));
@@ -477,6 +590,7 @@ impl<'a> NativeModuleAnalyzer<'a> {
                         Ok(Signal {
                             name: event_name,
                             payload_type,
+                            delivery: self.try_into_delivery(sig.span)?,
                         })
                     } else {
                         Err(error(INVALID_SPEC, sig.span))
@@ -495,6 +609,58 @@ impl<'a> NativeModuleAnalyzer<'a> {
         }
     }
 
+    /// `AbortSignal` is only allowed at the top level of the parameter types (of methods returning Promise).
+    fn try_into_param_type(
+        &mut self,
+        ts_type: &TSType<'a>,
+    ) -> Result<TypeAnnotation, anyhow::Error> {
+        if let TSType::TSTypeReference(type_ref) = ts_type {
+            if let TSTypeName::IdentifierReference(ident_ref) = &type_ref.type_name {
+                if ident_ref.name == RESERVED_TYPE_ABORT_SIGNAL {
+                    return Ok(TypeAnnotation::AbortSignal);
+                }
+            }
+        }
+
+        self.try_into_type_annotation(ts_type)
+    }
+
+    /// `LazyArray<T>`, `ByteStream`, `MappedFile` and `SharedState<T>` are only allowed at the top level of the return type of sync methods.
+    fn try_into_ret_type(&mut self, ts_type: &TSType<'a>) -> Result<TypeAnnotation, anyhow::Error> {
+        if let TSType::TSTypeReference(type_ref) = ts_type {
+            if let TSTypeName::IdentifierReference(ident_ref) = &type_ref.type_name {
+                if ident_ref.name == RESERVED_TYPE_BYTE_STREAM {
+                    return Ok(TypeAnnotation::ByteStream);
+                }
+                if ident_ref.name == RESERVED_TYPE_MAPPED_FILE {
+                    return Ok(TypeAnnotation::MappedFile);
+                }
+                if ident_ref.name == RESERVED_TYPE_SHARED_STATE {
+                    return match &type_ref.type_arguments {
+                        Some(type_args) if type_args.params.len() == 1 => {
+                            let state_type = type_args.params.first().unwrap();
+                            let state_type = self.try_into_type_annotation(state_type)?;
+                            Ok(TypeAnnotation::SharedState(Box::new(state_type)))
+                        }
+                        _ => anyhow::bail!("Invalid shared state type"),
+                    };
+                }
+                if ident_ref.name == RESERVED_TYPE_LAZY_ARRAY {
+                    return match &type_ref.type_arguments {
+                        Some(type_args) if type_args.params.len() == 1 => {
+                            let element_type = type_args.params.first().unwrap();
+                            let element_type = self.try_into_type_annotation(element_type)?;
+                            Ok(TypeAnnotation::LazyArray(Box::new(element_type)))
+                        }
+                        _ => anyhow::bail!("Invalid lazy array type"),
+                    };
+                }
+            }
+        }
+
+        self.try_into_type_annotation(ts_type)
+    }
+
     fn try_into_type_annotation(
         &mut self,
         ts_type: &TSType<'a>,
@@ -511,6 +677,21 @@ impl<'a> NativeModuleAnalyzer<'a> {
             TSType::TSTypeReference(type_ref) => match &type_ref.type_name {
                 TSTypeName::IdentifierReference(ident_ref) => match ident_ref.name.as_str() {
                     RESERVED_TYPE_ARRAY_BUFFER => Ok(TypeAnnotation::ArrayBuffer),
+                    RESERVED_TYPE_FLOAT64_ARRAY => {
+                        Ok(TypeAnnotation::TypedArray(TypedArrayKind::Float64))
+                    }
+                    RESERVED_TYPE_FLOAT32_ARRAY => {
+                        Ok(TypeAnnotation::TypedArray(TypedArrayKind::Float32))
+                    }
+                    RESERVED_TYPE_INT32_ARRAY => {
+                        Ok(TypeAnnotation::TypedArray(TypedArrayKind::Int32))
+                    }
+                    RESERVED_TYPE_INT16_ARRAY => {
+                        Ok(TypeAnnotation::TypedArray(TypedArrayKind::Int16))
+                    }
+                    RESERVED_TYPE_UINT8_ARRAY => {
+                        Ok(TypeAnnotation::TypedArray(TypedArrayKind::Uint8))
+                    }
                     RESERVED_TYPE_PROMISE => match &type_ref.type_arguments {
                         Some(type_args) if type_args.params.len() == 1 => {
                             let resolved_type = type_args.params.first().unwrap();
@@ -519,6 +700,11 @@ impl<'a> NativeModuleAnalyzer<'a> {
                         }
                         _ => anyhow::bail!("Invalid promise type"),
                     },
+                    RESERVED_TYPE_LAZY_ARRAY => anyhow::bail!(INVALID_LAZY_ARRAY),
+                    RESERVED_TYPE_BYTE_STREAM => anyhow::bail!(INVALID_BYTE_STREAM),
+                    RESERVED_TYPE_MAPPED_FILE => anyhow::bail!(INVALID_MAPPED_FILE),
+                    RESERVED_TYPE_ABORT_SIGNAL => anyhow::bail!(INVALID_ABORT_SIGNAL),
+                    RESERVED_TYPE_SHARED_STATE => anyhow::bail!(INVALID_SHARED_STATE),
                     _ => Ok(TypeAnnotation::Ref(RefTypeAnnotation {
                         ref_id: ident_ref.reference_id(),
                         name: ident_ref.name.to_string(),
@@ -662,6 +848,11 @@ impl<'a> NativeModuleAnalyzer<'a> {
             TypeAnnotation::Nullable(base_type) => {
                 NativeModuleAnalyzer::collect_types(base_type, _scoping, _decls, types, enums);
             }
+            TypeAnnotation::Array(element_type)
+            | TypeAnnotation::LazyArray(element_type)
+            | TypeAnnotation::SharedState(element_type) => {
+                NativeModuleAnalyzer::collect_types(element_type, _scoping, _decls, types, enums);
+            }
             TypeAnnotation::Promise(resolved_type) => {
                 NativeModuleAnalyzer::collect_types(resolved_type, _scoping, _decls, types, enums);
             }
@@ -701,6 +892,11 @@ impl<'a> NativeModuleAnalyzer<'a> {
             TypeAnnotation::Nullable(base_type) => {
                 NativeModuleAnalyzer::resolve_refs(base_type, scoping, decls);
             }
+            TypeAnnotation::Array(element_type)
+            | TypeAnnotation::LazyArray(element_type)
+            | TypeAnnotation::SharedState(element_type) => {
+                NativeModuleAnalyzer::resolve_refs(element_type, scoping, decls);
+            }
             TypeAnnotation::Promise(t) => {
                 NativeModuleAnalyzer::resolve_refs(&mut *t, scoping, decls);
             }
@@ -710,7 +906,18 @@ impl<'a> NativeModuleAnalyzer<'a> {
 
     fn try_assert_reserved_type(&self, name: &Atom<'a>) -> Result<(), anyhow::Error> {
         match name.as_str() {
-            RESERVED_TYPE_ARRAY_BUFFER | RESERVED_TYPE_PROMISE => {
+            RESERVED_TYPE_ARRAY_BUFFER
+            | RESERVED_TYPE_FLOAT64_ARRAY
+            | RESERVED_TYPE_FLOAT32_ARRAY
+            | RESERVED_TYPE_INT32_ARRAY
+            | RESERVED_TYPE_INT16_ARRAY
+            | RESERVED_TYPE_UINT8_ARRAY
+            | RESERVED_TYPE_PROMISE
+            | RESERVED_TYPE_LAZY_ARRAY
+            | RESERVED_TYPE_BYTE_STREAM
+            | RESERVED_TYPE_MAPPED_FILE
+            | RESERVED_TYPE_ABORT_SIGNAL
+            | RESERVED_TYPE_SHARED_STATE => {
                 anyhow::bail!("Cannot use reserved type: {}", name.as_str())
             }
             _ => {}
@@ -773,6 +980,20 @@ impl<'a> NativeModuleAnalyzer<'a> {
                 })
                 .collect::<Vec<Method>>();
 
+            // The fields of a shared state are read by JS as a `Float64Array`
+            for method in &methods {
+                if let TypeAnnotation::SharedState(state_type) = &method.ret_type {
+                    let is_numeric = state_type.as_object().is_some_and(|obj| {
+                        obj.props
+                            .iter()
+                            .all(|prop| prop.type_annotation == TypeAnnotation::Number)
+                    });
+                    if !is_numeric {
+                        anyhow::bail!("{INVALID_SHARED_STATE}: {}", method.name);
+                    }
+                }
+            }
+
             let mut signals = spec
                 .signals
                 .into_iter()
@@ -801,6 +1022,11 @@ impl<'a> NativeModuleAnalyzer<'a> {
             methods.sort_by_key(|v| v.name.to_lowercase());
             signals.sort_by_key(|v| v.name.to_lowercase());
 
+            // Other calls would run the Rust module while a `serial` or `concurrent` task holds it
+            if methods.iter().any(|method| method.pure) && methods.iter().any(Method::is_locked) {
+                anyhow::bail!(INVALID_PURE_LOCKED_METHOD);
+            }
+
             schemas.push(Schema {
                 module_name: module_name.to_owned(),
                 aliases,
@@ -852,6 +1078,12 @@ impl<'a> Visit<'a> for NativeModuleAnalyzer<'a> {
         }
     }
 
+    fn visit_export_named_declaration(&mut self, it: &ExportNamedDeclaration<'a>) {
+        self.export_span = Some(it.span);
+        walk::walk_export_named_declaration(self, it);
+        self.export_span = None;
+    }
+
     fn visit_ts_interface_declaration(&mut self, it: &TSInterfaceDeclaration<'a>) {
         if it.declare {
             return;
@@ -910,8 +1142,20 @@ pub fn try_parse_schema(src: &str) -> Result<Vec<Schema>, ParseError> {
         });
     }
 
+    let comments = program
+        .comments
+        .iter()
+        .fold(FxHashMap::default(), |mut comments, comment| {
+            let text = comment.span.source_text(src);
+            comments
+                .entry(comment.attached_to)
+                .and_modify(|prev: &mut String| prev.push_str(text))
+                .or_insert_with(|| text.to_string());
+            comments
+        });
+
     let scoping = ret.semantic.into_scoping();
-    let mut analyzer = NativeModuleAnalyzer::new(&scoping);
+    let mut analyzer = NativeModuleAnalyzer::new(&scoping, comments);
 
     analyzer.visit_program(&program);
 
@@ -932,7 +1176,13 @@ pub fn try_parse_schema(src: &str) -> Result<Vec<Schema>, ParseError> {
 mod tests {
     use insta::{assert_debug_snapshot, assert_snapshot};
 
-    use crate::{parser::native_spec_parser::try_parse_schema, types::Schema};
+    use crate::{
+        parser::{
+            native_spec_parser::try_parse_schema,
+            types::{ExecutionPolicy, SignalDelivery, TypedArrayKind},
+        },
+        types::Schema,
+    };
 
     #[test]
     fn test_common_spec() {
@@ -1399,6 +1649,40 @@ mod tests {
         assert!(result.is_err());
     }
 
+    #[test]
+    fn test_reserved_batch_method_name() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            batch(): void;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let result = try_parse_schema(src);
+
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_reserved_stats_method_name() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            __crabyStats(): void;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let result = try_parse_schema(src);
+
+        assert!(result.is_err());
+    }
+
     #[test]
     fn test_optional_method() {
         let src: &'static str = "
@@ -1433,6 +1717,534 @@ mod tests {
         assert!(result.is_err());
     }
 
+    #[test]
+    fn test_executor_policy() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /**
+             * Runs in parallel
+             * @executor concurrent
+             */
+            first(): Promise<void>;
+            /** @executor js-thread */
+            second(): Promise<void>;
+            third(): Promise<void>;
+            /** @executor async */
+            fourth(): Promise<void>;
+            /** @executor serial */
+            fifth(): Promise<void>;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+        let policies = schemas[0]
+            .methods
+            .iter()
+            .map(|method| method.policy)
+            .collect::<Vec<_>>();
+
+        assert_eq!(
+            policies,
+            vec![
+                ExecutionPolicy::Serial,
+                ExecutionPolicy::Concurrent,
+                ExecutionPolicy::Async,
+                ExecutionPolicy::JsThread,
+                ExecutionPolicy::Unordered,
+            ]
+        );
+    }
+
+    #[test]
+    fn test_invalid_executor_policy() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /** @executor parallel */
+            myMethod(): Promise<void>;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let result = try_parse_schema(src);
+
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_sync_executor_policy() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /** @executor concurrent */
+            myMethod(): number;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let result = try_parse_schema(src);
+
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_pure_method() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /** @pure */
+            add(a: number, b: number): number;
+            /** @pure */
+            toggle(value: boolean): void;
+            subtract(a: number, b: number): number;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+        let pure = schemas[0]
+            .methods
+            .iter()
+            .map(|method| method.pure)
+            .collect::<Vec<_>>();
+
+        assert_eq!(pure, vec![true, false, true]);
+    }
+
+    #[test]
+    fn test_invalid_pure_method() {
+        let srcs: [&'static str; 2] = [
+            "
+            import type { NativeModule, Signal } from 'craby-modules';
+            import { NativeModuleRegistry } from 'craby-modules';
+
+            export interface Spec extends NativeModule {
+                /** @pure */
+                myMethod(arg: string): number;
+            }
+
+            export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+            ",
+            "
+            import type { NativeModule, Signal } from 'craby-modules';
+            import { NativeModuleRegistry } from 'craby-modules';
+
+            export interface Spec extends NativeModule {
+                /** @pure */
+                myMethod(arg: number): Promise<number>;
+            }
+
+            export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+            ",
+        ];
+
+        for src in srcs {
+            assert!(try_parse_schema(src).is_err());
+        }
+    }
+
+    #[test]
+    fn test_invalid_pure_locked_method() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /** @pure */
+            add(a: number, b: number): number;
+            /** @executor serial */
+            update(a: number): Promise<void>;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+
+        assert!(try_parse_schema(src).is_err());
+    }
+
+    #[test]
+    fn test_signal_delivery() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /** @delivery latest */
+            onFirst: Signal;
+            /** @delivery batch */
+            onSecond: Signal;
+            onThird: Signal;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+        let deliveries = schemas[0]
+            .signals
+            .iter()
+            .map(|signal| signal.delivery)
+            .collect::<Vec<_>>();
+
+        assert_eq!(
+            deliveries,
+            vec![
+                SignalDelivery::Latest,
+                SignalDelivery::Batch,
+                SignalDelivery::Every,
+            ]
+        );
+    }
+
+    #[test]
+    fn test_invalid_signal_delivery() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            /** @delivery sometimes */
+            onFoo: Signal;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let result = try_parse_schema(src);
+
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn test_lazy_object() {
+        let src: &'static str = "
+        import type { NativeModule, Signal } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        /** @lazy */
+        export interface First {
+            a: number;
+        }
+
+        /**
+         * Converted on access
+         * @lazy
+         */
+        type Second = {
+            b: number;
+        };
+
+        export interface Third {
+            c: number;
+        }
+
+        export interface Spec extends NativeModule {
+            myMethod(first: First, second: Second): Third;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+        let lazy = schemas[0]
+            .aliases
+            .iter()
+            .map(|alias| {
+                let obj = alias.as_object().unwrap();
+                (obj.name.as_str(), obj.lazy)
+            })
+            .collect::<Vec<_>>();
+
+        assert_eq!(
+            lazy,
+            vec![("First", true), ("Second", true), ("Third", false)]
+        );
+    }
+
+    #[test]
+    fn test_lazy_array() {
+        let src: &'static str = "
+        import type { LazyArray, NativeModule } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Item {
+            a: number;
+        }
+
+        export interface Spec extends NativeModule {
+            myMethod(): LazyArray<Item>;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+        let ret_type = &schemas[0].methods[0].ret_type;
+
+        assert!(matches!(
+            ret_type,
+            TypeAnnotation::LazyArray(element_type)
+                if matches!(&**element_type, TypeAnnotation::Object(obj) if obj.name == "Item")
+        ));
+        assert_eq!(schemas[0].aliases.len(), 1);
+    }
+
+    #[test]
+    fn test_invalid_lazy_array() {
+        let srcs = [
+            "myMethod(arg: LazyArray<number>): void;",
+            "myMethod(): Promise<LazyArray<number>>;",
+            "myMethod(): LazyArray<number> | null;",
+            "myMethod(): LazyArray<number>[];",
+        ];
+
+        for method in srcs {
+            let src = format!(
+                "
+                import type {{ LazyArray, NativeModule }} from 'craby-modules';
+                import {{ NativeModuleRegistry }} from 'craby-modules';
+
+                export interface Spec extends NativeModule {{
+                    {method}
+                }}
+
+                export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+                "
+            );
+
+            assert!(try_parse_schema(&src).is_err(), "{method}");
+        }
+    }
+
+    #[test]
+    fn test_byte_stream() {
+        let src: &'static str = "
+        import type { ByteStream, NativeModule } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            openStream(path: string): ByteStream;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+
+        assert_eq!(schemas[0].methods[0].ret_type, TypeAnnotation::ByteStream);
+    }
+
+    #[test]
+    fn test_mapped_file() {
+        let src: &'static str = "
+        import type { MappedFile, NativeModule } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            loadModel(path: string): MappedFile;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+
+        assert_eq!(schemas[0].methods[0].ret_type, TypeAnnotation::MappedFile);
+    }
+
+    #[test]
+    fn test_invalid_mapped_file() {
+        let srcs = [
+            "myMethod(file: MappedFile): void;",
+            "myMethod(): Promise<MappedFile>;",
+            "myMethod(): MappedFile | null;",
+            "myMethod(): MappedFile[];",
+        ];
+
+        for method in srcs {
+            let src = format!(
+                "
+                import type {{ MappedFile, NativeModule }} from 'craby-modules';
+                import {{ NativeModuleRegistry }} from 'craby-modules';
+
+                export interface Spec extends NativeModule {{
+                    {method}
+                }}
+
+                export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+                "
+            );
+
+            assert!(try_parse_schema(&src).is_err(), "{method}");
+        }
+    }
+
+    #[test]
+    fn test_typed_arrays() {
+        let src: &'static str = "
+        import type { NativeModule } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            resample(samples: Float32Array): Int16Array;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+
+        assert_eq!(
+            schemas[0].methods[0].params[0].type_annotation,
+            TypeAnnotation::TypedArray(TypedArrayKind::Float32)
+        );
+        assert_eq!(
+            schemas[0].methods[0].ret_type,
+            TypeAnnotation::TypedArray(TypedArrayKind::Int16)
+        );
+    }
+
+    #[test]
+    fn test_invalid_byte_stream() {
+        let srcs = [
+            "myMethod(arg: ByteStream): void;",
+            "myMethod(): Promise<ByteStream>;",
+            "myMethod(): ByteStream | null;",
+            "myMethod(): ByteStream[];",
+        ];
+
+        for method in srcs {
+            let src = format!(
+                "
+                import type {{ ByteStream, NativeModule }} from 'craby-modules';
+                import {{ NativeModuleRegistry }} from 'craby-modules';
+
+                export interface Spec extends NativeModule {{
+                    {method}
+                }}
+
+                export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+                "
+            );
+
+            assert!(try_parse_schema(&src).is_err(), "{method}");
+        }
+    }
+
+    #[test]
+    fn test_shared_state() {
+        let src: &'static str = "
+        import type { NativeModule, SharedState } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Position {
+            x: number;
+            y: number;
+        }
+
+        export interface Spec extends NativeModule {
+            position(): SharedState<Position>;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+        let ret_type = &schemas[0].methods[0].ret_type;
+
+        assert!(matches!(
+            ret_type,
+            TypeAnnotation::SharedState(state_type)
+                if matches!(&**state_type, TypeAnnotation::Object(obj) if obj.name == "Position")
+        ));
+        assert_eq!(schemas[0].aliases.len(), 1);
+    }
+
+    #[test]
+    fn test_invalid_shared_state() {
+        let srcs = [
+            "myMethod(arg: SharedState<Position>): void;",
+            "myMethod(): Promise<SharedState<Position>>;",
+            "myMethod(): SharedState<Position> | null;",
+            "myMethod(): SharedState<number>;",
+            "myMethod(): SharedState<Named>;",
+        ];
+
+        for method in srcs {
+            let src = format!(
+                "
+                import type {{ NativeModule, SharedState }} from 'craby-modules';
+                import {{ NativeModuleRegistry }} from 'craby-modules';
+
+                export interface Position {{
+                    x: number;
+                }}
+
+                export interface Named {{
+                    name: string;
+                }}
+
+                export interface Spec extends NativeModule {{
+                    {method}
+                }}
+
+                export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+                "
+            );
+
+            assert!(try_parse_schema(&src).is_err(), "{method}");
+        }
+    }
+
+    #[test]
+    fn test_abort_signal() {
+        let src: &'static str = "
+        import type { NativeModule } from 'craby-modules';
+        import { NativeModuleRegistry } from 'craby-modules';
+
+        export interface Spec extends NativeModule {
+            download(url: string, signal: AbortSignal): Promise<ArrayBuffer>;
+        }
+
+        export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+        ";
+        let schemas = try_parse_schema(src).unwrap();
+
+        assert_eq!(
+            schemas[0].methods[0].params[1].type_annotation,
+            TypeAnnotation::AbortSignal
+        );
+    }
+
+    #[test]
+    fn test_invalid_abort_signal() {
+        let srcs = [
+            "myMethod(signal: AbortSignal): void;",
+            "myMethod(): Promise<AbortSignal>;",
+            "myMethod(signal: AbortSignal | null): Promise<void>;",
+            "myMethod(signals: AbortSignal[]): Promise<void>;",
+        ];
+
+        for method in srcs {
+            let src = format!(
+                "
+                import type {{ NativeModule }} from 'craby-modules';
+                import {{ NativeModuleRegistry }} from 'craby-modules';
+
+                export interface Spec extends NativeModule {{
+                    {method}
+                }}
+
+                export default NativeModuleRegistry.getEnforcing<Spec>('MyModule');
+                "
+            );
+
+            assert!(try_parse_schema(&src).is_err(), "{method}");
+        }
+    }
+
     #[test]
     fn test_hash() {
         let src_1: &'static str = "
@@ -27,6 +27,67 @@ pub struct Method {
     pub name: String,
     pub params: Vec<Param>,
     pub ret_type: TypeAnnotation,
+    /// Where the method runs (`@executor` JSDoc tag)
+    #[serde(default, skip_serializing_if = "ExecutionPolicy::is_default")]
+    pub policy: ExecutionPolicy,
+    /// Whether the method is called by the minimal wrapper (`@pure` JSDoc tag)
+    #[serde(default, skip_serializing_if = "std::ops::Not::not")]
+    pub pure: bool,
+}
+
+impl Method {
+    /// Whether the method returns a `Promise` and runs off the JS thread.
+    pub fn is_async(&self) -> bool {
+        matches!(self.ret_type, TypeAnnotation::Promise(..))
+    }
+
+    /// Whether the method returns a future (`@executor async`).
+    pub fn is_future(&self) -> bool {
+        self.policy == ExecutionPolicy::Async
+    }
+
+    /// Whether the type can be passed to (or returned by) a `@pure` method.
+    pub fn is_pure_type(type_annotation: &TypeAnnotation) -> bool {
+        matches!(
+            type_annotation,
+            TypeAnnotation::Number | TypeAnnotation::Boolean
+        )
+    }
+
+    /// Whether the method borrows the module as `&self` instead of `&mut self`.
+    pub fn is_shared(&self) -> bool {
+        self.policy == ExecutionPolicy::Concurrent
+    }
+
+    /// Whether the method runs on the executor holding the module state lock (`@executor serial` or `concurrent`).
+    pub fn is_locked(&self) -> bool {
+        matches!(
+            self.policy,
+            ExecutionPolicy::Serial | ExecutionPolicy::Concurrent
+        )
+    }
+}
+
+/// Execution policy of `Promise` methods.
+#[derive(Debug, Clone, Copy, Default, Eq, PartialEq, Ord, PartialOrd, Serialize)]
+pub enum ExecutionPolicy {
+    /// Runs on the shared executor, unordered with the other calls of the module (`&mut self`)
+    #[default]
+    Unordered,
+    /// Runs on the shared executor, one call at a time per module (`&mut self`)
+    Serial,
+    /// Runs on the shared executor in parallel with other concurrent calls (`&self`)
+    Concurrent,
+    /// Runs on the JS thread after the current call returns (`&mut self`)
+    JsThread,
+    /// Returns a future that runs on the executor of the `craby` crate (`&mut self` on the JS thread, then `'static`)
+    Async,
+}
+
+impl ExecutionPolicy {
+    pub fn is_default(&self) -> bool {
+        *self == ExecutionPolicy::default()
+    }
 }
 
 #[derive(Debug, Eq, PartialEq, Ord, PartialOrd, Serialize)]
@@ -43,12 +104,24 @@ pub enum TypeAnnotation {
     String,
     Array(Box<TypeAnnotation>),
     ArrayBuffer,
+    TypedArray(TypedArrayKind),
     Object(ObjectTypeAnnotation),
     Enum(EnumTypeAnnotation),
     Promise(Box<TypeAnnotation>),
     Nullable(Box<TypeAnnotation>),
     // Reference to `TypeAnnotation::Object` or `TypeAnnotation::Enum` or Alias types (eg. `Promise`)
     Ref(RefTypeAnnotation),
+    // Array converted to JS as a host object (`LazyArray<T>`, return type of sync methods only)
+    // Declared last to keep the type IDs of the other variants
+    LazyArray(Box<TypeAnnotation>),
+    // Chunked byte stream (`ByteStream`, return type of sync methods only)
+    ByteStream,
+    // Memory-mapped file viewed as an `ArrayBuffer` (`MappedFile`, return type of sync methods only)
+    MappedFile,
+    // Cancellation of the call (`AbortSignal`, parameter of methods returning Promise only)
+    AbortSignal,
+    // Object with `number` fields in memory shared with JS (`SharedState<T>`, return type of sync methods only)
+    SharedState(Box<TypeAnnotation>),
 }
 
 impl TypeAnnotation {
@@ -77,10 +150,43 @@ impl TypeAnnotation {
     }
 }
 
-#[derive(Debug, Clone, Eq, PartialEq, Ord, PartialOrd, Serialize, Hash)]
+#[derive(Debug, Clone, Copy, Eq, PartialEq, Ord, PartialOrd, Serialize, Hash)]
+pub enum TypedArrayKind {
+    Float64,
+    Float32,
+    Int32,
+    Int16,
+    Uint8,
+}
+
+impl TypedArrayKind {
+    /// JavaScript constructor name of the typed array (eg. `Float64Array`)
+    pub fn js_name(&self) -> &'static str {
+        match self {
+            TypedArrayKind::Float64 => "Float64Array",
+            TypedArrayKind::Float32 => "Float32Array",
+            TypedArrayKind::Int32 => "Int32Array",
+            TypedArrayKind::Int16 => "Int16Array",
+            TypedArrayKind::Uint8 => "Uint8Array",
+        }
+    }
+}
+
+#[derive(Debug, Clone, Eq, PartialEq, Ord, PartialOrd, Serialize)]
 pub struct ObjectTypeAnnotation {
     pub name: String,
     pub props: Vec<Prop>,
+    /// Converted to JS as a host object whose fields are converted on access (`@lazy` JSDoc tag)
+    #[serde(default, skip_serializing_if = "std::ops::Not::not")]
+    pub lazy: bool,
+}
+
+// `lazy` only changes how the values are converted, not the identity of the type (`TypeAnnotation::to_id`)
+impl Hash for ObjectTypeAnnotation {
+    fn hash<H: Hasher>(&self, state: &mut H) {
+        self.name.hash(state);
+        self.props.hash(state);
+    }
 }
 
 #[derive(Debug, Clone, Eq, PartialEq, Ord, PartialOrd, Serialize, Hash)]
@@ -118,6 +224,27 @@ pub struct RefTypeAnnotation {
 pub struct Signal {
     pub name: String,
     pub payload_type: Option<TypeAnnotation>,
+    /// How emitted signals are delivered to the listeners (`@delivery` JSDoc tag)
+    #[serde(default, skip_serializing_if = "SignalDelivery::is_default")]
+    pub delivery: SignalDelivery,
+}
+
+/// Delivery policy of signals, applied on the C++ side before scheduling on the JS thread.
+#[derive(Debug, Clone, Copy, Default, Eq, PartialEq, Ord, PartialOrd, Serialize)]
+pub enum SignalDelivery {
+    /// Every emitted signal is delivered
+    #[default]
+    Every,
+    /// Only the newest pending signal is delivered
+    Latest,
+    /// Pending signals are delivered together as an array
+    Batch,
+}
+
+impl SignalDelivery {
+    pub fn is_default(&self) -> bool {
+        *self == SignalDelivery::default()
+    }
 }
 
 #[cfg(test)]
@@ -132,6 +259,7 @@ mod tests {
                 name: "prop".to_string(),
                 type_annotation: TypeAnnotation::String,
             }],
+            lazy: false,
         });
 
         let t2 = TypeAnnotation::Object(ObjectTypeAnnotation {
@@ -140,6 +268,7 @@ mod tests {
                 name: "prop".to_string(),
                 type_annotation: TypeAnnotation::String,
             }],
+            lazy: false,
         });
 
         let t3 = TypeAnnotation::Object(ObjectTypeAnnotation {
@@ -154,6 +283,7 @@ mod tests {
                     type_annotation: TypeAnnotation::String,
                 },
             ],
+            lazy: false,
         });
 
         assert_eq!(t1.to_id(), t2.to_id());
@@ -3,12 +3,15 @@ use std::collections::{btree_map::Entry as BTreeMapEntry, BTreeMap};
 use craby_common::utils::string::camel_case;
 use indoc::formatdoc;
 use log::debug;
-use template::{cxx_arg_ref, cxx_arg_var};
+use template::{cxx_arg_ref, cxx_arg_var, cxx_call_args};
 
 use crate::{
     common::IntoCode,
     constants::specs::RESERVED_ARG_NAME_MODULE,
-    parser::types::{EnumTypeAnnotation, Method, ObjectTypeAnnotation, TypeAnnotation},
+    parser::types::{
+        EnumTypeAnnotation, ExecutionPolicy, Method, ObjectTypeAnnotation, TypeAnnotation,
+        TypedArrayKind,
+    },
     platform::cxx::template::CxxBridgingTemplate,
     types::{CxxModuleName, CxxNamespace, Schema},
     utils::{calc_deps_order, indent_str},
@@ -28,10 +31,10 @@ pub struct CxxToJs {
 pub struct CxxMethod {
     /// Method name
     pub name: String,
-    /// TurboModule's method metadata
+    /// Entry of the module's method table
     ///
     /// ```cpp
-    /// MethodMetadata{1, &CxxMyTestModule::myFunc}
+    /// {"myFunc", 1, &CxxMyTestModule::myFunc, true}
     /// ```
     pub metadata: String,
     /// Cxx function implementation
@@ -47,7 +50,46 @@ pub struct CxxMethod {
     pub impl_func: String,
 }
 
+impl TypedArrayKind {
+    /// Returns the C++ element type of the typed array.
+    ///
+    /// ```cpp
+    /// double  // Float64Array
+    /// float   // Float32Array
+    /// int32_t // Int32Array
+    /// int16_t // Int16Array
+    /// uint8_t // Uint8Array
+    /// ```
+    pub fn as_cxx_elem_type(&self) -> &'static str {
+        match self {
+            TypedArrayKind::Float64 => "double",
+            TypedArrayKind::Float32 => "float",
+            TypedArrayKind::Int32 => "int32_t",
+            TypedArrayKind::Int16 => "int16_t",
+            TypedArrayKind::Uint8 => "uint8_t",
+        }
+    }
+}
+
 impl TypeAnnotation {
+    /// Returns `true` if the converted C++ value owns its data (`rust::String`, `rust::Vec<T>`, structs),
+    /// so it should be moved rather than copied.
+    pub fn is_cxx_owned(&self) -> bool {
+        matches!(
+            self,
+            TypeAnnotation::String
+                | TypeAnnotation::ArrayBuffer
+                | TypeAnnotation::TypedArray(..)
+                | TypeAnnotation::Array(..)
+                | TypeAnnotation::LazyArray(..)
+                | TypeAnnotation::Object(..)
+                | TypeAnnotation::Nullable(..)
+                | TypeAnnotation::ByteStream
+                | TypeAnnotation::MappedFile
+                | TypeAnnotation::SharedState(..)
+        )
+    }
+
     /// Converts TypeAnnotation to C++ type representation.
     ///
     /// # Generated Code Examples
@@ -57,10 +99,14 @@ impl TypeAnnotation {
     /// double                        // Number
     /// rust::Str                     // String (arguments)
     /// rust::String                  // String
-    /// rust::Vec<double>             // Array<Number>
+    /// rust::Vec<double>             // Array<Number>, LazyArray<Number>
+    /// rust::Vec<double>             // Float64Array
     /// craby::mymodule::bridging::MyEnum       // Enum
     /// craby::mymodule::bridging::MyStruct     // Object
     /// craby::mymodule::bridging::NullableNumber  // Nullable<Number>
+    /// rust::Box<craby::mymodule::bridging::ByteStream> // ByteStream
+    /// rust::Box<craby::mymodule::bridging::MappedFile> // MappedFile
+    /// rust::Box<craby::mymodule::bridging::SharedMemory> // SharedState<MyStruct>
     /// ```
     pub fn as_cxx_type(&self, cxx_ns: &CxxNamespace) -> Result<String, anyhow::Error> {
         let cxx_type = match self {
@@ -69,7 +115,8 @@ impl TypeAnnotation {
             TypeAnnotation::Number => "double".to_string(),
             TypeAnnotation::String => "rust::String".to_string(),
             TypeAnnotation::ArrayBuffer => "rust::Vec<uint8_t>".to_string(),
-            TypeAnnotation::Array(element_type) => {
+            TypeAnnotation::TypedArray(kind) => format!("rust::Vec<{}>", kind.as_cxx_elem_type()),
+            TypeAnnotation::Array(element_type) | TypeAnnotation::LazyArray(element_type) => {
                 format!("rust::Vec<{}>", element_type.as_cxx_type(cxx_ns)?)
             }
             TypeAnnotation::Enum(EnumTypeAnnotation { name, .. }) => {
@@ -78,6 +125,11 @@ impl TypeAnnotation {
             TypeAnnotation::Object(ObjectTypeAnnotation { name, .. }) => {
                 format!("{cxx_ns}::bridging::{name}")
             }
+            TypeAnnotation::ByteStream => format!("rust::Box<{cxx_ns}::bridging::ByteStream>"),
+            TypeAnnotation::MappedFile => format!("rust::Box<{cxx_ns}::bridging::MappedFile>"),
+            TypeAnnotation::SharedState(..) => {
+                format!("rust::Box<{cxx_ns}::bridging::SharedMemory>")
+            }
             TypeAnnotation::Nullable(type_annotation) => {
                 let cxx_struct = match &**type_annotation {
                     TypeAnnotation::Boolean => "NullableBoolean".to_string(),
@@ -147,7 +199,10 @@ impl TypeAnnotation {
             TypeAnnotation::Number => "0.0".to_string(),
             TypeAnnotation::String => "rust::String()".to_string(),
             TypeAnnotation::ArrayBuffer => "rust::Vec<uint8_t>()".to_string(),
-            TypeAnnotation::Array(element_type) => {
+            TypeAnnotation::TypedArray(kind) => {
+                format!("rust::Vec<{}>()", kind.as_cxx_elem_type())
+            }
+            TypeAnnotation::Array(element_type) | TypeAnnotation::LazyArray(element_type) => {
                 format!("rust::Vec<{}>()", element_type.as_cxx_type(cxx_ns)?)
             }
             TypeAnnotation::Enum(EnumTypeAnnotation { members, .. }) => {
@@ -189,6 +244,7 @@ impl TypeAnnotation {
     ///
     /// ```cpp
     /// facebook::react::bridging::fromJs<T>(rt, value, callInvoker)
+    /// craby::mymodule::utils::typedArrayFromJs<double>(rt, value) // Float64Array
     /// ```
     pub fn as_cxx_from_js(
         &self,
@@ -207,6 +263,11 @@ impl TypeAnnotation {
                 "react::bridging::fromJs<{}>(rt, {ident}, callInvoker)",
                 self.as_cxx_type(cxx_ns)?,
             ),
+            // Typed arrays share the C++ type with `Array<T>` (and `ArrayBuffer`), so they can't go through `Bridging<T>`
+            TypeAnnotation::TypedArray(kind) => format!(
+                "{cxx_ns}::utils::typedArrayFromJs<{}>(rt, {ident})",
+                kind.as_cxx_elem_type(),
+            ),
             _ => {
                 return Err(anyhow::anyhow!(
                     "[as_cxx_from_js] Unsupported type annotation: {:?}",
@@ -222,17 +283,58 @@ impl TypeAnnotation {
     ///
     /// ```cpp
     /// react::bridging::toJs(rt, value)
+    /// react::bridging::toJs(rt, std::move(value)) // String, ArrayBuffer, Array<T>, Object, Nullable
+    /// craby::mymodule::utils::typedArrayToJs(rt, std::move(value), "Float64Array") // Float64Array
+    /// craby::mymodule::utils::lazyArrayToJs(rt, std::move(value)) // LazyArray<T>
+    /// craby::mymodule::utils::byteStreamToJs(rt, std::move(value), callInvoker) // ByteStream
+    /// craby::mymodule::utils::mappedFileToJs(rt, std::move(value)) // MappedFile
+    /// craby::mymodule::utils::sharedStateToJs(rt, std::move(value), {"foo", "bar"}) // SharedState<MyStruct>
     /// ```
-    pub fn as_cxx_to_js(&self, ident: &str) -> Result<CxxToJs, anyhow::Error> {
+    pub fn as_cxx_to_js(
+        &self,
+        cxx_ns: &CxxNamespace,
+        ident: &str,
+    ) -> Result<CxxToJs, anyhow::Error> {
         let to_js_expr = match self {
-            TypeAnnotation::Boolean
-            | TypeAnnotation::Number
-            | TypeAnnotation::String
+            // Move the `rust::Vec` so its buffer can back the JS value (or be recycled to the buffer pool) without a copy.
+            // Structs are taken by value by their `Bridging<T>::toJs`, so moving them also avoids copying their fields.
+            TypeAnnotation::String
             | TypeAnnotation::ArrayBuffer
             | TypeAnnotation::Array(..)
-            | TypeAnnotation::Enum(..)
             | TypeAnnotation::Object(..)
-            | TypeAnnotation::Nullable(..) => format!("react::bridging::toJs(rt, {})", ident),
+            | TypeAnnotation::Nullable(..) => {
+                format!("react::bridging::toJs(rt, std::move({ident}))")
+            }
+            TypeAnnotation::TypedArray(kind) => format!(
+                "{cxx_ns}::utils::typedArrayToJs(rt, std::move({ident}), \"{}\")",
+                kind.js_name(),
+            ),
+            TypeAnnotation::LazyArray(..) => {
+                format!("{cxx_ns}::utils::lazyArrayToJs(rt, std::move({ident}))")
+            }
+            // Reads and writes of the stream resolve their promises through the `CallInvoker`
+            TypeAnnotation::ByteStream => {
+                format!("{cxx_ns}::utils::byteStreamToJs(rt, std::move({ident}), callInvoker)")
+            }
+            // The `ArrayBuffer` views the mapping, unmapped when it is garbage-collected
+            TypeAnnotation::MappedFile => {
+                format!("{cxx_ns}::utils::mappedFileToJs(rt, std::move({ident}))")
+            }
+            // The `Float64Array` views the Rust memory, the field names map its slots to the object fields
+            TypeAnnotation::SharedState(state_type) => {
+                let fields = state_type
+                    .as_object()
+                    .unwrap()
+                    .props
+                    .iter()
+                    .map(|prop| format!("\"{}\"", prop.name))
+                    .collect::<Vec<_>>()
+                    .join(", ");
+                format!("{cxx_ns}::utils::sharedStateToJs(rt, std::move({ident}), {{{fields}}})")
+            }
+            TypeAnnotation::Boolean | TypeAnnotation::Number | TypeAnnotation::Enum(..) => {
+                format!("react::bridging::toJs(rt, {})", ident)
+            }
             TypeAnnotation::Promise(..) => {
                 format!("react::bridging::toJs(rt, {})", ident)
             }
@@ -260,14 +362,14 @@ impl Method {
     ///                                       const jsi::Value args[],
     ///                                       size_t count) {
     ///   auto &thisModule = static_cast<CxxMyTestModule &>(turboModule);
-    ///   auto callInvoker = thisModule.callInvoker_;
-    ///   auto it_ = thisModule.module_;
+    ///   auto &callInvoker = thisModule.callInvoker_;
     ///
     ///   try {
     ///     if (2 != count) {
     ///       throw jsi::JSError(rt, "Expected 2 arguments");
     ///     }
     ///
+    ///     auto &it_ = thisModule.module();
     ///     auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
     ///     auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
     ///     auto ret = craby::calculator::bridging::multiply(*it_, arg0, arg1);
@@ -280,63 +382,279 @@ impl Method {
     ///   }
     /// }
     /// ```
+    ///
+    /// With `stats`, the phases of the call are recorded by `stats::Call` (`CrabyStats.hpp`):
+    ///
+    /// ```cpp
+    /// static const auto methodStats = craby::calculator::stats::method(kModuleName, "multiply");
+    /// craby::calculator::stats::Call statsCall(methodStats);
+    /// // ...
+    /// statsCall.mark(craby::calculator::stats::Phase::FromJs);
+    /// auto ret = craby::calculator::bridging::multiply(*it_, arg0, arg1);
+    /// statsCall.mark(craby::calculator::stats::Phase::Rust);
+    /// ```
+    ///
+    /// With `locks_state` (the module has `serial` or `concurrent` methods), the Rust call holds the module state lock,
+    /// released before the result is converted:
+    ///
+    /// ```cpp
+    /// auto lock = thisModule.executor_->lock();
+    /// auto ret = craby::calculator::bridging::multiply(*it_, arg0, arg1);
+    /// lock.unlock();
+    /// ```
     pub fn as_cxx_method(
         &self,
         cxx_ns: &CxxNamespace,
         cxx_mod: &CxxModuleName,
+        stats: bool,
+        locks_state: bool,
     ) -> Result<CxxMethod, anyhow::Error> {
+        // `@pure` methods stay minimal, they are not instrumented
+        if self.pure {
+            return self.as_cxx_pure_method(cxx_ns, cxx_mod);
+        }
+
+        // Lock and unlock statements around the Rust calls on the JS thread (empty if the module doesn't lock its state)
+        let (js_lock, js_unlock) = if locks_state {
+            (
+                "auto lock = thisModule.executor_->lock();\n",
+                "\nlock.unlock();",
+            )
+        } else {
+            ("", "")
+        };
+
+        // `statsCall.mark(craby::mymodule::stats::Phase::Rust);` (empty without `stats`)
+        let mark = |target: &str, phase: &str| {
+            if stats {
+                format!("\n{target}.mark({cxx_ns}::stats::Phase::{phase});")
+            } else {
+                String::new()
+            }
+        };
+
         let fn_name = camel_case(&self.name);
         // ["arg0", "arg1", "arg2"]
         let mut args = Vec::with_capacity(self.params.len() + 1);
         // ["auto arg0 = facebook::react::bridging::fromJs<T>(rt, value, callInvoker)", "..."]
         let mut args_decls = Vec::with_capacity(self.params.len());
+        // `AbortSignal` parameters, bound to the promise once it is created
+        let mut abort_args = vec![];
+        // Borrowed buffers may be views of the same `ArrayBuffer`, so they are checked for overlap (see `BorrowedSlices`)
+        let check_overlap = !self.is_async()
+            && self
+                .params
+                .iter()
+                .filter(|param| {
+                    matches!(
+                        param.type_annotation,
+                        TypeAnnotation::ArrayBuffer | TypeAnnotation::TypedArray(..)
+                    )
+                })
+                .count()
+                > 1;
+        let borrow = |slice: String| {
+            if check_overlap {
+                format!("borrowed.borrow({slice})")
+            } else {
+                slice
+            }
+        };
+        if check_overlap {
+            args_decls.push(format!("{cxx_ns}::utils::BorrowedSlices borrowed;"));
+        }
 
         for (idx, param) in self.params.iter().enumerate() {
             let arg_ref = cxx_arg_ref(idx);
             let arg_var = cxx_arg_var(idx);
 
-            // `rust::Str` holds a reference to `std::string`.
-            // To avoid dangling pointers, the converted `std::string` is retained within the scope for the lifetime of the reference.
-            let from_js = if let TypeAnnotation::String = &param.type_annotation {
-                // Capture the converted `std::string` within the scope of the reference
-                let str_var = format!("{arg_var}$raw");
-                args_decls.push(format!("auto {str_var} = {arg_ref}.asString(rt).utf8(rt);",));
-
-                // Convert the `std::string` to `rust::Str`
-                format!("rust::Str({str_var}.data(), {str_var}.size())")
-            } else {
-                param.type_annotation.as_cxx_from_js(cxx_ns, &arg_ref)?.expr
+            let (from_js, owned) = match &param.type_annotation {
+                // `rust::Str` borrows the UTF-8 data of the buffer.
+                // Methods called within the JS call (sync and `@executor async`) copy it into the thread's scratch arena,
+                // the other `Promise` methods move a `Utf8Buffer` into the task, so the reference never outlives the buffer.
+                TypeAnnotation::String if !self.is_async() || self.is_future() => (
+                    format!("{cxx_ns}::utils::ScratchUtf8(rt, {arg_ref}.asString(rt))"),
+                    false,
+                ),
+                TypeAnnotation::String => (
+                    format!("{cxx_ns}::utils::Utf8Buffer(rt, {arg_ref}.asString(rt))"),
+                    true,
+                ),
+                // Sync methods borrow the `ArrayBuffer` memory instead of copying it.
+                // The `jsi::ArrayBuffer` is retained within the scope, so the slice stays valid until the call returns.
+                TypeAnnotation::ArrayBuffer if !self.is_async() => {
+                    let buf_var = format!("{arg_var}Buf");
+                    args_decls.push(format!(
+                        "auto {buf_var} = {arg_ref}.asObject(rt).getArrayBuffer(rt);"
+                    ));
+
+                    (
+                        borrow(format!(
+                            "rust::Slice<uint8_t>({buf_var}.data(rt), {buf_var}.size(rt))"
+                        )),
+                        false,
+                    )
+                }
+                // Same as `ArrayBuffer`, the typed array's elements are borrowed from its underlying buffer.
+                TypeAnnotation::TypedArray(kind) if !self.is_async() => {
+                    let obj_var = format!("{arg_var}Obj");
+                    args_decls.push(format!("auto {obj_var} = {arg_ref}.asObject(rt);"));
+
+                    (
+                        borrow(format!(
+                            "{cxx_ns}::utils::typedArraySlice<{}>(rt, {obj_var})",
+                            kind.as_cxx_elem_type()
+                        )),
+                        false,
+                    )
+                }
+                // The token is shared by the task and the `abort` listener of the JS `AbortSignal` (see `AbortToken::bind`)
+                TypeAnnotation::AbortSignal => {
+                    abort_args.push((arg_var.clone(), arg_ref));
+                    (format!("{cxx_ns}::utils::AbortToken()"), false)
+                }
+                // Owned values (`rust::String`, `rust::Vec<T>`, structs) are moved into the FFI call instead of being copied
+                _ => (
+                    param.type_annotation.as_cxx_from_js(cxx_ns, &arg_ref)?.expr,
+                    param.type_annotation.is_cxx_owned(),
+                ),
             };
-            args.push(arg_var.clone());
+            args.push((arg_var.clone(), owned));
             args_decls.push(format!("auto {arg_var} = {from_js};"));
         }
 
         let invoke_stmts = match &self.ret_type {
+            TypeAnnotation::Promise(resolve_type) if self.is_future() => {
+                if let TypeAnnotation::TypedArray(..) = &**resolve_type {
+                    return Err(anyhow::anyhow!(
+                        "[as_cxx_method] Typed array cannot be resolved by Promise: {}",
+                        self.name
+                    ));
+                }
+
+                let fn_args = cxx_call_args(&args);
+                let abort_binds = abort_args
+                    .iter()
+                    .map(|(arg_var, arg_ref)| format!("\n{arg_var}.bind(rt, {arg_ref}, promise);"))
+                    .collect::<String>();
+                let ret_type = if let TypeAnnotation::Void = &**resolve_type {
+                    "std::monostate".to_string()
+                } else {
+                    resolve_type.as_cxx_type(cxx_ns)?
+                };
+                let ret = self.ret_type.as_cxx_to_js(cxx_ns, "promise")?.expr;
+                let mark_rust = indent_str(&mark("statsCall", "Rust"), 2);
+                let js_lock = js_lock.replace('\n', "\n  ");
+
+                // Create the future on the JS thread and pass the pending promise to the Rust side (`async`)
+                //
+                // The Rust side owns `op` once the FFI function returns, and completes it by `futures::onFutureReady`.
+                formatdoc! {
+                    r#"
+                    react::AsyncPromise<{ret_type}> promise(rt, callInvoker);{abort_binds}
+                    auto op = {cxx_ns}::utils::promiseOp(promise, &{cxx_ns}::bridging::{fn_name}Result);
+
+                    try {{
+                      {js_lock}{cxx_ns}::bridging::{fn_name}({fn_args}, reinterpret_cast<size_t>(op));{mark_rust}
+                    }} catch (const std::exception &err) {{
+                      delete op;
+                      promise.reject({cxx_ns}::utils::errorMessage(err));
+                    }}
+
+                    return {ret};"#,
+                }
+            }
             TypeAnnotation::Promise(resolve_type) => {
+                // Promise values are converted by `Bridging<T>`, which would resolve typed arrays as plain arrays
+                if let TypeAnnotation::TypedArray(..) = &**resolve_type {
+                    return Err(anyhow::anyhow!(
+                        "[as_cxx_method] Typed array cannot be resolved by Promise: {}",
+                        self.name
+                    ));
+                }
+
                 let mut bind_args = Vec::with_capacity(args.len() + 2);
                 bind_args.push(RESERVED_ARG_NAME_MODULE.to_string());
                 bind_args.push("promise".to_string());
-                bind_args.extend(args.clone());
+                bind_args.extend(args.iter().map(|(arg, owned)| {
+                    if *owned {
+                        format!("{arg} = std::move({arg})")
+                    } else {
+                        arg.clone()
+                    }
+                }));
+
+                // The `Queue` wait and the FFI call are recorded on the thread that runs the task
+                if stats {
+                    bind_args.push("asyncCall = statsCall.async()".to_string());
+                }
 
-                args.insert(0, format!("*{}", RESERVED_ARG_NAME_MODULE));
-                let fn_args = args.join(", ");
+                let fn_args = cxx_call_args(&args);
+                let mark_rust = mark("asyncCall", "Rust");
+
+                // The state lock is held for the Rust call only, not while the promise is resolved
+                //
+                // - `serial`: `auto lock = executor->lock();`
+                // - `concurrent`: `auto lock = executor->sharedLock();`
+                // - `js-thread`: `auto lock = executor->lock();` (if the module locks its state)
+                let lock_stmt = match self.policy {
+                    ExecutionPolicy::Serial => Some("lock"),
+                    ExecutionPolicy::Concurrent => Some("sharedLock"),
+                    ExecutionPolicy::JsThread | ExecutionPolicy::Async if locks_state => {
+                        Some("lock")
+                    }
+                    _ => None,
+                };
+                let (lock_stmt, unlock_stmt) = match lock_stmt {
+                    Some(lock_fn) => (
+                        format!("auto lock = executor->{lock_fn}();\n"),
+                        "\nlock.unlock();",
+                    ),
+                    None => (String::new(), ""),
+                };
+                if !lock_stmt.is_empty() {
+                    bind_args.insert(0, "executor = thisModule.executor_".to_string());
+                }
 
                 let ret_stmts = if let TypeAnnotation::Void = &**resolve_type {
                     formatdoc! {
                         r#"
-                        {cxx_ns}::bridging::{fn_name}({fn_args});
+                        {lock_stmt}{cxx_ns}::bridging::{fn_name}({fn_args});{mark_rust}{unlock_stmt}
                         promise.resolve(std::monostate{{}});
                         "#,
                     }
                 } else {
                     formatdoc! {
                         r#"
-                        auto ret = {cxx_ns}::bridging::{fn_name}({fn_args});
-                        promise.resolve(ret);
+                        {lock_stmt}auto ret = {cxx_ns}::bridging::{fn_name}({fn_args});{mark_rust}{unlock_stmt}
+                        promise.resolve(std::move(ret));
                         "#,
                     }
                 };
 
+                // Aborted calls are skipped, their promises are rejected by the `abort` listener
+                let ret_stmts = if abort_args.is_empty() {
+                    ret_stmts
+                } else {
+                    let aborted = abort_args
+                        .iter()
+                        .map(|(arg_var, _)| format!("{arg_var}.aborted()"))
+                        .collect::<Vec<_>>()
+                        .join(" || ");
+
+                    formatdoc! {
+                        r#"
+                        if ({aborted}) {{
+                          return;
+                        }}
+                        {ret_stmts}"#,
+                    }
+                };
+                let abort_binds = abort_args
+                    .iter()
+                    .map(|(arg_var, arg_ref)| format!("\n{arg_var}.bind(rt, {arg_ref}, promise);"))
+                    .collect::<String>();
+
                 let bind_args = bind_args.join(", ");
                 let ret_stmts = indent_str(&ret_stmts, 4);
                 let ret_type = if let TypeAnnotation::Void = &**resolve_type {
@@ -344,14 +662,44 @@ impl Method {
                 } else {
                     resolve_type.as_cxx_type(cxx_ns)?
                 };
-                let ret = self.ret_type.as_cxx_to_js("promise")?.expr;
+                let ret = self.ret_type.as_cxx_to_js(cxx_ns, "promise")?.expr;
+
+                // Create a promise object and invoke the FFI function by the execution policy
+                //
+                // - `serial`: `thisModule.executor_->enqueueSerial(utils::withCancel([...]() mutable { ... }, ...))`
+                // - `concurrent` and no policy: `thisModule.executor_->enqueue(utils::withCancel([...]() mutable { ... }, ...))`
+                // - `js-thread`: `callInvoker->invokeAsync([...](jsi::Runtime &rt) mutable { ... })`
+                //
+                // Tasks dropped by `ModuleExecutor::shutdown` before they run reject their promises.
+                let (dispatch, task_params) = match self.policy {
+                    ExecutionPolicy::Serial => ("thisModule.executor_->enqueueSerial", ""),
+                    ExecutionPolicy::Unordered | ExecutionPolicy::Concurrent => {
+                        ("thisModule.executor_->enqueue", "")
+                    }
+                    ExecutionPolicy::JsThread | ExecutionPolicy::Async => {
+                        ("callInvoker->invokeAsync", "jsi::Runtime &")
+                    }
+                };
+                let (task_open, task_close) = match self.policy {
+                    ExecutionPolicy::JsThread => ("".to_string(), "".to_string()),
+                    _ => (
+                        format!("{cxx_ns}::utils::withCancel("),
+                        formatdoc! {
+                            r#"
+                            , [promise]() mutable {{
+                              promise.reject("Module is invalidated");
+                            }})"#,
+                        },
+                    ),
+                };
+
+                let mark_queue = indent_str(&mark("asyncCall", "Queue"), 2);
 
-                // Create a promise object and invoke the FFI function in a separate thread
                 formatdoc! {
                     r#"
-                    react::AsyncPromise<{ret_type}> promise(rt, callInvoker);
+                    react::AsyncPromise<{ret_type}> promise(rt, callInvoker);{abort_binds}
 
-                    thisModule.threadPool_->enqueue([{bind_args}]() mutable {{
+                    {dispatch}({task_open}[{bind_args}]({task_params}) mutable {{{mark_queue}
                       try {{
                     {ret_stmts}
                       }} catch (const jsi::JSError &err) {{
@@ -359,20 +707,23 @@ impl Method {
                       }} catch (const std::exception &err) {{
                         promise.reject({cxx_ns}::utils::errorMessage(err));
                       }}
-                    }});
+                    }}{task_close});
 
                     return {ret};"#,
                 }
             }
             _ => {
                 // Invoke the FFI function synchronously and return the result
+                // (with `locks_state`, waits for the running Rust calls of the `serial` or `concurrent` tasks of the module)
                 //
                 // ```cpp
+                // auto lock = thisModule.executor_->lock();
                 // auto ret = craby::mymodule::bridging::myFunc(arg0, arg1, arg2);
+                // lock.unlock();
+                //
                 // return ret;
                 // ```
-                args.insert(0, format!("*{RESERVED_ARG_NAME_MODULE}"));
-                let fn_args = args.join(", ");
+                let fn_args = cxx_call_args(&args);
                 let ret_stmts = if let TypeAnnotation::Void = &self.ret_type {
                     format!("{cxx_ns}::bridging::{fn_name}({fn_args});")
                 } else {
@@ -381,10 +732,11 @@ impl Method {
 
                 formatdoc! {
                     r#"
-                    {ret_stmts}
+                    {js_lock}{ret_stmts}{mark_rust}{js_unlock}
 
                     return {to_js};"#,
-                    to_js = self.ret_type.as_cxx_to_js("ret")?.expr,
+                    mark_rust = mark("statsCall", "Rust"),
+                    to_js = self.ret_type.as_cxx_to_js(cxx_ns, "ret")?.expr,
                 }
             }
         };
@@ -393,14 +745,29 @@ impl Method {
         let args_count = self.params.len();
 
         // ```cpp
-        // MethodMetadata{{1, &CxxMyTestModule::myFunc}}
+        // {"myFunc", 1, &CxxMyTestModule::myFunc, true}
         // ```
         let metadata = formatdoc! {
             r#"
-            MethodMetadata{{{args_count}, &{cxx_mod}::{fn_name}}}"#,
+            {{"{name}", {args_count}, &{cxx_mod}::{fn_name}, {batchable}}}"#,
+            name = self.name,
+            batchable = !self.is_async(),
         };
 
+        let args_decls = format!("{args_decls}{}", mark("statsCall", "FromJs"));
         let invoke_stmts = indent_str([args_decls, invoke_stmts].join("\n").trim(), 4);
+        let stats_decls = if stats {
+            formatdoc! {
+                r#"
+
+                static const auto methodStats = {cxx_ns}::stats::method(kModuleName, "{name}");
+                {cxx_ns}::stats::Call statsCall(methodStats);"#,
+                name = self.name,
+            }
+            .replace("\n", "\n  ")
+        } else {
+            String::new()
+        };
         let impl_func = formatdoc! {
             r#"
             jsi::Value {cxx_mod}::{fn_name}(jsi::Runtime &rt,
@@ -408,14 +775,14 @@ impl Method {
                                             const jsi::Value args[],
                                             size_t count) {{
               auto &thisModule = static_cast<{cxx_mod} &>(turboModule);
-              auto callInvoker = thisModule.callInvoker_;
-              auto it_ = thisModule.module_;
+              auto &callInvoker = thisModule.callInvoker_;{stats_decls}
 
               try {{
                 if ({args_count} != count) {{
                   throw jsi::JSError(rt, "Expected {args_count} argument{plural}");
                 }}
 
+                auto &it_ = thisModule.module();
             {invoke_stmts}
               }} catch (const jsi::JSError &err) {{
                 throw err;
@@ -423,7 +790,98 @@ impl Method {
                 throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
               }}
             }}"#,
-            plural = if args_count > 1 { "s" } else { "" },
+            plural = if args_count == 1 { "" } else { "s" },
+        };
+
+        Ok(CxxMethod {
+            name: self.name.clone(),
+            metadata,
+            impl_func,
+        })
+    }
+
+    /// Converts schema Method (`@pure`) to the minimal C++ TurboModule method implementation.
+    ///
+    /// The arguments are read from the JSI values directly and the FFI function returns the value as is,
+    /// so there are no `Bridging<T>` conversions and no `Result` in between. The module state lock is never taken
+    /// (the parser rejects `@pure` in modules with `@executor serial` or `concurrent` methods).
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// jsi::Value CxxMyTestModule::multiply(jsi::Runtime &rt,
+    ///                                       react::TurboModule &turboModule,
+    ///                                       const jsi::Value args[],
+    ///                                       size_t count) {
+    ///   if (2 != count) {
+    ///     throw jsi::JSError(rt, "Expected 2 arguments");
+    ///   }
+    ///
+    ///   auto &thisModule = static_cast<CxxMyTestModule &>(turboModule);
+    ///
+    ///   try {
+    ///     return jsi::Value(craby::calculator::bridging::multiply(*thisModule.module(), args[0].asNumber(), args[1].asNumber()));
+    ///   } catch (const jsi::JSError &err) {
+    ///     throw err;
+    ///   } catch (const std::exception &err) {
+    ///     throw jsi::JSError(rt, craby::calculator::utils::errorMessage(err));
+    ///   }
+    /// }
+    /// ```
+    fn as_cxx_pure_method(
+        &self,
+        cxx_ns: &CxxNamespace,
+        cxx_mod: &CxxModuleName,
+    ) -> Result<CxxMethod, anyhow::Error> {
+        let fn_name = camel_case(&self.name);
+        let args_count = self.params.len();
+
+        // `asNumber` and `asBool` only check the tag of the value (throws `JSINativeException` on mismatch)
+        let fn_args = std::iter::once("*thisModule.module()".to_string())
+            .chain(self.params.iter().enumerate().map(
+                |(idx, param)| match &param.type_annotation {
+                    TypeAnnotation::Boolean => format!("args[{idx}].asBool()"),
+                    _ => format!("args[{idx}].asNumber()"),
+                },
+            ))
+            .collect::<Vec<_>>()
+            .join(", ");
+        let invoke = format!("{cxx_ns}::bridging::{fn_name}({fn_args})");
+        let ret_stmts = if let TypeAnnotation::Void = &self.ret_type {
+            format!("{invoke};\nreturn jsi::Value::undefined();")
+        } else {
+            format!("return jsi::Value({invoke});")
+        };
+
+        let metadata = formatdoc! {
+            r#"
+            {{"{name}", {args_count}, &{cxx_mod}::{fn_name}, true}}"#,
+            name = self.name,
+        };
+
+        let ret_stmts = indent_str(&ret_stmts, 4);
+        let impl_func = formatdoc! {
+            r#"
+            jsi::Value {cxx_mod}::{fn_name}(jsi::Runtime &rt,
+                                            react::TurboModule &turboModule,
+                                            const jsi::Value args[],
+                                            size_t count) {{
+              if ({args_count} != count) {{
+                throw jsi::JSError(rt, "Expected {args_count} argument{plural}");
+              }}
+
+              auto &thisModule = static_cast<{cxx_mod} &>(turboModule);
+
+              // Errors are thrown as `jsi::JSError` like the other methods (eg. `module()` once the module is invalidated)
+              try {{
+            {ret_stmts}
+              }} catch (const jsi::JSError &err) {{
+                throw err;
+              }} catch (const std::exception &err) {{
+                throw jsi::JSError(rt, {cxx_ns}::utils::errorMessage(err));
+              }}
+            }}"#,
+            plural = if args_count == 1 { "" } else { "s" },
         };
 
         Ok(CxxMethod {
@@ -442,13 +900,13 @@ impl Schema {
     /// ```cpp
     /// template <>
     /// struct Bridging<craby::mymodule::bridging::MyStruct> {
-    ///   static craby::mymodule::bridging::MyStruct fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    ///   static craby::mymodule::bridging::MyStruct fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     ///     auto obj = value.asObject(rt);
-    ///     auto obj$foo = obj.getProperty(rt, "foo");
-    ///     auto _obj$foo = react::bridging::fromJs<rust::String>(rt, obj$foo, callInvoker);
+    ///     auto objFoo = obj.getProperty(rt, "foo");
+    ///     auto _objFoo = react::bridging::fromJs<rust::String>(rt, objFoo, callInvoker);
     ///
     ///     craby::mymodule::bridging::MyStruct ret = {
-    ///       _obj$foo
+    ///       _objFoo
     ///     };
     ///
     ///     return ret;
@@ -456,8 +914,8 @@ impl Schema {
     ///
     ///   static jsi::Value toJs(jsi::Runtime &rt, craby::mymodule::bridging::MyStruct value) {
     ///     jsi::Object obj = jsi::Object(rt);
-    ///     auto _obj$foo = react::bridging::toJs(rt, value.foo);
-    ///     obj.setProperty(rt, "foo", _obj$foo);
+    ///     auto _objFoo = react::bridging::toJs(rt, value.foo);
+    ///     obj.setProperty(rt, "foo", _objFoo);
     ///
     ///     return jsi::Value(rt, obj);
     ///   }
@@ -520,7 +978,7 @@ impl Schema {
     /// ```cpp
     /// template <>
     /// struct Bridging<craby::mymodule::bridging::NullableNumber> {
-    ///   static craby::mymodule::bridging::NullableNumber fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+    ///   static craby::mymodule::bridging::NullableNumber fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     ///     if (value.isNull()) {
     ///       return craby::mymodule::bridging::NullableNumber{true, 0.0};
     ///     }
@@ -605,11 +1063,12 @@ impl Schema {
 }
 
 pub mod template {
-    use craby_common::utils::string::{camel_case, snake_case};
+    use craby_common::utils::string::{pascal_case, snake_case};
     use indoc::formatdoc;
 
     use crate::{
         common::IntoCode,
+        constants::specs::RESERVED_ARG_NAME_MODULE,
         parser::types::{
             EnumMemberValue as ParserEnumMemberValue, EnumTypeAnnotation, ObjectTypeAnnotation,
             TypeAnnotation,
@@ -622,6 +1081,8 @@ pub mod template {
         pub namespace: String,
         pub from_js: String,
         pub to_js: String,
+        /// Additional static members of the `Bridging<T>` specialization
+        pub members: Option<String>,
     }
 
     impl IntoCode for CxxBridgingTemplate {
@@ -638,29 +1099,35 @@ pub mod template {
         /// ```cpp
         /// template <>
         /// struct Bridging<TargetType> {
-        ///   static TargetType fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+        ///   static TargetType fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
         ///     // fromJs implementation
         ///   }
         ///
         ///   static jsi::Value toJs(jsi::Runtime &rt, TargetType value) {
         ///     // toJs implementation
         ///   }
+        ///
+        ///   // Additional members
         /// };
         /// ```
         fn cxx_bridging_template(&self) -> String {
             let from_js_impl = indent_str(&self.from_js, 4);
             let to_js_impl = indent_str(&self.to_js, 4);
+            let members = match &self.members {
+                Some(members) => format!("\n\n{}", indent_str(members, 2)),
+                None => String::new(),
+            };
             formatdoc! {
                 r#"
                 template <>
                 struct Bridging<{namespace}> {{
-                  static {namespace} fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {{
+                  static {namespace} fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {{
                 {from_js_impl}
                   }}
     
                   static jsi::Value toJs(jsi::Runtime &rt, {namespace} value) {{
                 {to_js_impl}
-                  }}
+                  }}{members}
                 }};"#,
                 namespace = self.namespace,
             }
@@ -673,24 +1140,26 @@ pub mod template {
         /// ```cpp
         /// template <>
         /// struct Bridging<craby::mymodule::bridging::MyStruct> {
-        ///   static craby::mymodule::bridging::MyStruct fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+        ///   static craby::mymodule::bridging::MyStruct fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+        ///     auto props = craby::mymodule::utils::RuntimeCache::propNames<craby::mymodule::bridging::MyStruct>(rt, {"foo"});
         ///     auto obj = value.asObject(rt);
-        ///     auto obj$foo = obj.getProperty(rt, "foo");
+        ///     auto objFoo = obj.getProperty(rt, (*props)[0]);
         ///
-        ///     auto _obj$foo = react::bridging::fromJs<rust::String>(rt, value.foo, callInvoker);
+        ///     auto _objFoo = react::bridging::fromJs<rust::String>(rt, value.foo, callInvoker);
         ///
         ///     craby::mymodule::bridging::MyStruct ret = {
-        ///       _obj$foo
+        ///       std::move(_objFoo)
         ///     };
         ///
         ///     return ret;
         ///   }
         ///
         ///   static jsi::Value toJs(jsi::Runtime &rt, craby::mymodule::bridging::MyStruct value) {
+        ///     auto props = craby::mymodule::utils::RuntimeCache::propNames<craby::mymodule::bridging::MyStruct>(rt, {"foo"});
         ///     jsi::Object obj = jsi::Object(rt);
-        ///     auto _obj$foo = react::bridging::toJs(rt, value.foo);
+        ///     auto _objFoo = react::bridging::toJs(rt, std::move(value.foo));
         ///
-        ///     obj.setProperty(rt, "foo", _obj$foo);
+        ///     obj.setProperty(rt, (*props)[0], _objFoo);
         ///
         ///     return jsi::Value(rt, obj);
         ///   }
@@ -706,51 +1175,69 @@ pub mod template {
             let mut from_js_stmts = vec![];
             let mut from_js_ident = vec![];
             let mut to_js_stmts = vec![];
+            let mut prop_names = vec![];
 
-            for prop in &obj.props {
-                let ident = format!("obj${}", camel_case(&prop.name));
+            for (idx, prop) in obj.props.iter().enumerate() {
+                let ident = format!("obj{}", pascal_case(&prop.name));
                 let converted_ident = format!("_{}", ident);
                 let from_js = prop.type_annotation.as_cxx_from_js(cxx_ns, &ident)?;
                 let to_js = prop
                     .type_annotation
-                    .as_cxx_to_js(&format!("value.{}", snake_case(&prop.name)))?;
+                    .as_cxx_to_js(cxx_ns, &format!("value.{}", snake_case(&prop.name)))?;
 
                 // ```cpp
-                // auto obj$name = obj.getProperty(rt, "name");
+                // auto objName = obj.getProperty(rt, (*props)[0]);
                 // ```
-                let get_prop = format!("auto {} = obj.getProperty(rt, \"{}\");", ident, prop.name);
+                let get_prop = format!("auto {} = obj.getProperty(rt, (*props)[{}]);", ident, idx);
 
                 // ```cpp
-                // obj.setProperty(rt, "name", _obj$name);
+                // obj.setProperty(rt, (*props)[0], _objName);
                 // ```
                 let set_prop = format!(
-                    "obj.setProperty(rt, \"{}\", {});",
-                    prop.name, converted_ident
+                    "obj.setProperty(rt, (*props)[{}], {});",
+                    idx, converted_ident
                 );
 
                 // ```cpp
-                // auto _obj$name = react::bridging::fromJs<T>(rt, value.name, callInvoker);
+                // auto _objName = react::bridging::fromJs<T>(rt, value.name, callInvoker);
                 // ```
                 let from_js_stmt = format!("auto {} = {};", converted_ident, from_js.expr);
 
                 // ```cpp
-                // auto _obj$name = react::bridging::toJs(rt, value.name);
+                // auto _objName = react::bridging::toJs(rt, value.name);
                 // ```
                 let to_js_stmt = format!("auto {} = {};", converted_ident, to_js.expr);
 
                 get_props.push(get_prop);
                 from_js_stmts.push(from_js_stmt);
-                from_js_ident.push(converted_ident);
+                from_js_ident.push(if prop.type_annotation.is_cxx_owned() {
+                    format!("std::move({converted_ident})")
+                } else {
+                    converted_ident
+                });
                 set_props.push(set_prop);
                 to_js_stmts.push(to_js_stmt);
+                prop_names.push(format!("\"{}\"", prop.name));
             }
 
+            // ```cpp
+            // auto props = craby::mymodule::utils::RuntimeCache::propNames<craby::mymodule::bridging::MyStruct>(rt, {"name"});
+            // ```
+            let props_stmt = if prop_names.is_empty() {
+                String::new()
+            } else {
+                format!(
+                    "auto props = {cxx_ns}::utils::RuntimeCache::propNames<{struct_namespace}>(rt, {{{}}});\n",
+                    prop_names.join(", ")
+                )
+            };
+
             let get_props = get_props.join("\n");
             let from_js_stmts = from_js_stmts.join("\n");
             let from_js_ident = indent_str(&from_js_ident.join(",\n"), 2);
             let from_js_impl = formatdoc! {
                 r#"
-                auto obj = value.asObject(rt);
+                {props_stmt}auto obj = value.asObject(rt);
                 {get_props}
     
                 {from_js_stmts}
@@ -766,7 +1253,7 @@ pub mod template {
             let set_props = set_props.join("\n");
             let to_js_impl = formatdoc! {
                 r#"
-                jsi::Object obj = jsi::Object(rt);
+                {props_stmt}jsi::Object obj = jsi::Object(rt);
                 {to_js_stmts}
     
                 {set_props}
@@ -774,10 +1261,176 @@ pub mod template {
                 return jsi::Value(rt, obj);"#,
             };
 
+            if obj.lazy {
+                return Self::try_into_lazy_struct_template(
+                    cxx_ns,
+                    obj,
+                    struct_namespace,
+                    from_js_impl,
+                    &prop_names,
+                );
+            }
+
+            Ok(CxxBridgingTemplate {
+                namespace: struct_namespace,
+                from_js: from_js_impl,
+                to_js: to_js_impl,
+                members: None,
+            })
+        }
+
+        /// Generates C++ bridging template for `@lazy` struct types.
+        ///
+        /// The struct is returned to JS as a `StructHostObject` that keeps the C++ value
+        /// and converts a field only when it is read. Host objects passed back from JS are unwrapped without conversion.
+        /// A field is found by its name (`fieldIndex`) and converted by its index (`getField`).
+        ///
+        /// # Generated Code
+        ///
+        /// ```cpp
+        /// template <>
+        /// struct Bridging<craby::mymodule::bridging::MyStruct> {
+        ///   static craby::mymodule::bridging::MyStruct fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+        ///     if (value.isObject()) {
+        ///       auto obj = value.getObject(rt);
+        ///       if (obj.isHostObject<craby::mymodule::utils::StructHostObject<craby::mymodule::bridging::MyStruct>>(rt)) {
+        ///         return obj.getHostObject<craby::mymodule::utils::StructHostObject<craby::mymodule::bridging::MyStruct>>(rt)->value();
+        ///       }
+        ///     }
+        ///     // Same as the plain struct
+        ///   }
+        ///
+        ///   static jsi::Value toJs(jsi::Runtime &rt, craby::mymodule::bridging::MyStruct value) {
+        ///     auto hostObject = std::make_shared<craby::mymodule::utils::StructHostObject<craby::mymodule::bridging::MyStruct>>(std::move(value));
+        ///     return jsi::Object::createFromHostObject(rt, hostObject);
+        ///   }
+        ///
+        ///   static std::shared_ptr<const craby::mymodule::utils::RuntimeCache::Table> fieldNames(jsi::Runtime &rt) {
+        ///     return craby::mymodule::utils::RuntimeCache::propNames<craby::mymodule::bridging::MyStruct>(rt, {"foo", "bar"});
+        ///   }
+        ///
+        ///   static std::optional<size_t> fieldIndex(std::string_view name) {
+        ///     static const std::unordered_map<std::string_view, size_t> indices = {{"foo", 0}, {"bar", 1}};
+        ///     auto it = indices.find(name);
+        ///     return it != indices.end() ? std::optional<size_t>(it->second) : std::nullopt;
+        ///   }
+        ///
+        ///   static jsi::Value getField(jsi::Runtime &rt, const craby::mymodule::bridging::MyStruct& value, size_t index) {
+        ///     switch (index) {
+        ///       case 0:
+        ///         return react::bridging::toJs(rt, value.foo);
+        ///       case 1: {
+        ///         auto field = value.bar;
+        ///         return react::bridging::toJs(rt, std::move(field));
+        ///       }
+        ///       default:
+        ///         return jsi::Value::undefined();
+        ///     }
+        ///   }
+        /// };
+        /// ```
+        fn try_into_lazy_struct_template(
+            cxx_ns: &CxxNamespace,
+            obj: &ObjectTypeAnnotation,
+            struct_namespace: String,
+            from_js_impl: String,
+            prop_names: &[String],
+        ) -> Result<CxxBridgingTemplate, anyhow::Error> {
+            let host_object = format!("{cxx_ns}::utils::StructHostObject<{struct_namespace}>");
+            let from_js_impl = formatdoc! {
+                r#"
+                if (value.isObject()) {{
+                  auto obj = value.getObject(rt);
+                  if (obj.isHostObject<{host_object}>(rt)) {{
+                    return obj.getHostObject<{host_object}>(rt)->value();
+                  }}
+                }}
+
+                {from_js_impl}"#,
+            };
+
+            let to_js_impl = formatdoc! {
+                r#"
+                auto hostObject = std::make_shared<{host_object}>(std::move(value));
+                return jsi::Object::createFromHostObject(rt, hostObject);"#,
+            };
+
+            // ```cpp
+            // case 0:
+            //   return react::bridging::toJs(rt, value.name);
+            // case 1: {
+            //   auto field = value.sub;
+            //   return react::bridging::toJs(rt, std::move(field));
+            // }
+            // ```
+            let field_cases = obj
+                .props
+                .iter()
+                .enumerate()
+                .map(|(idx, prop)| -> Result<String, anyhow::Error> {
+                    let field = snake_case(&prop.name);
+                    match &prop.type_annotation {
+                        // Converted from a reference to the field, without copying it
+                        TypeAnnotation::String
+                        | TypeAnnotation::Boolean
+                        | TypeAnnotation::Number
+                        | TypeAnnotation::Enum(..) => Ok(formatdoc! {
+                            r#"
+                            case {idx}:
+                              return react::bridging::toJs(rt, value.{field});"#,
+                        }),
+                        // The host object keeps its value, so a field moved into its JS value is copied first
+                        type_annotation => {
+                            let to_js = type_annotation.as_cxx_to_js(cxx_ns, "field")?;
+                            Ok(formatdoc! {
+                                r#"
+                                case {idx}: {{
+                                  auto field = value.{field};
+                                  return {to_js};
+                                }}"#,
+                                to_js = to_js.expr,
+                            })
+                        }
+                    }
+                })
+                .collect::<Result<Vec<_>, _>>()?
+                .join("\n");
+
+            // {"name", 0}, {"sub", 1}
+            let field_indices = prop_names
+                .iter()
+                .enumerate()
+                .map(|(idx, name)| format!("{{{name}, {idx}}}"))
+                .collect::<Vec<_>>()
+                .join(", ");
+            let prop_names = prop_names.join(", ");
+            let field_cases = indent_str(&field_cases, 4);
+            let members = formatdoc! {
+                r#"
+                static std::shared_ptr<const {cxx_ns}::utils::RuntimeCache::Table> fieldNames(jsi::Runtime &rt) {{
+                  return {cxx_ns}::utils::RuntimeCache::propNames<{struct_namespace}>(rt, {{{prop_names}}});
+                }}
+
+                static std::optional<size_t> fieldIndex(std::string_view name) {{
+                  static const std::unordered_map<std::string_view, size_t> indices = {{{field_indices}}};
+                  auto it = indices.find(name);
+                  return it != indices.end() ? std::optional<size_t>(it->second) : std::nullopt;
+                }}
+
+                static jsi::Value getField(jsi::Runtime &rt, const {struct_namespace}& value, size_t index) {{
+                  switch (index) {{
+                {field_cases}
+                    default:
+                      return jsi::Value::undefined();
+                  }}
+                }}"#,
+            };
+
             Ok(CxxBridgingTemplate {
                 namespace: struct_namespace,
                 from_js: from_js_impl,
                 to_js: to_js_impl,
+                members: Some(members),
             })
         }
 
@@ -788,7 +1441,7 @@ pub mod template {
         /// ```cpp
         /// template <>
         /// struct Bridging<craby::mymodule::bridging::MyEnum> {
-        ///   static craby::mymodule::bridging::MyEnum fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+        ///   static craby::mymodule::bridging::MyEnum fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
         ///     auto raw = value.asString(rt).utf8(rt);
         ///     if (raw == "foo") {
         ///       return craby::mymodule::bridging::MyEnum::Foo;
@@ -955,6 +1608,7 @@ pub mod template {
                 namespace: enum_namespace,
                 from_js: from_js_impl,
                 to_js: to_js_impl,
+                members: None,
             })
         }
 
@@ -965,13 +1619,13 @@ pub mod template {
         /// ```cpp
         /// template <>
         /// struct Bridging<craby::mymodule::bridging::NullableNumber> {
-        ///   static craby::mymodule::bridging::NullableNumber fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+        ///   static craby::mymodule::bridging::NullableNumber fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
         ///     if (value.isNull()) {
         ///       return craby::mymodule::bridging::NullableNumber{true, 0.0};
         ///     }
         ///
         ///     auto val = react::bridging::fromJs<double>(rt, value, callInvoker);
-        ///     auto ret = craby::mymodule::bridging::NullableNumber{false, val};
+        ///     auto ret = craby::mymodule::bridging::NullableNumber{false, std::move(val)};
         ///
         ///     return ret;
         ///   }
@@ -981,7 +1635,7 @@ pub mod template {
         ///       return jsi::Value::null();
         ///     }
         ///
-        ///     return react::bridging::toJs(rt, value.val);
+        ///     return react::bridging::toJs(rt, std::move(value.val));
         ///   }
         /// };
         /// ```
@@ -1001,7 +1655,7 @@ pub mod template {
                 }}
 
                 auto val = react::bridging::fromJs<{origin_namespace}>(rt, value, callInvoker);
-                auto ret = {nullable_type_namespace}{{false, val}};
+                auto ret = {nullable_type_namespace}{{false, std::move(val)}};
 
                 return ret;"#,
             };
@@ -1012,13 +1666,14 @@ pub mod template {
                   return jsi::Value::null();
                 }}
 
-                return react::bridging::toJs(rt, value.val);"#,
+                return react::bridging::toJs(rt, std::move(value.val));"#,
             };
 
             Ok(CxxBridgingTemplate {
                 namespace: nullable_type_namespace.clone(),
                 from_js: from_js_impl,
                 to_js: to_js_impl,
+                members: None,
             })
         }
     }
@@ -1046,4 +1701,24 @@ pub mod template {
     pub fn cxx_arg_var(idx: usize) -> String {
         format!("arg{idx}")
     }
+
+    /// Generates the C++ arguments of the FFI call, moving the owned values into it.
+    ///
+    /// # Generated Code
+    ///
+    /// ```cpp
+    /// *it_, arg0, std::move(arg1)
+    /// ```
+    pub fn cxx_call_args(args: &[(String, bool)]) -> String {
+        std::iter::once(format!("*{RESERVED_ARG_NAME_MODULE}"))
+            .chain(args.iter().map(|(arg, owned)| {
+                if *owned {
+                    format!("std::move({arg})")
+                } else {
+                    arg.clone()
+                }
+            }))
+            .collect::<Vec<_>>()
+            .join(", ")
+    }
 }
@@ -11,9 +11,10 @@ use crate::{
     constants::specs::RESERVED_ARG_NAME_MODULE,
     parser::types::{
         EnumTypeAnnotation, Method, ObjectTypeAnnotation, Param, RefTypeAnnotation, TypeAnnotation,
+        TypedArrayKind,
     },
     platform::rust::template::{
-        collect_alias_default_impls, RsDefaultImpl, RsNullableStruct, RsStruct,
+        collect_alias_default_impls, shared_fields_impl, RsDefaultImpl, RsNullableStruct, RsStruct,
     },
     types::Schema,
     utils::indent_str,
@@ -99,6 +100,27 @@ pub struct RsCxxBridge {
     pub func_impls: Vec<String>,
 }
 
+impl TypedArrayKind {
+    /// Returns the Rust element type of the typed array.
+    ///
+    /// ```rust,ignore
+    /// f64 // Float64Array
+    /// f32 // Float32Array
+    /// i32 // Int32Array
+    /// i16 // Int16Array
+    /// u8  // Uint8Array
+    /// ```
+    pub fn as_rs_elem_type(&self) -> &'static str {
+        match self {
+            TypedArrayKind::Float64 => "f64",
+            TypedArrayKind::Float32 => "f32",
+            TypedArrayKind::Int32 => "i32",
+            TypedArrayKind::Int16 => "i16",
+            TypedArrayKind::Uint8 => "u8",
+        }
+    }
+}
+
 impl TypeAnnotation {
     /// Converts TypeAnnotation to Rust type representation.
     ///
@@ -108,11 +130,15 @@ impl TypeAnnotation {
     /// bool                          // Boolean
     /// f64                           // Number
     /// String                        // String
-    /// Vec<f64>                      // Array<Number>
+    /// Vec<f64>                      // Array<Number>, LazyArray<Number>
+    /// Vec<f64>                      // Float64Array
     /// MyEnum                        // Enum
     /// MyStruct                      // Object
     /// NullableNumber                // Nullable<Number>
     /// Result<f64, anyhow::Error>    // Promise<Number>
+    /// Box<ByteStream>               // ByteStream
+    /// Box<MappedFile>               // MappedFile
+    /// Box<SharedMemory>             // SharedState<MyStruct>
     /// ```
     pub fn as_rs_type(&self) -> Result<RsType, anyhow::Error> {
         let rs_type = match self {
@@ -121,8 +147,10 @@ impl TypeAnnotation {
             TypeAnnotation::Number => "f64".to_string(),
             TypeAnnotation::String => "String".to_string(),
             TypeAnnotation::ArrayBuffer => "Vec<u8>".to_string(),
-            TypeAnnotation::Array(element_type) => {
-                if let TypeAnnotation::Array(..) = &**element_type {
+            TypeAnnotation::TypedArray(kind) => format!("Vec<{}>", kind.as_rs_elem_type()),
+            TypeAnnotation::Array(element_type) | TypeAnnotation::LazyArray(element_type) => {
+                if let TypeAnnotation::Array(..) | TypeAnnotation::TypedArray(..) = &**element_type
+                {
                     return Err(anyhow::anyhow!(
                         "Nested array type is not supported: {:?}",
                         element_type
@@ -132,6 +160,10 @@ impl TypeAnnotation {
             }
             TypeAnnotation::Object(ObjectTypeAnnotation { name, .. }) => name.clone(),
             TypeAnnotation::Enum(EnumTypeAnnotation { name, .. }) => name.clone(),
+            // Opaque Rust type, owned by the C++ side
+            TypeAnnotation::ByteStream => "Box<ByteStream>".to_string(),
+            TypeAnnotation::MappedFile => "Box<MappedFile>".to_string(),
+            TypeAnnotation::SharedState(..) => "Box<SharedMemory>".to_string(),
             TypeAnnotation::Promise(resolve_type) => {
                 format!(
                     "Result<{}, anyhow::Error>",
@@ -220,9 +252,14 @@ impl TypeAnnotation {
     /// Number           // Number (aliased f64)
     /// String           // String
     /// ArrayBuffer      // ArrayBuffer (aliased Vec<u8>)
-    /// Array<Number>    // Array<Number>
+    /// Float64Array     // Float64Array (aliased Vec<f64>)
+    /// Array<Number>    // Array<Number>, LazyArray<Number>
     /// Promise<Number>  // Promise<Number>
     /// Nullable<Number> // Nullable<Number>
+    /// ByteStream       // ByteStream
+    /// MappedFile       // MappedFile
+    /// AbortSignal      // AbortSignal
+    /// SharedState<MyStruct> // SharedState<MyStruct>
     /// ```
     pub fn as_rs_impl_type(&self) -> Result<RsImplType, anyhow::Error> {
         let rs_type = match self {
@@ -231,8 +268,11 @@ impl TypeAnnotation {
             TypeAnnotation::Number => "Number".to_string(),
             TypeAnnotation::String => "String".to_string(),
             TypeAnnotation::ArrayBuffer => "ArrayBuffer".to_string(),
-            TypeAnnotation::Array(element_type) => {
-                if let TypeAnnotation::Array { .. } = &**element_type {
+            TypeAnnotation::TypedArray(kind) => kind.js_name().to_string(),
+            TypeAnnotation::Array(element_type) | TypeAnnotation::LazyArray(element_type) => {
+                if let TypeAnnotation::Array { .. } | TypeAnnotation::TypedArray(..) =
+                    &**element_type
+                {
                     return Err(anyhow::anyhow!(
                         "Nested array type is not supported: {:?}",
                         element_type
@@ -249,6 +289,12 @@ impl TypeAnnotation {
                 let type_annotation = type_annotation.as_rs_impl_type()?.into_code();
                 format!("Nullable<{type_annotation}>")
             }
+            TypeAnnotation::ByteStream => "ByteStream".to_string(),
+            TypeAnnotation::MappedFile => "MappedFile".to_string(),
+            TypeAnnotation::AbortSignal => "AbortSignal".to_string(),
+            TypeAnnotation::SharedState(state_type) => {
+                format!("SharedState<{}>", state_type.as_rs_impl_type()?.into_code())
+            }
             TypeAnnotation::Ref(..) => unreachable!(),
         };
         Ok(RsImplType(rs_type))
@@ -272,7 +318,10 @@ impl TypeAnnotation {
             TypeAnnotation::Boolean => "false".to_string(),
             TypeAnnotation::Number => "0.0".to_string(),
             TypeAnnotation::String => "String::default()".to_string(),
-            TypeAnnotation::ArrayBuffer | TypeAnnotation::Array(..) => "Vec::default()".to_string(),
+            TypeAnnotation::ArrayBuffer
+            | TypeAnnotation::TypedArray(..)
+            | TypeAnnotation::Array(..)
+            | TypeAnnotation::LazyArray(..) => "Vec::default()".to_string(),
             TypeAnnotation::Enum(EnumTypeAnnotation { name, .. }) => {
                 format!("{name}::default()")
             }
@@ -303,14 +352,29 @@ impl Method {
     /// ```rust,ignore
     /// fn multiply(&mut self, a: Number, b: Number) -> Number
     /// fn add_async(&mut self, a: Number, b: Number) -> Promise<Number>
+    /// fn compute(&self, a: Number) -> Promise<Number> // `@executor concurrent`
+    /// fn fetch(&mut self, a: Number) -> AsyncPromise<Number> // `@executor async`
     /// ```
     pub fn try_into_impl_sig(&self) -> Result<String, anyhow::Error> {
-        let return_type = self.ret_type.as_rs_impl_type()?.into_code();
-        let params_sig = std::iter::once("&mut self".to_string())
+        let return_type = match &self.ret_type {
+            TypeAnnotation::Promise(resolve_type) if self.is_future() => {
+                format!(
+                    "AsyncPromise<{}>",
+                    resolve_type.as_rs_impl_type()?.into_code()
+                )
+            }
+            ret_type => ret_type.as_rs_impl_type()?.into_code(),
+        };
+        let receiver = if self.is_shared() {
+            "&self"
+        } else {
+            "&mut self"
+        };
+        let params_sig = std::iter::once(receiver.to_string())
             .chain(
                 self.params
                     .iter()
-                    .map(|param| param.try_into_impl_sig())
+                    .map(|param| param.try_into_impl_sig(self.is_async()))
                     .collect::<Result<Vec<_>, _>>()?,
             )
             .collect::<Vec<_>>()
@@ -334,14 +398,24 @@ impl Param {
     ///
     /// ```rust,ignore
     /// a: f64
-    /// name: String
+    /// name: &str
+    /// data: &mut [u8]  // ArrayBuffer (sync methods)
+    /// data: Vec<u8>    // ArrayBuffer (async methods)
+    /// data: &mut [f64] // Float64Array (sync methods)
     /// items: Vec<MyStruct>
+    /// signal: &AbortSignal
     /// ```
-    pub fn try_into_cxx_sig(&self) -> Result<String, anyhow::Error> {
-        let param_type = if let TypeAnnotation::String = &self.type_annotation {
-            "&str".to_string()
-        } else {
-            self.type_annotation.as_rs_type()?.into_code()
+    pub fn try_into_cxx_sig(&self, is_async: bool) -> Result<String, anyhow::Error> {
+        let param_type = match &self.type_annotation {
+            TypeAnnotation::String => "&str".to_string(),
+            // Owned by the C++ side, shared with the `abort` listener of the JS `AbortSignal`
+            TypeAnnotation::AbortSignal => "&AbortSignal".to_string(),
+            // Sync methods borrow the JS `ArrayBuffer` memory for the duration of the call
+            TypeAnnotation::ArrayBuffer if !is_async => "&mut [u8]".to_string(),
+            TypeAnnotation::TypedArray(kind) if !is_async => {
+                format!("&mut [{}]", kind.as_rs_elem_type())
+            }
+            _ => self.type_annotation.as_rs_type()?.into_code(),
         };
         Ok(format!("{}: {}", snake_case(&self.name), param_type))
     }
@@ -352,14 +426,21 @@ impl Param {
     ///
     /// ```rust,ignore
     /// a: Number
-    /// name: String
+    /// name: &str
+    /// data: &mut [u8]    // ArrayBuffer (sync methods)
+    /// data: ArrayBuffer  // ArrayBuffer (async methods)
+    /// data: &mut [f64]   // Float64Array (sync methods)
     /// items: Array<MyStruct>
+    /// signal: AbortSignal
     /// ```
-    pub fn try_into_impl_sig(&self) -> Result<String, anyhow::Error> {
-        let param_type = if let TypeAnnotation::String = &self.type_annotation {
-            "&str".to_string()
-        } else {
-            self.type_annotation.as_rs_impl_type()?.into_code()
+    pub fn try_into_impl_sig(&self, is_async: bool) -> Result<String, anyhow::Error> {
+        let param_type = match &self.type_annotation {
+            TypeAnnotation::String => "&str".to_string(),
+            TypeAnnotation::ArrayBuffer if !is_async => "&mut [u8]".to_string(),
+            TypeAnnotation::TypedArray(kind) if !is_async => {
+                format!("&mut [{}]", kind.as_rs_elem_type())
+            }
+            _ => self.type_annotation.as_rs_impl_type()?.into_code(),
         };
         Ok(format!("{}: {}", snake_case(&self.name), param_type))
     }
@@ -440,29 +521,48 @@ impl Schema {
             }
 
             let ret_type = method_spec.ret_type.as_rs_type()?.into_code();
-            let ret_type = match method_spec.ret_type {
-                TypeAnnotation::Promise(_) => ret_type,
-                _ => format!("Result<{ret_type}, anyhow::Error>"),
-            };
             let ret_extern_type = method_spec.ret_type.as_rs_bridge_type()?.into_code();
-            let ret_extern_type = match method_spec.ret_type {
-                TypeAnnotation::Promise(_) => ret_extern_type,
-                _ => format!("Result<{ret_extern_type}>"),
+            // Futures are spawned by the FFI function, their results are taken by `{fn}Result` once ready
+            let ret_future = if method_spec.is_future() {
+                Some((ret_type.clone(), ret_extern_type.clone()))
+            } else {
+                None
+            };
+            let (ret_type, ret_extern_type) = match method_spec.ret_type {
+                // `@pure` methods return the value as is, a panic aborts the process (no unwinding across the FFI)
+                _ if method_spec.pure => (ret_type, ret_extern_type),
+                TypeAnnotation::Promise(_) if method_spec.is_future() => (
+                    "Result<(), anyhow::Error>".to_string(),
+                    "Result<()>".to_string(),
+                ),
+                TypeAnnotation::Promise(_) => (ret_type, ret_extern_type),
+                _ => (
+                    format!("Result<{ret_type}, anyhow::Error>"),
+                    format!("Result<{ret_extern_type}>"),
+                ),
             };
 
             let params_sig = method_spec
                 .params
                 .iter()
-                .map(|param| param.try_into_cxx_sig())
+                .map(|param| param.try_into_cxx_sig(method_spec.is_async()))
                 .collect::<Result<Vec<_>, _>>()
                 .map(|mut params| {
                     params.insert(
                         0,
                         format!(
-                            "{RESERVED_ARG_NAME_MODULE}: &mut {}",
+                            "{RESERVED_ARG_NAME_MODULE}: {}{}",
+                            if method_spec.is_shared() {
+                                "&"
+                            } else {
+                                "&mut "
+                            },
                             pascal_case(&self.module_name)
                         ),
                     );
+                    if method_spec.is_future() {
+                        params.push("op: usize".to_string());
+                    }
                     params.join(", ")
                 })?;
 
@@ -473,32 +573,55 @@ impl Schema {
                 .iter()
                 .map(|param| {
                     let name = snake_case(&param.name);
-                    if let TypeAnnotation::Nullable(..) = &param.type_annotation {
-                        format!("{name}.into()")
-                    } else {
-                        name
+                    match &param.type_annotation {
+                        TypeAnnotation::Nullable(..) => format!("{name}.into()"),
+                        TypeAnnotation::AbortSignal => format!("{name}.clone()"),
+                        _ => name,
                     }
                 })
                 .collect::<Vec<_>>();
 
             let cxx_extern_fn_name = camel_case(&method_spec.name);
             let prefixed_fn_name = format!("{mod_name}_{fn_name}");
-            let ret_extern_annotation = format!(" -> {ret_extern_type}");
-            let ret_annotation = format!(" -> {ret_type}");
+            let (ret_extern_annotation, ret_annotation) = match method_spec.ret_type {
+                TypeAnnotation::Void if method_spec.pure => (String::new(), String::new()),
+                _ => (format!(" -> {ret_extern_type}"), format!(" -> {ret_type}")),
+            };
             let extern_func = formatdoc! {
                 r#"
                 #[cxx_name = "{cxx_extern_fn_name}"]
                 fn {prefixed_fn_name}({params_sig}){ret_extern_annotation};"#,
             };
 
-            let ret = if let TypeAnnotation::Nullable(..) = &method_spec.ret_type {
-                "ret.into()"
-            } else {
-                "ret"
+            let ret = match &method_spec.ret_type {
+                TypeAnnotation::Nullable(..) => "ret.into()",
+                TypeAnnotation::ByteStream | TypeAnnotation::MappedFile => "Box::new(ret)",
+                TypeAnnotation::SharedState(..) => "Box::new(ret.into())",
+                _ => "ret",
             };
 
             let fn_args = fn_args.join(", ");
             let impl_func = match method_spec.ret_type {
+                _ if method_spec.pure => formatdoc! {
+                    r#"
+                    fn {prefixed_fn_name}({params_sig}){ret_annotation} {{
+                        {it}.{fn_name}({fn_args})
+                    }}"#,
+                    it = RESERVED_ARG_NAME_MODULE,
+                },
+                TypeAnnotation::Promise(_) if method_spec.is_future() => formatdoc! {
+                    r#"
+                    fn {prefixed_fn_name}({params_sig}){ret_annotation} {{
+                        craby::catch_panic!({{
+                            let ret = {it}.{fn_name}({fn_args});
+                            craby::executor::spawn_promise(ret, move |ret: {ret_type}| {{
+                                on_future_ready(op, Box::into_raw(Box::new(ret)) as usize);
+                            }});
+                        }})
+                    }}"#,
+                    it = RESERVED_ARG_NAME_MODULE,
+                    ret_type = ret_future.as_ref().unwrap().0,
+                },
                 TypeAnnotation::Promise(_) => formatdoc! {
                     r#"
                     fn {prefixed_fn_name}({params_sig}){ret_annotation} {{
@@ -523,6 +646,32 @@ impl Schema {
 
             func_extern_sigs.push(extern_func);
             func_impls.push(impl_func);
+
+            if let Some((ret_type, ret_extern_type)) = ret_future {
+                func_extern_sigs.push(formatdoc! {
+                    r#"
+                    #[cxx_name = "{cxx_extern_fn_name}Result"]
+                    fn {prefixed_fn_name}_result(ret: usize) -> {ret_extern_type};"#,
+                });
+                func_impls.push(formatdoc! {
+                    r#"
+                    fn {prefixed_fn_name}_result(ret: usize) -> {ret_type} {{
+                        // Leaked by `{prefixed_fn_name}` when the future is ready, taken once by its `FutureOp`
+                        *unsafe {{ Box::from_raw(ret as *mut {ret_type}) }}
+                    }}"#,
+                });
+            }
+        }
+
+        // `concurrent` methods borrow the module from multiple threads at the same time
+        if self.methods.iter().any(|method| method.is_shared()) {
+            func_impls.push(formatdoc! {
+                r#"
+                const _: fn() = || {{
+                    fn assert_sync<T: Sync>() {{}}
+                    assert_sync::<{module_name}>();
+                }};"#,
+            });
         }
 
         // Collect alias types (struct)
@@ -624,6 +773,14 @@ impl Schema {
                 }
             }
 
+            // Collect the fields of the shared state type
+            if let TypeAnnotation::SharedState(state_type) = &method_spec.ret_type {
+                let id = method_spec.ret_type.to_id();
+                if let BTreeMapEntry::Vacant(e) = type_impls.entry(id) {
+                    e.insert(shared_fields_impl(state_type.as_object().unwrap()));
+                }
+            }
+
             // Collect nullable return type
             if method_spec.ret_type.is_nullable() {
                 let id = method_spec.ret_type.to_id();
@@ -720,6 +877,61 @@ pub mod template {
         }
     }
 
+    /// Generates the `SharedFields` implementation of the object type of a `SharedState<T>` (`number` fields only).
+    ///
+    /// ```rust,ignore
+    /// impl craby::shared::SharedFields for MyStruct {
+    ///     const COUNT: usize = 2;
+    ///
+    ///     fn store_fields(&self, mut store: impl FnMut(usize, f64)) {
+    ///         store(0, self.foo);
+    ///         store(1, self.bar);
+    ///     }
+    ///
+    ///     fn load_fields(mut load: impl FnMut(usize) -> f64) -> Self {
+    ///         MyStruct {
+    ///             foo: load(0),
+    ///             bar: load(1),
+    ///         }
+    ///     }
+    /// }
+    /// ```
+    pub fn shared_fields_impl(obj: &ObjectTypeAnnotation) -> String {
+        let (stores, loads): (Vec<_>, Vec<_>) = obj
+            .props
+            .iter()
+            .enumerate()
+            .map(|(idx, prop)| {
+                let name = snake_case(&prop.name);
+                (
+                    format!("store({idx}, self.{name});"),
+                    format!("{name}: load({idx}),"),
+                )
+            })
+            .unzip();
+
+        formatdoc! {
+            r#"
+            impl craby::shared::SharedFields for {name} {{
+                const COUNT: usize = {count};
+
+                fn store_fields(&self, mut store: impl FnMut(usize, f64)) {{
+            {stores}
+                }}
+
+                fn load_fields(mut load: impl FnMut(usize) -> f64) -> Self {{
+                    {name} {{
+            {loads}
+                    }}
+                }}
+            }}"#,
+            name = obj.name,
+            count = obj.props.len(),
+            stores = indent_str(&stores.join("\n"), 8),
+            loads = indent_str(&loads.join("\n"), 12),
+        }
+    }
+
     /// Rust struct definition for nullable types.
     pub struct RsNullableStruct {
         pub definition: String,
@@ -5,7 +5,7 @@ use crate::{parser::native_spec_parser::try_parse_schema, types::CodegenContext}
 pub fn get_codegen_context() -> CodegenContext {
     let schemas = try_parse_schema(
         "
-        import type { NativeModule, Signal } from 'craby-modules';
+        import type { ByteStream, LazyArray, MappedFile, NativeModule, SharedState, Signal } from 'craby-modules';
         import { NativeModuleRegistry } from 'craby-modules';
 
         export interface TestObject {
@@ -18,6 +18,7 @@ pub fn get_codegen_context() -> CodegenContext {
             snake_case: number;
         }
 
+        /** @lazy */
         export type SubObject = {
             a: string | null;
             b: number;
@@ -26,6 +27,11 @@ pub fn get_codegen_context() -> CodegenContext {
 
         export type MaybeNumber = number | null;
 
+        export type Point = {
+            x: number;
+            y: number;
+        };
+
         export enum MyEnum {
             Foo = 'foo',
             Bar = 'bar',
@@ -44,13 +50,30 @@ pub fn get_codegen_context() -> CodegenContext {
             objectMethod(arg: TestObject): TestObject;
             arrayBufferMethod(arg: ArrayBuffer): ArrayBuffer;
             arrayMethod(arg: number[]): number[];
+            typedArrayMethod(arg: Float64Array): Float64Array;
+            lazyArrayMethod(arg: number): LazyArray<SubObject>;
+            streamMethod(arg: string): ByteStream;
+            mappedFileMethod(arg: string): MappedFile;
+            sharedStateMethod(): SharedState<Point>;
             enumMethod(arg0: MyEnum, arg1: SwitchState): string;
             nullableMethod(arg: number | null): MaybeNumber;
             promiseMethod(arg: number): Promise<number>;
+            /** @executor concurrent */
+            concurrentMethod(arg: number): Promise<number>;
+            /** @executor js-thread */
+            jsThreadMethod(arg: number): Promise<number>;
+            abortableMethod(arg: number, signal: AbortSignal): Promise<number>;
+            /** @executor async */
+            asyncMethod(arg: string): Promise<number>;
+            scalarMethod(arg0: number, arg1: boolean): number;
             camelMethod(firstArg: number, secondArg: number): number;
             PascalMethod(FirstArg: number, SecondArg: number): number;
             snakeMethod(first_arg: number, second_arg: number): number;
             onSignal: Signal;
+            /** @delivery latest */
+            onLatestSignal: Signal<SubObject>;
+            /** @delivery batch */
+            onBatchSignal: Signal<SubObject>;
         }
 
         export default NativeModuleRegistry.getEnforcing<Spec>('CrabyTest');
@@ -63,5 +86,8 @@ pub fn get_codegen_context() -> CodegenContext {
         root: PathBuf::from("."),
         schemas,
         android_package_name: "rs.craby.testmodule".to_string(),
+        stats: false,
+        executor: Default::default(),
+        lto: false,
     }
 }
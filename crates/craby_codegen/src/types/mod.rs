@@ -1,7 +1,10 @@
 use std::{fmt::Display, hash::Hasher, path::PathBuf};
 
 use crate::parser::types::{Method, Signal, TypeAnnotation};
-use craby_common::utils::string::{flat_case, pascal_case};
+use craby_common::{
+    config::ExecutorConfig,
+    utils::string::{flat_case, pascal_case},
+};
 use log::debug;
 use serde::Serialize;
 use xxhash_rust::xxh3::Xxh3;
@@ -11,6 +14,12 @@ pub struct CodegenContext {
     pub root: PathBuf,
     pub schemas: Vec<Schema>,
     pub android_package_name: String,
+    /// Instruments the generated modules for `__crabyStats()` (`[codegen] stats` of `craby.toml`)
+    pub stats: bool,
+    /// Worker threads of the generated `Executor` (`[executor]` of `craby.toml`)
+    pub executor: ExecutorConfig,
+    /// Links the Android library with cross-language LTO (`[build] lto` of `craby.toml`)
+    pub lto: bool,
 }
 
 #[derive(Debug, Serialize)]
@@ -32,6 +41,61 @@ impl Schema {
         hasher.write(serialized.as_bytes());
         format!("{:016x}", hasher.finish())
     }
+
+    /// Returns `true` if any method of the schemas returns a `SharedState<T>`.
+    pub fn has_shared_states(schemas: &[Schema]) -> bool {
+        schemas.iter().any(|schema| {
+            schema
+                .methods
+                .iter()
+                .any(|method| matches!(method.ret_type, TypeAnnotation::SharedState(..)))
+        })
+    }
+
+    /// Returns `true` if any method of the schemas returns a `ByteStream`.
+    pub fn has_byte_streams(schemas: &[Schema]) -> bool {
+        schemas.iter().any(|schema| {
+            schema
+                .methods
+                .iter()
+                .any(|method| method.ret_type == TypeAnnotation::ByteStream)
+        })
+    }
+
+    /// Returns `true` if any method of the schemas returns a `MappedFile`.
+    pub fn has_mapped_files(schemas: &[Schema]) -> bool {
+        schemas.iter().any(|schema| {
+            schema
+                .methods
+                .iter()
+                .any(|method| method.ret_type == TypeAnnotation::MappedFile)
+        })
+    }
+
+    /// Returns `true` if any method of the schemas returns a future (`@executor async`).
+    pub fn has_futures(schemas: &[Schema]) -> bool {
+        schemas
+            .iter()
+            .any(|schema| schema.methods.iter().any(|method| method.is_future()))
+    }
+
+    /// Returns `true` if the calls of the module on the JS thread take the module state lock,
+    /// which is only the case for modules with `@executor serial` or `concurrent` methods.
+    pub fn locks_state(&self) -> bool {
+        self.methods.iter().any(|method| method.is_locked())
+    }
+
+    /// Returns `true` if any method of the schemas has an `AbortSignal` parameter.
+    pub fn has_abort_signals(schemas: &[Schema]) -> bool {
+        schemas.iter().any(|schema| {
+            schema.methods.iter().any(|method| {
+                method
+                    .params
+                    .iter()
+                    .any(|param| param.type_annotation == TypeAnnotation::AbortSignal)
+            })
+        })
+    }
 }
 
 /// Represents the C++ base namespace for the Craby project.
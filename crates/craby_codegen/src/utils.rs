@@ -126,6 +126,58 @@ pub fn calc_deps_order(schema: &Schema) -> Result<Vec<String>, anyhow::Error> {
     Ok(result)
 }
 
+/// FNV-1a hash of the name, the same as `hashName()` of the generated C++ modules.
+pub fn fnv1a_hash(name: &str, seed: u32) -> u32 {
+    name.bytes().fold(2166136261 ^ seed, |hash, byte| {
+        (hash ^ byte as u32).wrapping_mul(16777619)
+    })
+}
+
+/// Collision-free slots of the names, see [`perfect_hash`].
+#[derive(Debug)]
+pub struct PerfectHash {
+    pub seed: u32,
+    /// Slot of a name is the top bits of its hash (`hash >> shift`)
+    pub shift: u32,
+    /// Index of the name of each slot
+    pub slots: Vec<Option<usize>>,
+}
+
+impl PerfectHash {
+    pub fn slot(&self, name: &str) -> usize {
+        (fnv1a_hash(name, self.seed) >> self.shift) as usize
+    }
+}
+
+/// Finds a seed that gives each name its own slot.
+///
+/// Slots are taken from the top bits of the hash, the low bits of FNV-1a don't depend on the high bits of the seed.
+pub fn perfect_hash(names: &[&str]) -> PerfectHash {
+    let mut bits = (names.len() * 2)
+        .max(8)
+        .next_power_of_two()
+        .trailing_zeros();
+
+    loop {
+        for seed in 0..1 << 16 {
+            let mut hash = PerfectHash {
+                seed,
+                shift: 32 - bits,
+                slots: vec![None; 1 << bits],
+            };
+            let placed = names.iter().enumerate().all(|(index, name)| {
+                let slot = hash.slot(name);
+                hash.slots[slot].replace(index).is_none()
+            });
+
+            if placed {
+                return hash;
+            }
+        }
+        bits += 1;
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -135,4 +187,24 @@ mod tests {
         assert_eq!(indent_str("Hello\nWorld", 2), "  Hello\n  World");
         assert_eq!(indent_str("Hello\nWorld", 4), "    Hello\n    World");
     }
+
+    #[test]
+    fn test_perfect_hash() {
+        let names = [
+            "add",
+            "batch",
+            "divide",
+            "multiply",
+            "subtract",
+            "onProgress",
+            "__crabyStats",
+        ];
+        let hash = perfect_hash(&names);
+
+        assert_eq!(hash.slots.len(), 1 << (32 - hash.shift));
+        for (index, name) in names.iter().enumerate() {
+            assert_eq!(hash.slots[hash.slot(name)], Some(index));
+        }
+        assert_eq!(hash.slots.iter().flatten().count(), names.len());
+    }
 }
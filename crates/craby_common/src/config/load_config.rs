@@ -30,6 +30,9 @@ pub fn load_config(project_root: &Path) -> Result<CompleteConfig, anyhow::Error>
         project: config.project,
         android: config.android,
         ios: config.ios,
+        codegen: config.codegen,
+        executor: config.executor,
+        build: config.build,
         source_dir,
     })
 }
@@ -82,5 +85,21 @@ fn validate_config(config: &Config) -> Result<(), anyhow::Error> {
         ));
     }
 
+    if config.executor.threads == Some(0) {
+        anyhow::bail!("Invalid executor threads: 0 (Expected: 1 or more)");
+    }
+
+    let thread_name = &config.executor.thread_name;
+    if thread_name.is_empty()
+        || !thread_name
+            .chars()
+            .all(|c| c.is_ascii_alphanumeric() || c == '-' || c == '_')
+    {
+        anyhow::bail!(format!(
+            "Invalid executor thread name: {} (Expected: letters, numbers, `-` and `_`)",
+            thread_name
+        ));
+    }
+
     Ok(())
 }
@@ -23,6 +23,12 @@ pub struct Config {
     pub project: ProjectConfig,
     pub android: AndroidConfig,
     pub ios: IosConfig,
+    #[serde(default)]
+    pub codegen: CodegenConfig,
+    #[serde(default)]
+    pub executor: ExecutorConfig,
+    #[serde(default)]
+    pub build: BuildConfig,
 }
 
 #[derive(Debug, Deserialize, Serialize)]
@@ -42,6 +48,82 @@ pub struct IosConfig {
     pub targets: Option<Vec<String>>,
 }
 
+#[derive(Debug, Default, Deserialize, Serialize)]
+pub struct CodegenConfig {
+    /// Instruments the generated modules for `__crabyStats()`
+    #[serde(default)]
+    pub stats: bool,
+}
+
+/// Worker threads of the executor running the async methods (shared by the modules of the project)
+#[derive(Debug, Clone, Deserialize, Serialize)]
+pub struct ExecutorConfig {
+    /// Number of workers (default: one per core of the `affinity`, at least 2)
+    #[serde(default)]
+    pub threads: Option<usize>,
+    /// iOS QoS class / Android nice value of the workers
+    #[serde(default)]
+    pub priority: ThreadPriority,
+    /// Cores the workers run on (Android only)
+    #[serde(default)]
+    pub affinity: CoreAffinity,
+    /// Name prefix of the workers (eg. `craby-0`), shown in profilers and crash reports
+    #[serde(default = "default_thread_name")]
+    pub thread_name: String,
+}
+
+impl Default for ExecutorConfig {
+    fn default() -> Self {
+        ExecutorConfig {
+            threads: None,
+            priority: ThreadPriority::default(),
+            affinity: CoreAffinity::default(),
+            thread_name: default_thread_name(),
+        }
+    }
+}
+
+/// Optimizations of the release libraries built by `craby build`
+#[derive(Debug, Clone, Default, Deserialize, Serialize)]
+pub struct BuildConfig {
+    /// Cross-language LTO between the Rust library and the generated C++ (Android only)
+    #[serde(default)]
+    pub lto: bool,
+    /// Merged `.profdata` used to optimize the Rust library (PGO), relative to the project root
+    #[serde(default)]
+    pub profile_use: Option<PathBuf>,
+}
+
+fn default_thread_name() -> String {
+    "craby".to_string()
+}
+
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Deserialize, Serialize)]
+#[serde(rename_all = "kebab-case")]
+pub enum ThreadPriority {
+    /// Inherited from the creating thread
+    #[default]
+    Default,
+    /// `QOS_CLASS_USER_INITIATED` / nice `-2`
+    UserInitiated,
+    /// `QOS_CLASS_UTILITY` / nice `5`
+    Utility,
+    /// `QOS_CLASS_BACKGROUND` / nice `10`
+    Background,
+}
+
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Deserialize, Serialize)]
+#[serde(rename_all = "kebab-case")]
+pub enum CoreAffinity {
+    /// Any core
+    #[default]
+    Any,
+    /// The cores with the lowest max frequency (efficiency cores of big.LITTLE)
+    Little,
+    /// The other cores (performance cores of big.LITTLE)
+    Big,
+}
+
 #[derive(Debug)]
 pub struct CompleteConfig {
     pub project: ProjectConfig,
@@ -49,4 +131,7 @@ pub struct CompleteConfig {
     pub source_dir: PathBuf,
     pub android: AndroidConfig,
     pub ios: IosConfig,
+    pub codegen: CodegenConfig,
+    pub executor: ExecutorConfig,
+    pub build: BuildConfig,
 }
@@ -0,0 +1,420 @@
+// Headless benchmark runner for the generated TurboModules.
+//
+// Installs the modules into a Hermes runtime, calls every case of the suite script
+// and reports ns/call, p50/p99 latency and C++ heap allocations per call.
+//
+// Only `operator new` is counted: allocations of the Rust library (and `malloc` calls of C code) are not included.
+//
+// `threshold:<size>:each|bulk` compare both paths of `Bridging<rust::Vec<double>>::fromJs` around `kBulkThreshold`.
+//
+// Usage: craby-bench <suite.js> [--iterations N] [--warmup N] [--filter TEXT]
+#include "CxxCalculatorModule.hpp"
+#include "CxxCrabyTestModule.hpp"
+#include "bridging-generated.hpp"
+#include <hermes/hermes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace facebook;
+using namespace craby::crabytest::modules;
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+void *countedAlloc(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size) {
+  return countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kTaskTimeout = std::chrono::seconds(10);
+
+// Runs `invokeAsync` tasks on the benchmark (JS) thread
+class BenchCallInvoker : public react::CallInvoker {
+public:
+  void invokeAsync(react::CallFunc &&func) noexcept override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(func));
+    }
+    cv_.notify_one();
+  }
+
+  void invokeSync(react::CallFunc &&func) override {
+    func(*runtime_);
+  }
+
+  void setRuntime(jsi::Runtime *runtime) {
+    runtime_ = runtime;
+  }
+
+  // Waits for at least one task and runs all queued tasks
+  void runPending() {
+    std::deque<react::CallFunc> tasks;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!cv_.wait_for(lock, kTaskTimeout, [this] { return !tasks_.empty(); })) {
+        throw std::runtime_error("Timed out waiting for a JS thread task");
+      }
+      tasks.swap(tasks_);
+    }
+
+    for (auto &task : tasks) {
+      task(*runtime_);
+    }
+    runtime_->drainMicrotasks();
+  }
+
+private:
+  jsi::Runtime *runtime_ = nullptr;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<react::CallFunc> tasks_;
+};
+
+struct Options {
+  std::string suitePath;
+  size_t iterations = 10000;
+  size_t warmup = 1000;
+  std::string filter;
+};
+
+struct Result {
+  std::string name;
+  double nsPerCall;
+  uint64_t p50;
+  uint64_t p99;
+  double allocsPerCall;
+};
+
+Options parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    auto next = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("Missing value for " + arg);
+      }
+      return argv[++i];
+    };
+
+    if (arg == "--iterations") {
+      options.iterations = std::stoul(next());
+    } else if (arg == "--warmup") {
+      options.warmup = std::stoul(next());
+    } else if (arg == "--filter") {
+      options.filter = next();
+    } else {
+      options.suitePath = arg;
+    }
+  }
+
+  if (options.suitePath.empty() || options.iterations == 0) {
+    throw std::invalid_argument(
+      "Usage: craby-bench <suite.js> [--iterations N] [--warmup N] [--filter TEXT]");
+  }
+  return options;
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Cannot read " + path);
+  }
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+Result summarize(std::string name, std::vector<uint64_t> &samples, uint64_t allocs) {
+  std::sort(samples.begin(), samples.end());
+  uint64_t total = 0;
+  for (auto sample : samples) {
+    total += sample;
+  }
+
+  auto count = samples.size();
+  return Result{
+    std::move(name),
+    static_cast<double>(total) / count,
+    samples[count / 2],
+    samples[std::min(count - 1, count * 99 / 100)],
+    static_cast<double>(allocs) / count,
+  };
+}
+
+// Calls `fn` and waits until the returned promise (if any) is settled
+class CaseRunner {
+public:
+  CaseRunner(jsi::Runtime &rt, BenchCallInvoker &invoker) : rt_(rt), invoker_(invoker) {
+    settle_ = rt.global().getPropertyAsFunction(rt, "__crabyBenchSettle");
+    onSettled_ = jsi::Function::createFromHostFunction(
+      rt,
+      jsi::PropNameID::forAscii(rt, "onSettled"),
+      1,
+      [this](jsi::Runtime &, const jsi::Value &, const jsi::Value *, size_t) {
+        settled_ = true;
+        return jsi::Value::undefined();
+      });
+  }
+
+  void call(const jsi::Function &fn) {
+    auto result = fn.call(rt_);
+    if (!result.isObject() || !result.asObject(rt_).hasProperty(rt_, "then")) {
+      return;
+    }
+
+    settled_ = false;
+    settle_->call(rt_, result, *onSettled_);
+    rt_.drainMicrotasks();
+    while (!settled_) {
+      invoker_.runPending();
+    }
+  }
+
+private:
+  jsi::Runtime &rt_;
+  BenchCallInvoker &invoker_;
+  std::optional<jsi::Function> settle_;
+  std::optional<jsi::Function> onSettled_;
+  bool settled_ = false;
+};
+
+Result runCase(const std::string &name,
+               const jsi::Function &fn,
+               CaseRunner &runner,
+               const Options &options) {
+  for (size_t i = 0; i < options.warmup; i++) {
+    runner.call(fn);
+  }
+
+  std::vector<uint64_t> samples;
+  samples.reserve(options.iterations);
+  auto allocsBefore = allocations.load();
+  for (size_t i = 0; i < options.iterations; i++) {
+    auto start = Clock::now();
+    runner.call(fn);
+    auto end = Clock::now();
+    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+  // The samples vector is reserved up front, so it does not count here
+  auto allocs = allocations.load() - allocsBefore;
+
+  return summarize(name, samples, allocs);
+}
+
+// Signal delivery: Rust-side `emit` -> SignalManager -> module -> JS listener
+Result runSignalCase(jsi::Runtime &rt,
+                     BenchCallInvoker &invoker,
+                     CxxCrabyTestModule &module,
+                     const Options &options) {
+  size_t received = 0;
+  auto listener = jsi::Function::createFromHostFunction(
+    rt,
+    jsi::PropNameID::forAscii(rt, "listener"),
+    1,
+    [&received](jsi::Runtime &, const jsi::Value &, const jsi::Value *, size_t) {
+      received++;
+      return jsi::Value::undefined();
+    });
+  auto crabyTest = rt.global().getPropertyAsObject(rt, CxxCrabyTestModule::kModuleName);
+  auto cleanup = crabyTest.getPropertyAsFunction(rt, "onSignal")
+                   .callWithThis(rt, crabyTest, listener)
+                   .asObject(rt)
+                   .asFunction(rt);
+
+  auto &manager = craby::crabytest::signals::SignalManager::getInstance();
+  auto id = reinterpret_cast<uintptr_t>(&module);
+  auto signalId = static_cast<uint32_t>(CxxCrabyTestModule::SignalId::OnSignal);
+  auto emitOnce = [&] {
+    auto expected = received + 1;
+    manager.emit(id, signalId, nullptr);
+    while (received < expected) {
+      invoker.runPending();
+    }
+  };
+
+  for (size_t i = 0; i < options.warmup; i++) {
+    emitOnce();
+  }
+
+  std::vector<uint64_t> samples;
+  samples.reserve(options.iterations);
+  auto allocsBefore = allocations.load();
+  for (size_t i = 0; i < options.iterations; i++) {
+    auto start = Clock::now();
+    emitOnce();
+    auto end = Clock::now();
+    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+  auto allocs = allocations.load() - allocsBefore;
+
+  cleanup.call(rt);
+  return summarize("signal:onSignal", samples, allocs);
+}
+
+// `Array<Number>` -> `rust::Vec<double>` with the per-element and the bulk path, below and above `kBulkThreshold`.
+// `fromJs` takes the bulk path from the threshold on, so `bulk` should be faster there and `each` below it.
+void runArrayThresholdCases(jsi::Runtime &rt, const Options &options, std::vector<Result> &results) {
+  using NumberArray = react::Bridging<rust::Vec<double>>;
+  constexpr size_t kThreshold = NumberArray::kBulkThreshold;
+
+  for (size_t size : {kThreshold / 4, kThreshold / 2, kThreshold - 1, kThreshold, kThreshold * 2, kThreshold * 16}) {
+    auto arr = jsi::Array(rt, size);
+    for (size_t i = 0; i < size; i++) {
+      arr.setValueAtIndex(rt, i, jsi::Value(static_cast<double>(i)));
+    }
+
+    auto measure = [&](const char *path, auto convert) {
+      auto name = "threshold:" + std::to_string(size) + ":" + path;
+      if (name.find(options.filter) == std::string::npos) {
+        return;
+      }
+
+      for (size_t i = 0; i < options.warmup; i++) {
+        convert();
+      }
+
+      std::vector<uint64_t> samples;
+      samples.reserve(options.iterations);
+      auto allocsBefore = allocations.load();
+      for (size_t i = 0; i < options.iterations; i++) {
+        auto start = Clock::now();
+        auto vec = convert();
+        auto end = Clock::now();
+        if (vec.size() != size) {
+          throw std::runtime_error("Unexpected length of " + name);
+        }
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+      }
+      auto allocs = allocations.load() - allocsBefore;
+
+      results.push_back(summarize(std::move(name), samples, allocs));
+    };
+
+    measure("each", [&] { return NumberArray::fromJsEach(rt, arr); });
+    measure("bulk", [&] { return NumberArray::fromJsBulk(rt, arr); });
+  }
+}
+
+void printResults(const std::vector<Result> &results) {
+  std::printf("%-40s %12s %10s %10s %16s\n", "case", "ns/call", "p50", "p99", "C++ allocs/call");
+  for (const auto &result : results) {
+    std::printf("%-40s %12.1f %10llu %10llu %16.2f\n",
+                result.name.c_str(),
+                result.nsPerCall,
+                static_cast<unsigned long long>(result.p50),
+                static_cast<unsigned long long>(result.p99),
+                result.allocsPerCall);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    auto options = parseOptions(argc, argv);
+    auto runtime = facebook::hermes::makeHermesRuntime(
+      ::hermes::vm::RuntimeConfig::Builder().withMicrotaskQueue(true).build());
+    auto &rt = *runtime;
+
+    auto invoker = std::make_shared<BenchCallInvoker>();
+    invoker->setRuntime(&rt);
+
+    CxxCrabyTestModule::dataPath = std::filesystem::temp_directory_path().string();
+    auto calculator = std::make_shared<CxxCalculatorModule>(invoker);
+    auto crabyTest = std::make_shared<CxxCrabyTestModule>(invoker);
+    rt.global().setProperty(rt,
+                            CxxCalculatorModule::kModuleName,
+                            jsi::Object::createFromHostObject(rt, calculator));
+    rt.global().setProperty(rt,
+                            CxxCrabyTestModule::kModuleName,
+                            jsi::Object::createFromHostObject(rt, crabyTest));
+
+    rt.evaluateJavaScript(
+      std::make_shared<jsi::StringBuffer>(
+        "globalThis.__crabyBenchSettle = (promise, done) => promise.then(done, done);"),
+      "prelude.js");
+    rt.evaluateJavaScript(std::make_shared<jsi::StringBuffer>(readFile(options.suitePath)),
+                          options.suitePath);
+
+    auto suite = rt.global().getPropertyAsObject(rt, "suite");
+    auto names = suite.getPropertyNames(rt);
+    CaseRunner runner(rt, *invoker);
+    std::vector<Result> results;
+
+    for (size_t i = 0; i < names.size(rt); i++) {
+      auto name = names.getValueAtIndex(rt, i).asString(rt).utf8(rt);
+      if (name.find(options.filter) == std::string::npos) {
+        continue;
+      }
+      auto fn = suite.getPropertyAsFunction(rt, name.c_str());
+      results.push_back(runCase(name, fn, runner, options));
+    }
+
+    if (std::string("signal:onSignal").find(options.filter) != std::string::npos) {
+      results.push_back(runSignalCase(rt, *invoker, *crabyTest, options));
+    }
+
+    runArrayThresholdCases(rt, options, results);
+
+    printResults(results);
+
+    calculator->invalidate();
+    crabyTest->invalidate();
+    return 0;
+  } catch (const jsi::JSError &err) {
+    std::fprintf(stderr, "%s\n%s\n", err.getMessage().c_str(), err.getStack().c_str());
+  } catch (const std::exception &err) {
+    std::fprintf(stderr, "%s\n", err.what());
+  }
+  return 1;
+}
@@ -0,0 +1,35 @@
+// Default benchmark suite for `craby-test`.
+//
+// Each case is called once per iteration. If a case returns a Promise, the runner waits for it to settle.
+// Modules are installed as globals by their module name (e.g. `CrabyTest`, `Calculator`).
+const object = {
+  foo: 'foo',
+  bar: 123,
+  baz: false,
+  sub: { a: 'a', b: 456, c: true },
+  camelCase: 0,
+  PascalCase: 0,
+  snake_case: 0,
+};
+const shortString = 'Hello, World!';
+const longString = shortString.repeat(100);
+const bytes = new Uint8Array(4096);
+const numbers = Array.from({ length: 1000 }, (_, i) => i);
+const floats = new Float64Array(numbers);
+
+globalThis.suite = {
+  'Calculator.add': () => Calculator.add(1, 2),
+  'CrabyTest.numericMethod': () => CrabyTest.numericMethod(123),
+  'CrabyTest.booleanMethod': () => CrabyTest.booleanMethod(true),
+  'CrabyTest.stringMethod': () => CrabyTest.stringMethod(shortString),
+  'CrabyTest.stringMethod (1.3 KB)': () => CrabyTest.stringMethod(longString),
+  'CrabyTest.objectMethod': () => CrabyTest.objectMethod(object),
+  'CrabyTest.arrayBufferMethod (4 KB)': () => CrabyTest.arrayBufferMethod(bytes.buffer),
+  'CrabyTest.arrayMethod (1000)': () => CrabyTest.arrayMethod(numbers),
+  'CrabyTest.typedArrayMethod (1000)': () => CrabyTest.typedArrayMethod(floats),
+  'CrabyTest.enumMethod': () => CrabyTest.enumMethod('foo', 1),
+  'CrabyTest.nullableMethod': () => CrabyTest.nullableMethod(null),
+  'CrabyTest.promiseMethod': () => CrabyTest.promiseMethod(123),
+  'CrabyTest.setState': () => CrabyTest.setState(1),
+  'CrabyTest.getState': () => CrabyTest.getState(),
+};
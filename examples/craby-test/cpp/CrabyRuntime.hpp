@@ -0,0 +1,48 @@
+// Auto generated by Craby. DO NOT EDIT.
+#pragma once
+
+#include "CxxCalculatorModule.hpp"
+#include "CxxCrabyTestModule.hpp"
+#include <ReactCommon/CallInvoker.h>
+#include <jsi/jsi.h>
+#include <memory>
+
+namespace craby {
+namespace crabytest {
+
+// Object of a module installed by `installModules()`, shaped like the ones of `TurboModuleBinding`: a plain
+// object with the host object as prototype. The methods are created once and set on the object, so calls
+// don't go through `HostObject::get` (a new `jsi::Function` per lookup).
+inline facebook::jsi::Object createModuleObject(facebook::jsi::Runtime &rt,
+                                                std::shared_ptr<facebook::jsi::HostObject> module) {
+  auto hostObject = facebook::jsi::Object::createFromHostObject(rt, module);
+  auto object = facebook::jsi::Object(rt);
+  for (auto &name : module->getPropertyNames(rt)) {
+    object.setProperty(rt, name, hostObject.getProperty(rt, name));
+  }
+  // Keeps the module alive as long as the object
+  object.setProperty(rt, "__proto__", std::move(hostObject));
+  return object;
+}
+
+// Installs the modules into a secondary runtime (eg. a worklet or worker runtime on its own thread)
+// as `global.__crabyModules[moduleName]`, so sync calls from that runtime don't block the main JS thread.
+//
+// - `jsInvoker` must run its callbacks on the thread of `rt`, signals and promises are delivered through it.
+// - Each runtime gets its own instances of the modules, the Rust modules are not shared with the main runtime.
+// - Install after the main runtime has loaded a module, the data path of the modules is resolved by then.
+inline void installModules(facebook::jsi::Runtime &rt, std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
+  auto installed = facebook::jsi::Object(rt);
+  installed.setProperty(
+    rt,
+    modules::CxxCalculatorModule::kModuleName,
+    createModuleObject(rt, std::make_shared<modules::CxxCalculatorModule>(jsInvoker)));
+  installed.setProperty(
+    rt,
+    modules::CxxCrabyTestModule::kModuleName,
+    createModuleObject(rt, std::make_shared<modules::CxxCrabyTestModule>(jsInvoker)));
+  rt.global().setProperty(rt, "__crabyModules", std::move(installed));
+}
+
+} // namespace crabytest
+} // namespace craby
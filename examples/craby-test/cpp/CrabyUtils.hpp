@@ -3,82 +3,663 @@
 
 #include "cxx.h"
 #include "ffi.rs.h"
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <shared_mutex>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif defined(__ANDROID__) || defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace craby {
 namespace crabytest {
 namespace utils {
 
-class ThreadPool {
+// Move-only `void()` callable.
+// Callables up to `kInlineSize` bytes (eg. the module, the promise and a few arguments) are stored inline,
+// so enqueuing a task does not allocate.
+// Callables with a `cancel()` member are cancelled instead of silently destroyed when the task is dropped
+// (destroyed, overwritten or `cancel()`ed) before it runs.
+class Task {
+public:
+  static constexpr size_t kInlineSize = 64;
+
+  Task() noexcept = default;
+
+  template <class F, class Fn = std::decay_t<F>, class = std::enable_if_t<!std::is_same_v<Fn, Task>>>
+  Task(F &&f) {
+    if constexpr (sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+                  std::is_nothrow_move_constructible_v<Fn>) {
+      new (&storage_) Fn(std::forward<F>(f));
+      ops_ = &kInlineOps<Fn>;
+    } else {
+      *reinterpret_cast<Fn **>(&storage_) = new Fn(std::forward<F>(f));
+      ops_ = &kHeapOps<Fn>;
+    }
+  }
+
+  Task(Task &&other) noexcept : ops_(other.ops_), invoked_(other.invoked_) {
+    if (ops_) {
+      ops_->move(&other.storage_, &storage_);
+      other.ops_ = nullptr;
+    }
+  }
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      cancel();
+      ops_ = other.ops_;
+      invoked_ = other.invoked_;
+      if (ops_) {
+        ops_->move(&other.storage_, &storage_);
+        other.ops_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  ~Task() {
+    cancel();
+  }
+
+  explicit operator bool() const noexcept {
+    return ops_ != nullptr;
+  }
+
+  void operator()() {
+    invoked_ = true;
+    ops_->invoke(&storage_);
+  }
+
+  // Drops the task, cancelling it if it has not run
+  void cancel() noexcept {
+    if (ops_) {
+      if (!invoked_) {
+        ops_->cancel(&storage_);
+      }
+      reset();
+    }
+  }
+
 private:
-  bool stop;
-  std::mutex mutex;
-  std::condition_variable condition;
-  std::queue<std::function<void()>> tasks;
-  std::vector<std::thread> workers;
+  struct Ops {
+    void (*invoke)(void *);
+    void (*cancel)(void *);
+    void (*move)(void *from, void *to);
+    void (*destroy)(void *);
+  };
+
+  template <class Fn>
+  static void invokeCancel(Fn &fn) noexcept {
+    if constexpr (requires { fn.cancel(); }) {
+      try {
+        fn.cancel();
+      } catch (...) {
+        // Noop
+      }
+    }
+  }
+
+  template <class Fn>
+  static constexpr Ops kInlineOps = {
+    [](void *p) { (*static_cast<Fn *>(p))(); },
+    [](void *p) { invokeCancel(*static_cast<Fn *>(p)); },
+    [](void *from, void *to) {
+      new (to) Fn(std::move(*static_cast<Fn *>(from)));
+      static_cast<Fn *>(from)->~Fn();
+    },
+    [](void *p) { static_cast<Fn *>(p)->~Fn(); },
+  };
+
+  template <class Fn>
+  static constexpr Ops kHeapOps = {
+    [](void *p) { (**static_cast<Fn **>(p))(); },
+    [](void *p) { invokeCancel(**static_cast<Fn **>(p)); },
+    [](void *from, void *to) { *static_cast<Fn **>(to) = *static_cast<Fn **>(from); },
+    [](void *p) { delete *static_cast<Fn **>(p); },
+  };
+
+  void reset() {
+    if (ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+    invoked_ = false;
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+  const Ops *ops_ = nullptr;
+  bool invoked_ = false;
+};
+
+// Task that calls `onCancel` if it is dropped before it runs (eg. to reject its promise on shutdown).
+template <class Run, class Cancel>
+struct CancellableTask {
+  Run run;
+  Cancel onCancel;
+
+  void operator()() {
+    run();
+  }
+
+  void cancel() {
+    onCancel();
+  }
+};
+
+template <class Run, class Cancel>
+CancellableTask<std::decay_t<Run>, std::decay_t<Cancel>> withCancel(Run &&run, Cancel &&onCancel) {
+  return {std::forward<Run>(run), std::forward<Cancel>(onCancel)};
+}
+
+// Settings of the `Executor` workers (`[executor]` of `craby.toml`).
+struct WorkerOptions {
+  enum class Priority { Default, UserInitiated, Utility, Background };
+  enum class Affinity { Any, Little, Big };
+
+  // `0`: one worker per core of the affinity (at least 2)
+  static constexpr size_t kThreads = 0;
+  static constexpr const char *kThreadName = "craby";
+  static constexpr Priority kPriority = Priority::Default;
+  static constexpr Affinity kAffinity = Affinity::Any;
+};
+
+#if defined(__ANDROID__) || defined(__linux__)
+// CPUs of the affinity, split by their max frequency: `Little` is the slowest cluster, `Big` the others.
+// Empty if the affinity is `Any` or all cores are the same.
+inline const std::vector<int> &affinityCpus() {
+  static const std::vector<int> cpus = [] {
+    std::vector<int> selected;
+    if (WorkerOptions::kAffinity == WorkerOptions::Affinity::Any) {
+      return selected;
+    }
+
+    std::vector<std::pair<int, long>> freqs;
+    long minFreq = 0;
+    long maxFreq = 0;
+    long count = sysconf(_SC_NPROCESSORS_CONF);
+    for (int cpu = 0; cpu < count && cpu < CPU_SETSIZE; ++cpu) {
+      char path[96];
+      std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+      FILE *file = std::fopen(path, "r");
+      if (file == nullptr) {
+        continue;
+      }
+      long freq = 0;
+      if (std::fscanf(file, "%ld", &freq) == 1 && freq > 0) {
+        minFreq = freqs.empty() ? freq : std::min(minFreq, freq);
+        maxFreq = std::max(maxFreq, freq);
+        freqs.emplace_back(cpu, freq);
+      }
+      std::fclose(file);
+    }
+
+    if (minFreq == maxFreq) {
+      return selected;
+    }
+    for (auto [cpu, freq] : freqs) {
+      if ((freq == minFreq) == (WorkerOptions::kAffinity == WorkerOptions::Affinity::Little)) {
+        selected.push_back(cpu);
+      }
+    }
+    return selected;
+  }();
+  return cpus;
+}
+#endif
 
+inline size_t configuredWorkerCount() {
+  if (WorkerOptions::kThreads != 0) {
+    return WorkerOptions::kThreads;
+  }
+#if defined(__ANDROID__) || defined(__linux__)
+  if (!affinityCpus().empty()) {
+    return std::max<size_t>(2, affinityCpus().size());
+  }
+#endif
+  return std::max(2u, std::thread::hardware_concurrency());
+}
+
+// Names the current worker (`<name>-<index>`) and applies its priority and affinity.
+// Best effort: the worker runs with the default settings if the OS rejects them.
+inline void configureWorker(size_t index) {
+  // 15 characters and the terminator is the limit on Linux
+  char name[16];
+  std::snprintf(name, sizeof(name), "%s-%zu", WorkerOptions::kThreadName, index);
+
+#if defined(__APPLE__)
+  pthread_setname_np(name);
+
+  switch (WorkerOptions::kPriority) {
+  case WorkerOptions::Priority::Default:
+    break;
+  case WorkerOptions::Priority::UserInitiated:
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INITIATED, 0);
+    break;
+  case WorkerOptions::Priority::Utility:
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+    break;
+  case WorkerOptions::Priority::Background:
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+    break;
+  }
+#elif defined(__ANDROID__) || defined(__linux__)
+  pthread_setname_np(pthread_self(), name);
+
+  // Same values as `android.os.Process.THREAD_PRIORITY_*`
+  int nice = 0;
+  switch (WorkerOptions::kPriority) {
+  case WorkerOptions::Priority::Default:
+    break;
+  case WorkerOptions::Priority::UserInitiated:
+    nice = -2;
+    break;
+  case WorkerOptions::Priority::Utility:
+    nice = 5;
+    break;
+  case WorkerOptions::Priority::Background:
+    nice = 10;
+    break;
+  }
+  if (nice != 0) {
+    // The nice value is per thread on Linux
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice);
+  }
+
+  if (!affinityCpus().empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : affinityCpus()) {
+      CPU_SET(cpu, &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+  }
+#endif
+}
+
+class ModuleExecutor;
+// Defined in `bridging-generated.hpp`
+class RuntimeCache;
+
+// Process-wide work-stealing executor shared by all modules.
+//
+// Each worker owns a deque: it pops its own tasks from the back and steals from the front of the others' deques.
+// Tasks submitted from a worker go to its own deque, other tasks are distributed round-robin.
+class Executor {
 public:
-  ThreadPool(size_t num_threads = 10) : stop(false) {
-    for (size_t i = 0; i < num_threads; ++i) {
-      workers.emplace_back([this] {
-        while (true) {
-          std::function<void()> task;
-
-          {
-            std::unique_lock<std::mutex> lock(this->mutex);
-            this->condition.wait(
-                lock, [this] { return this->stop || !this->tasks.empty(); });
-
-            if (this->stop && this->tasks.empty()) {
-              return;
-            }
-
-            task = std::move(this->tasks.front());
-            this->tasks.pop();
-          }
-
-          task();
-        }
-      });
+  struct Job {
+    Task task;
+    std::shared_ptr<ModuleExecutor> owner;
+    bool serial = false;
+  };
+
+  static Executor &getInstance() {
+    // Intentionally leaked, the workers live as long as the process
+    static Executor *instance = new Executor();
+    return *instance;
+  }
+
+  size_t workerCount() const {
+    return workers_.size();
+  }
+
+  void submit(Job job) {
+    size_t index = currentWorker_ != 0 ? currentWorker_ - 1
+                                       : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+      std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+      queues_[index]->jobs.push_back(std::move(job));
+      pending_.fetch_add(1, std::memory_order_release);
     }
+
+    // Synchronize with the idle workers so the notification is not lost
+    { std::lock_guard<std::mutex> lock(idleMutex_); }
+    idle_.notify_one();
   }
 
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  Executor() {
+    size_t count = configuredWorkerCount();
+    for (size_t i = 0; i < count; ++i) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+      workers_.emplace_back([this, i] { run(i); });
+    }
+  }
+
+  bool tryPop(size_t index, Job &job) {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      auto &queue = *queues_[(index + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.jobs.empty()) {
+        continue;
+      }
+
+      // LIFO for the own deque (cache locality), FIFO when stealing (oldest task first)
+      if (i == 0) {
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+      } else {
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+      }
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  void run(size_t index);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_{0};
+  std::atomic<size_t> pending_{0};
+  std::mutex idleMutex_;
+  std::condition_variable idle_;
+  // Index + 1 of the worker running on this thread (`0` if not a worker)
+  static inline thread_local size_t currentWorker_ = 0;
+};
+
+// Per-module handle of the shared `Executor`.
+//
+// Orders the tasks of the module by the execution policy of the methods:
+// - `serial`: one task at a time in the order enqueued
+// - `concurrent` and methods without a policy: up to `maxConcurrency` tasks in parallel (`0` = limited by the worker count)
+//
+// Modules with `serial` or `concurrent` methods also hold the state lock around each of their Rust calls:
+// `serial` tasks and the calls on the JS thread hold it exclusively (`lock()`), `concurrent` tasks hold it shared (`sharedLock()`).
+// Other modules never take it, so their calls on the JS thread don't wait for their tasks.
+class ModuleExecutor : public std::enable_shared_from_this<ModuleExecutor> {
+public:
+  explicit ModuleExecutor(size_t maxConcurrency = 0) : maxConcurrency_(maxConcurrency) {}
+
   template <class F> void enqueue(F &&f) {
+    Task task(std::forward<F>(f));
     {
-      std::unique_lock<std::mutex> lock(mutex);
-      if (stop) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stop_) {
+        lock.unlock();
+        task.cancel();
+        return;
+      }
+      if (maxConcurrency_ != 0 && running_ >= maxConcurrency_) {
+        backlog_.push_back(std::move(task));
         return;
       }
-      tasks.emplace(std::forward<F>(f));
+      ++running_;
     }
-    condition.notify_one();
+    Executor::getInstance().submit({std::move(task), shared_from_this(), false});
   }
 
+  template <class F> void enqueueSerial(F &&f) {
+    Task task(std::forward<F>(f));
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stop_) {
+        lock.unlock();
+        task.cancel();
+        return;
+      }
+      if (serialRunning_) {
+        serialBacklog_.push_back(std::move(task));
+        return;
+      }
+      serialRunning_ = true;
+    }
+    Executor::getInstance().submit({std::move(task), shared_from_this(), true});
+  }
+
+  // Exclusive access to the module state, held for a Rust call only.
+  std::unique_lock<std::shared_mutex> lock() {
+    return std::unique_lock<std::shared_mutex>(stateMutex_);
+  }
+
+  // Shared access to the module state for the `concurrent` tasks, held for a Rust call only.
+  std::shared_lock<std::shared_mutex> sharedLock() {
+    return std::shared_lock<std::shared_mutex>(stateMutex_);
+  }
+
+  // Cancels the queued tasks, including the ones already submitted to the `Executor`.
+  //
+  // Does not wait for the running tasks (this is called on the JS thread): they hold their own
+  // reference to the module, so it is released by the last of them to finish.
   void shutdown() {
+    std::deque<Task> dropped;
     {
-      std::unique_lock<std::mutex> lock(mutex);
-      stop = true;
-      std::queue<std::function<void()>> empty;
-      std::swap(tasks, empty);
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_.store(true);
+      std::swap(dropped, backlog_);
+      for (auto &task : serialBacklog_) {
+        dropped.push_back(std::move(task));
+      }
+      serialBacklog_.clear();
     }
 
-    condition.notify_all();
+    for (auto &task : dropped) {
+      task.cancel();
+    }
+  }
+
+  // Called by the `Executor` to run a task of this module (the task takes the state lock itself).
+  void run(Task &task) {
+    if (stop_.load()) {
+      task.cancel();
+      return;
+    }
+    task();
+  }
 
-    for (std::thread &worker : workers) {
-      if (worker.joinable()) {
-        worker.join();
+  // Called by the `Executor` when a task of this module has finished.
+  void onComplete(bool serial) {
+    Task next;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto &backlog = serial ? serialBacklog_ : backlog_;
+      if (stop_ || backlog.empty()) {
+        if (serial) {
+          serialRunning_ = false;
+        } else {
+          --running_;
+        }
+        return;
       }
+      next = std::move(backlog.front());
+      backlog.pop_front();
     }
+    Executor::getInstance().submit({std::move(next), shared_from_this(), serial});
   }
 
-  ~ThreadPool() {
-    shutdown();
+private:
+  size_t maxConcurrency_;
+  // Number of running tasks enqueued by `enqueue` (`concurrent` and no policy)
+  size_t running_ = 0;
+  bool serialRunning_ = false;
+  // Written under `mutex_`, read without it by `run`
+  std::atomic<bool> stop_{false};
+  std::deque<Task> backlog_;
+  std::deque<Task> serialBacklog_;
+  std::mutex mutex_;
+  std::shared_mutex stateMutex_;
+};
+
+inline void Executor::run(size_t index) {
+  currentWorker_ = index + 1;
+  configureWorker(index);
+
+  while (true) {
+    Job job;
+    if (tryPop(index, job)) {
+      try {
+        if (job.owner) {
+          job.owner->run(job.task);
+        } else {
+          job.task();
+        }
+      } catch (...) {
+        // Noop
+      }
+      // Destroy the captures before the module can be notified as drained
+      job.task = Task();
+      if (job.owner) {
+        job.owner->onComplete(job.serial);
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    idle_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) > 0; });
+  }
+}
+
+// Pending signals of a `latest` or `batch` signal until they are flushed on the JS thread.
+template <typename T>
+class SignalQueue {
+public:
+  explicit SignalQueue(bool latest) : latest_(latest) {}
+
+  // Returns `true` if no flush is scheduled yet, so the caller has to schedule one.
+  bool push(std::shared_ptr<T> signal) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latest_) {
+      pending_.clear();
+    }
+    pending_.push_back(std::move(signal));
+    return !std::exchange(scheduled_, true);
+  }
+
+  std::vector<std::shared_ptr<T>> take() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    scheduled_ = false;
+    return std::exchange(pending_, {});
+  }
+
+  bool isLatest() const {
+    return latest_;
+  }
+
+private:
+  bool latest_;
+  bool scheduled_ = false;
+  std::vector<std::shared_ptr<T>> pending_;
+  std::mutex mutex_;
+};
+
+// Per-thread bump allocator for the temporaries of a call (eg. the UTF-8 copies of `rust::Str` arguments).
+// Allocations are released in reverse order (`release()` to a previous `mark()`) and the chunks are kept,
+// so the conversions of a call don't allocate once the arena has grown to the size of the calls.
+// Chunks larger than `kMaxRetainedSize` (made for a single large allocation) are freed on release instead.
+class ScratchArena {
+public:
+  struct Mark {
+    size_t chunk;
+    size_t offset;
+  };
+
+  static ScratchArena &local() {
+    thread_local ScratchArena arena;
+    return arena;
+  }
+
+  Mark mark() const noexcept {
+    return Mark{current_, offset_};
   }
+
+  void release(Mark mark) noexcept {
+    // Chunks after the current one are already trimmed, only the ones released by this mark are checked
+    for (auto index = mark.offset == 0 ? mark.chunk : mark.chunk + 1; index <= current_ && index < chunks_.size();
+         ++index) {
+      auto &chunk = chunks_[index];
+      if (chunk.size > kMaxRetainedSize) {
+        chunk.data.reset();
+        chunk.size = 0;
+      }
+    }
+    current_ = mark.chunk;
+    offset_ = mark.offset;
+  }
+
+  char *allocate(size_t size) {
+    if (current_ < chunks_.size() && chunks_[current_].size - offset_ >= size) {
+      auto data = chunks_[current_].data.get() + offset_;
+      offset_ += size;
+      return data;
+    }
+
+    next(size);
+    offset_ = size;
+    return chunks_[current_].data.get();
+  }
+
+  // Grows the latest allocation of the arena, moved to a new chunk if it doesn't fit in its chunk
+  char *grow(char *data, size_t size, size_t newSize) {
+    auto &chunk = chunks_[current_];
+    if (data + newSize <= chunk.data.get() + chunk.size) {
+      offset_ += newSize - size;
+      return data;
+    }
+
+    auto moved = allocate(newSize);
+    std::copy(data, data + size, moved);
+    return moved;
+  }
+
+private:
+  static constexpr size_t kChunkSize = 16 * 1024;
+  // Size of the largest regular chunk, larger chunks are not kept once released
+  static constexpr size_t kMaxRetainedSize = kChunkSize << 4;
+
+  struct Chunk {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+  };
+
+  void next(size_t size) {
+    // Nothing is allocated in the current chunk at offset `0`, so it is reused (eg. after it was freed)
+    auto index = chunks_.empty() || offset_ == 0 ? current_ : current_ + 1;
+    if (index == chunks_.size()) {
+      chunks_.emplace_back();
+    }
+
+    // Chunks after the current one are unused, a chunk too small for the allocation is replaced
+    auto &chunk = chunks_[index];
+    if (chunk.size < size) {
+      chunk.size = std::max(size, kChunkSize << std::min<size_t>(index, 4));
+      chunk.data.reset(new char[chunk.size]);
+    }
+    current_ = index;
+  }
+
+  std::vector<Chunk> chunks_;
+  size_t current_ = 0;
+  size_t offset_ = 0;
 };
 
 inline std::string errorMessage(const std::exception &err) {
@@ -11,61 +11,137 @@ namespace crabytest {
 namespace modules {
 
 std::string CxxCalculatorModule::dataPath = std::string();
+size_t CxxCalculatorModule::maxConcurrency = 0;
+
+// Methods of the module sorted by name, shared by every instance
+static constexpr std::array<CxxCalculatorModule::MethodEntry, 5> kMethods = {{
+  {"add", 2, &CxxCalculatorModule::add, true},
+  {"batch", 1, &CxxCalculatorModule::batch, false},
+  {"divide", 2, &CxxCalculatorModule::divide, true},
+  {"multiply", 2, &CxxCalculatorModule::multiply, true},
+  {"subtract", 2, &CxxCalculatorModule::subtract, true},
+}};
+
+// Perfect hash of the method names (FNV-1a, the seed is found by the codegen)
+static constexpr uint32_t kHashSeed = 0;
+static constexpr uint32_t kHashShift = 28;
+static constexpr uint16_t kNoMethod = 0xFFFF;
+static constexpr std::array<uint16_t, 16> kSlots = {{
+  kNoMethod, 1, kNoMethod, 0, 4, kNoMethod, 2, kNoMethod,
+  kNoMethod, kNoMethod, kNoMethod, kNoMethod, kNoMethod, kNoMethod, kNoMethod, 3,
+}};
+
+static constexpr uint32_t hashName(std::string_view name) {
+  uint32_t hash = 2166136261u ^ kHashSeed;
+  for (char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+static_assert([] {
+  for (size_t i = 0; i < kMethods.size(); i++) {
+    if (kSlots[hashName(kMethods[i].name) >> kHashShift] != i) {
+      return false;
+    }
+  }
+  return true;
+}(), "Every method must have its own slot");
 
 CxxCalculatorModule::CxxCalculatorModule(
     std::shared_ptr<react::CallInvoker> jsInvoker)
     : TurboModule(CxxCalculatorModule::kModuleName, jsInvoker) {
   // No signals
   callInvoker_ = std::move(jsInvoker);
-  module_ = std::shared_ptr<craby::crabytest::bridging::Calculator>(
-    craby::crabytest::bridging::createCalculator(
-      reinterpret_cast<uintptr_t>(this),
-      rust::Str(dataPath.data(), dataPath.size())).into_raw(),
-    [](craby::crabytest::bridging::Calculator *ptr) { rust::Box<craby::crabytest::bridging::Calculator>::from_raw(ptr); }
-  );
-  threadPool_ = std::make_shared<craby::crabytest::utils::ThreadPool>(10);
-  methodMap_["add"] = MethodMetadata{2, &CxxCalculatorModule::add};
-  methodMap_["divide"] = MethodMetadata{2, &CxxCalculatorModule::divide};
-  methodMap_["multiply"] = MethodMetadata{2, &CxxCalculatorModule::multiply};
-  methodMap_["subtract"] = MethodMetadata{2, &CxxCalculatorModule::subtract};
+  executor_ = std::make_shared<craby::crabytest::utils::ModuleExecutor>(maxConcurrency);
+  runtimeCache_ = std::make_shared<craby::crabytest::utils::RuntimeCache>();
 }
 
 CxxCalculatorModule::~CxxCalculatorModule() {
   invalidate();
 }
 
+const CxxCalculatorModule::MethodEntry *CxxCalculatorModule::findMethod(std::string_view name) {
+  auto slot = kSlots[hashName(name) >> kHashShift];
+  if (slot == kNoMethod || kMethods[slot].name != name) {
+    return nullptr;
+  }
+  return &kMethods[slot];
+}
+
+jsi::Value CxxCalculatorModule::create(jsi::Runtime &rt, const jsi::PropNameID &propName) {
+  if (runtime_.exchange(&rt) != &rt) {
+    craby::crabytest::utils::RuntimeCache::bind(rt, runtimeCache_);
+  }
+  auto entry = findMethod(propName.utf8(rt));
+  if (entry == nullptr) {
+    return jsi::Value::undefined();
+  }
+
+  auto invoker = entry->invoker;
+  return jsi::Function::createFromHostFunction(
+    rt,
+    propName,
+    static_cast<unsigned int>(entry->argCount),
+    [this, invoker](jsi::Runtime &rt, const jsi::Value &thisVal, const jsi::Value *args, size_t count) {
+      return invoker(rt, *this, args, count);
+    });
+}
+
+std::vector<jsi::PropNameID> CxxCalculatorModule::getPropertyNames(jsi::Runtime &rt) {
+  std::vector<jsi::PropNameID> names;
+  names.reserve(kMethods.size());
+  for (auto &entry : kMethods) {
+    names.push_back(jsi::PropNameID::forAscii(rt, entry.name.data(), entry.name.size()));
+  }
+  return names;
+}
+
+std::shared_ptr<craby::crabytest::bridging::Calculator> &CxxCalculatorModule::module() {
+  // Not recreated after `invalidate()`, the method rethrows the error as a `jsi::JSError`
+  if (invalidated_.load()) {
+    throw std::runtime_error("Module is invalidated");
+  }
+
+  // Created on the first call of the module, not on its construction by the TurboModule registry
+  std::call_once(moduleOnce_, [this] {
+    module_ = std::shared_ptr<craby::crabytest::bridging::Calculator>(
+      craby::crabytest::bridging::createCalculator(
+        reinterpret_cast<uintptr_t>(this),
+        rust::Str(dataPath.data(), dataPath.size())).into_raw(),
+      [](craby::crabytest::bridging::Calculator *ptr) { rust::Box<craby::crabytest::bridging::Calculator>::from_raw(ptr); }
+    );
+  });
+  return module_;
+}
+
 void CxxCalculatorModule::invalidate() {
   if (invalidated_.exchange(true)) {
     return;
   }
 
-  invalidated_.store(true);
-  listenersMap_.clear();
+  // `jsi::PropNameID` must be released on the runtime's thread, before the runtime is destroyed
+  runtimeCache_.reset();
 
   // No signals
 
-  // Shutdown thread pool
-  threadPool_->shutdown();
+  // Reject the promises of the queued tasks, the running ones finish on their own
+  executor_->shutdown();
 }
 
 jsi::Value CxxCalculatorModule::add(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
+  if (2 != count) {
+    throw jsi::JSError(rt, "Expected 2 arguments");
+  }
+
   auto &thisModule = static_cast<CxxCalculatorModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
 
+  // Errors are thrown as `jsi::JSError` like the other methods (eg. `module()` once the module is invalidated)
   try {
-    if (2 != count) {
-      throw jsi::JSError(rt, "Expected 2 arguments");
-    }
-
-    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
-    auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
-    auto ret = craby::crabytest::bridging::add(*it_, arg0, arg1);
-
-    return react::bridging::toJs(rt, ret);
+    return jsi::Value(craby::crabytest::bridging::add(*thisModule.module(), args[0].asNumber(), args[1].asNumber()));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -78,14 +154,14 @@ jsi::Value CxxCalculatorModule::divide(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCalculatorModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (2 != count) {
       throw jsi::JSError(rt, "Expected 2 arguments");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
     auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
     auto ret = craby::crabytest::bridging::divide(*it_, arg0, arg1);
@@ -102,20 +178,15 @@ jsi::Value CxxCalculatorModule::multiply(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
+  if (2 != count) {
+    throw jsi::JSError(rt, "Expected 2 arguments");
+  }
+
   auto &thisModule = static_cast<CxxCalculatorModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
 
+  // Errors are thrown as `jsi::JSError` like the other methods (eg. `module()` once the module is invalidated)
   try {
-    if (2 != count) {
-      throw jsi::JSError(rt, "Expected 2 arguments");
-    }
-
-    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
-    auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
-    auto ret = craby::crabytest::bridging::multiply(*it_, arg0, arg1);
-
-    return react::bridging::toJs(rt, ret);
+    return jsi::Value(craby::crabytest::bridging::multiply(*thisModule.module(), args[0].asNumber(), args[1].asNumber()));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -127,20 +198,64 @@ jsi::Value CxxCalculatorModule::subtract(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
+  if (2 != count) {
+    throw jsi::JSError(rt, "Expected 2 arguments");
+  }
+
   auto &thisModule = static_cast<CxxCalculatorModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
 
+  // Errors are thrown as `jsi::JSError` like the other methods (eg. `module()` once the module is invalidated)
   try {
-    if (2 != count) {
-      throw jsi::JSError(rt, "Expected 2 arguments");
-    }
+    return jsi::Value(craby::crabytest::bridging::subtract(*thisModule.module(), args[0].asNumber(), args[1].asNumber()));
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
 
-    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
-    auto arg1 = react::bridging::fromJs<double>(rt, args[1], callInvoker);
-    auto ret = craby::crabytest::bridging::subtract(*it_, arg0, arg1);
+jsi::Value CxxCalculatorModule::batch(jsi::Runtime &rt,
+                      react::TurboModule &turboModule,
+                      const jsi::Value args[],
+                      size_t count) {
+  auto &thisModule = static_cast<CxxCalculatorModule &>(turboModule);
 
-    return react::bridging::toJs(rt, ret);
+  if (1 != count) {
+    throw jsi::JSError(rt, "Expected 1 argument");
+  }
+
+  try {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<CxxCalculatorModule>(rt, {"method", "args"});
+    auto ops = args[0].asObject(rt).asArray(rt);
+    auto size = ops.size(rt);
+    auto results = jsi::Array(rt, size);
+    std::vector<jsi::Value> opArgs;
+
+    for (size_t i = 0; i < size; i++) {
+      auto op = ops.getValueAtIndex(rt, i).asObject(rt);
+      auto method = op.getProperty(rt, (*props)[0]).asString(rt).utf8(rt);
+      auto entry = findMethod(method);
+      if (entry == nullptr) {
+        throw jsi::JSError(rt, "Unknown method: " + method);
+      }
+      // A nested `batch` or a `Promise` in the results would not run (or settle) within the batch
+      if (!entry->batchable) {
+        throw jsi::JSError(rt, "Method cannot be batched: " + method);
+      }
+
+      // Each call checks its arguments as if it was called directly
+      auto arr = op.getProperty(rt, (*props)[1]).asObject(rt).asArray(rt);
+      auto argCount = arr.size(rt);
+      opArgs.clear();
+      opArgs.reserve(argCount);
+      for (size_t j = 0; j < argCount; j++) {
+        opArgs.push_back(arr.getValueAtIndex(rt, j));
+      }
+
+      results.setValueAtIndex(rt, i, entry->invoker(rt, thisModule, opArgs.data(), argCount));
+    }
+
+    return results;
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -4,8 +4,12 @@
 #include "CrabyUtils.hpp"
 #include "ffi.rs.h"
 #include <ReactCommon/TurboModule.h>
+#include <array>
 #include <jsi/jsi.h>
 #include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
 
 namespace craby {
 namespace crabytest {
@@ -15,11 +19,26 @@ class JSI_EXPORT CxxCalculatorModule : public facebook::react::TurboModule {
 public:
   static constexpr const char *kModuleName = "Calculator";
   static std::string dataPath;
+  // Max number of running async tasks of this module (`0` = limited by the shared executor's worker count)
+  static size_t maxConcurrency;
+
+  struct MethodEntry {
+    std::string_view name;
+    size_t argCount;
+    facebook::jsi::Value (*invoker)(
+        facebook::jsi::Runtime &rt,
+        facebook::react::TurboModule &turboModule,
+        const facebook::jsi::Value args[], size_t count);
+    // `false` for `batch` and the methods returning a `Promise`, which `batch` rejects
+    bool batchable;
+  };
 
   CxxCalculatorModule(std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
   ~CxxCalculatorModule();
 
   void invalidate();
+  std::vector<facebook::jsi::PropNameID> getPropertyNames(facebook::jsi::Runtime &rt) override;
+  static const MethodEntry *findMethod(std::string_view name);
   static facebook::jsi::Value
   add(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
@@ -40,17 +59,27 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  batch(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
 protected:
+  facebook::jsi::Value create(facebook::jsi::Runtime &rt, const facebook::jsi::PropNameID &propName) override;
+  std::shared_ptr<craby::crabytest::bridging::Calculator> &module();
+
   std::shared_ptr<facebook::react::CallInvoker> callInvoker_;
-  std::shared_ptr<craby::crabytest::bridging::Calculator> module_;
+  // Runtime the module is installed into (the main runtime or a worker runtime, see `CrabyRuntime.hpp`)
+  std::atomic<facebook::jsi::Runtime *> runtime_{nullptr};
+  // JSI values cached for `runtime_` (see `RuntimeCache`), released by `invalidate()`
+  std::shared_ptr<craby::crabytest::utils::RuntimeCache> runtimeCache_;
   std::atomic<bool> invalidated_{false};
   std::atomic<size_t> nextListenerId_{0};
-  std::mutex listenersMutex_;
-  std::unordered_map<
-    std::string,
-    std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>>
-    listenersMap_;
-  std::shared_ptr<craby::crabytest::utils::ThreadPool> threadPool_;
+  std::shared_ptr<craby::crabytest::utils::ModuleExecutor> executor_;
+
+private:
+  std::once_flag moduleOnce_;
+  std::shared_ptr<craby::crabytest::bridging::Calculator> module_;
 };
 
 } // namespace modules
@@ -11,6 +11,72 @@ namespace crabytest {
 namespace modules {
 
 std::string CxxCrabyTestModule::dataPath = std::string();
+size_t CxxCrabyTestModule::maxConcurrency = 0;
+
+// Methods of the module sorted by name, shared by every instance
+static constexpr std::array<CxxCrabyTestModule::MethodEntry, 29> kMethods = {{
+  {"PascalMethod", 0, &CxxCrabyTestModule::pascalMethod, true},
+  {"abortablePromiseMethod", 2, &CxxCrabyTestModule::abortablePromiseMethod, false},
+  {"arrayBufferMethod", 1, &CxxCrabyTestModule::arrayBufferMethod, true},
+  {"arrayMethod", 1, &CxxCrabyTestModule::arrayMethod, true},
+  {"asyncPromiseMethod", 1, &CxxCrabyTestModule::asyncPromiseMethod, false},
+  {"batch", 1, &CxxCrabyTestModule::batch, false},
+  {"booleanMethod", 1, &CxxCrabyTestModule::booleanMethod, true},
+  {"camelMethod", 0, &CxxCrabyTestModule::camelMethod, true},
+  {"createDataStream", 0, &CxxCrabyTestModule::createDataStream, true},
+  {"enumMethod", 2, &CxxCrabyTestModule::enumMethod, true},
+  {"getDataPath", 0, &CxxCrabyTestModule::getDataPath, true},
+  {"getState", 0, &CxxCrabyTestModule::getState, true},
+  {"mapData", 0, &CxxCrabyTestModule::mapData, true},
+  {"nullableMethod", 1, &CxxCrabyTestModule::nullableMethod, true},
+  {"numericMethod", 1, &CxxCrabyTestModule::numericMethod, true},
+  {"objectMethod", 1, &CxxCrabyTestModule::objectMethod, true},
+  {"onError", 1, &CxxCrabyTestModule::onError, true},
+  {"onProgress", 1, &CxxCrabyTestModule::onProgress, true},
+  {"onSignal", 1, &CxxCrabyTestModule::onSignal, true},
+  {"openDataStream", 0, &CxxCrabyTestModule::openDataStream, true},
+  {"positionState", 0, &CxxCrabyTestModule::positionState, true},
+  {"promiseMethod", 1, &CxxCrabyTestModule::promiseMethod, false},
+  {"readData", 0, &CxxCrabyTestModule::readData, true},
+  {"setState", 1, &CxxCrabyTestModule::setState, true},
+  {"snake_method", 0, &CxxCrabyTestModule::snakeMethod, true},
+  {"stringMethod", 1, &CxxCrabyTestModule::stringMethod, true},
+  {"triggerSignal", 0, &CxxCrabyTestModule::triggerSignal, false},
+  {"typedArrayMethod", 1, &CxxCrabyTestModule::typedArrayMethod, true},
+  {"writeData", 1, &CxxCrabyTestModule::writeData, true},
+}};
+
+// Perfect hash of the method names (FNV-1a, the seed is found by the codegen)
+static constexpr uint32_t kHashSeed = 1884;
+static constexpr uint32_t kHashShift = 26;
+static constexpr uint16_t kNoMethod = 0xFFFF;
+static constexpr std::array<uint16_t, 64> kSlots = {{
+  kNoMethod, kNoMethod, 1, 0, 2, kNoMethod, 23, kNoMethod,
+  16, 3, kNoMethod, kNoMethod, 9, kNoMethod, kNoMethod, 17,
+  19, 20, 13, 11, kNoMethod, kNoMethod, kNoMethod, 12,
+  kNoMethod, kNoMethod, kNoMethod, kNoMethod, 8, 28, kNoMethod, kNoMethod,
+  kNoMethod, kNoMethod, kNoMethod, 5, kNoMethod, kNoMethod, kNoMethod, kNoMethod,
+  kNoMethod, 6, kNoMethod, kNoMethod, kNoMethod, kNoMethod, kNoMethod, 25,
+  21, 26, 15, 22, 7, kNoMethod, 14, 27,
+  kNoMethod, kNoMethod, kNoMethod, 24, kNoMethod, 10, 4, 18,
+}};
+
+static constexpr uint32_t hashName(std::string_view name) {
+  uint32_t hash = 2166136261u ^ kHashSeed;
+  for (char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+static_assert([] {
+  for (size_t i = 0; i < kMethods.size(); i++) {
+    if (kSlots[hashName(kMethods[i].name) >> kHashShift] != i) {
+      return false;
+    }
+  }
+  return true;
+}(), "Every method must have its own slot");
 
 CxxCrabyTestModule::CxxCrabyTestModule(
     std::shared_ptr<react::CallInvoker> jsInvoker)
@@ -18,118 +84,132 @@ CxxCrabyTestModule::CxxCrabyTestModule(
   uintptr_t id = reinterpret_cast<uintptr_t>(this);
   auto& manager = craby::crabytest::signals::SignalManager::getInstance();
   manager.registerDelegate(id,
-    [this](const std::string& name, void* signal) {
-      this->emit(name, reinterpret_cast<bridging::CrabyTestSignal*>(signal));
+    [this](uint32_t signalId, void* signal) {
+      this->emit(static_cast<SignalId>(signalId), reinterpret_cast<bridging::CrabyTestSignal*>(signal));
     }
   );
   callInvoker_ = std::move(jsInvoker);
-  module_ = std::shared_ptr<craby::crabytest::bridging::CrabyTest>(
-    craby::crabytest::bridging::createCrabyTest(
-      reinterpret_cast<uintptr_t>(this),
-      rust::Str(dataPath.data(), dataPath.size())).into_raw(),
-    [](craby::crabytest::bridging::CrabyTest *ptr) { rust::Box<craby::crabytest::bridging::CrabyTest>::from_raw(ptr); }
-  );
-  threadPool_ = std::make_shared<craby::crabytest::utils::ThreadPool>(10);
-  methodMap_["arrayBufferMethod"] = MethodMetadata{1, &CxxCrabyTestModule::arrayBufferMethod};
-  methodMap_["arrayMethod"] = MethodMetadata{1, &CxxCrabyTestModule::arrayMethod};
-  methodMap_["booleanMethod"] = MethodMetadata{1, &CxxCrabyTestModule::booleanMethod};
-  methodMap_["camelMethod"] = MethodMetadata{0, &CxxCrabyTestModule::camelMethod};
-  methodMap_["enumMethod"] = MethodMetadata{2, &CxxCrabyTestModule::enumMethod};
-  methodMap_["getDataPath"] = MethodMetadata{0, &CxxCrabyTestModule::getDataPath};
-  methodMap_["getState"] = MethodMetadata{0, &CxxCrabyTestModule::getState};
-  methodMap_["nullableMethod"] = MethodMetadata{1, &CxxCrabyTestModule::nullableMethod};
-  methodMap_["numericMethod"] = MethodMetadata{1, &CxxCrabyTestModule::numericMethod};
-  methodMap_["objectMethod"] = MethodMetadata{1, &CxxCrabyTestModule::objectMethod};
-  methodMap_["PascalMethod"] = MethodMetadata{0, &CxxCrabyTestModule::pascalMethod};
-  methodMap_["promiseMethod"] = MethodMetadata{1, &CxxCrabyTestModule::promiseMethod};
-  methodMap_["readData"] = MethodMetadata{0, &CxxCrabyTestModule::readData};
-  methodMap_["setState"] = MethodMetadata{1, &CxxCrabyTestModule::setState};
-  methodMap_["snake_method"] = MethodMetadata{0, &CxxCrabyTestModule::snakeMethod};
-  methodMap_["stringMethod"] = MethodMetadata{1, &CxxCrabyTestModule::stringMethod};
-  methodMap_["triggerSignal"] = MethodMetadata{0, &CxxCrabyTestModule::triggerSignal};
-  methodMap_["writeData"] = MethodMetadata{1, &CxxCrabyTestModule::writeData};
-  methodMap_["onError"] = MethodMetadata{1, &CxxCrabyTestModule::onError};
-  methodMap_["onProgress"] = MethodMetadata{1, &CxxCrabyTestModule::onProgress};
-  methodMap_["onSignal"] = MethodMetadata{1, &CxxCrabyTestModule::onSignal};
+  executor_ = std::make_shared<craby::crabytest::utils::ModuleExecutor>(maxConcurrency);
+  runtimeCache_ = std::make_shared<craby::crabytest::utils::RuntimeCache>();
 }
 
 CxxCrabyTestModule::~CxxCrabyTestModule() {
   invalidate();
 }
 
+const CxxCrabyTestModule::MethodEntry *CxxCrabyTestModule::findMethod(std::string_view name) {
+  auto slot = kSlots[hashName(name) >> kHashShift];
+  if (slot == kNoMethod || kMethods[slot].name != name) {
+    return nullptr;
+  }
+  return &kMethods[slot];
+}
+
+jsi::Value CxxCrabyTestModule::create(jsi::Runtime &rt, const jsi::PropNameID &propName) {
+  if (runtime_.exchange(&rt) != &rt) {
+    craby::crabytest::utils::RuntimeCache::bind(rt, runtimeCache_);
+  }
+  auto entry = findMethod(propName.utf8(rt));
+  if (entry == nullptr) {
+    return jsi::Value::undefined();
+  }
+
+  auto invoker = entry->invoker;
+  return jsi::Function::createFromHostFunction(
+    rt,
+    propName,
+    static_cast<unsigned int>(entry->argCount),
+    [this, invoker](jsi::Runtime &rt, const jsi::Value &thisVal, const jsi::Value *args, size_t count) {
+      return invoker(rt, *this, args, count);
+    });
+}
+
+std::vector<jsi::PropNameID> CxxCrabyTestModule::getPropertyNames(jsi::Runtime &rt) {
+  std::vector<jsi::PropNameID> names;
+  names.reserve(kMethods.size());
+  for (auto &entry : kMethods) {
+    names.push_back(jsi::PropNameID::forAscii(rt, entry.name.data(), entry.name.size()));
+  }
+  return names;
+}
+
+std::shared_ptr<craby::crabytest::bridging::CrabyTest> &CxxCrabyTestModule::module() {
+  // Not recreated after `invalidate()`, the method rethrows the error as a `jsi::JSError`
+  if (invalidated_.load()) {
+    throw std::runtime_error("Module is invalidated");
+  }
+
+  // Created on the first call of the module, not on its construction by the TurboModule registry
+  std::call_once(moduleOnce_, [this] {
+    module_ = std::shared_ptr<craby::crabytest::bridging::CrabyTest>(
+      craby::crabytest::bridging::createCrabyTest(
+        reinterpret_cast<uintptr_t>(this),
+        rust::Str(dataPath.data(), dataPath.size())).into_raw(),
+      [](craby::crabytest::bridging::CrabyTest *ptr) { rust::Box<craby::crabytest::bridging::CrabyTest>::from_raw(ptr); }
+    );
+  });
+  return module_;
+}
+
 void CxxCrabyTestModule::invalidate() {
   if (invalidated_.exchange(true)) {
     return;
   }
 
-  invalidated_.store(true);
-  listenersMap_.clear();
+  // `jsi::PropNameID` must be released on the runtime's thread, before the runtime is destroyed
+  runtimeCache_.reset();
 
   // Unregister from signal manager
   uintptr_t id = reinterpret_cast<uintptr_t>(this);
   auto& manager = craby::crabytest::signals::SignalManager::getInstance();
   manager.unregisterDelegate(id);
 
-  // Shutdown thread pool
-  threadPool_->shutdown();
-}
-
-void CxxCrabyTestModule::emit(std::string name, bridging::CrabyTestSignal* signal) {
-  std::vector<std::shared_ptr<facebook::jsi::Function>> listeners;
   {
     std::lock_guard<std::mutex> lock(listenersMutex_);
-    auto it = listenersMap_.find(name);
-    if (it != listenersMap_.end()) {
-      for (auto &[_, listener] : it->second) {
-        listeners.push_back(listener);
-      }
+    for (auto& listeners : listeners_) {
+      listeners.clear();
     }
   }
 
-  // Prepare payload: extract from signal or use undefined
-  auto payloadPtr = std::make_shared<facebook::jsi::Value>();
-  
-  if (signal == nullptr) {
-    *payloadPtr = facebook::jsi::Value::undefined();
-  } else {
-    // Use shared_ptr to manage signal lifetime across async callbacks
-    auto signalPtr = std::shared_ptr<bridging::CrabyTestSignal>(
-      signal,
-      [](bridging::CrabyTestSignal* ptr) {
-        // Use Rust FFI function to drop signal memory
-        if (ptr != nullptr) {
-          craby::crabytest::bridging::drop_signal(ptr);
-        }
-      }
-    );
+  // Reject the promises of the queued tasks, the running ones finish on their own
+  executor_->shutdown();
+}
 
-    // Extract payload using FFI function and convert to jsi::Value
-    // We'll need to capture signalPtr in the lambda
-    for (auto& listener : listeners) {
-      try {
-        callInvoker_->invokeAsync([listener, signalPtr, name](jsi::Runtime &rt) {
-          jsi::Value data = jsi::Value::undefined();
-          if (name == "onError") {
-            auto payload = craby::crabytest::bridging::get_on_error_payload(*signalPtr);
-            data = react::bridging::toJs(rt, payload);
-          } else if (name == "onProgress") {
-            auto payload = craby::crabytest::bridging::get_on_progress_payload(*signalPtr);
-            data = react::bridging::toJs(rt, payload);
-          }
-          listener->call(rt, data);
-        });
-      } catch (const std::exception& err) {
-        // Noop
+void CxxCrabyTestModule::emit(SignalId signalId, bridging::CrabyTestSignal* signal) {
+  // Use shared_ptr to manage signal lifetime across async callbacks
+  auto signalPtr = std::shared_ptr<bridging::CrabyTestSignal>(
+    signal,
+    [](bridging::CrabyTestSignal* ptr) {
+      // Use Rust FFI function to drop signal memory
+      if (ptr != nullptr) {
+        craby::crabytest::bridging::drop_signal(ptr);
       }
     }
+  );
+
+  auto index = static_cast<size_t>(signalId);
+  std::vector<std::shared_ptr<facebook::jsi::Function>> listeners;
+  {
+    std::lock_guard<std::mutex> lock(listenersMutex_);
+    for (auto &[_, listener] : listeners_[index]) {
+      listeners.push_back(listener);
+    }
+  }
+
+  if (listeners.empty()) {
     return;
   }
 
-  for (auto& listener : listeners) {
+  auto signalQueue = signalQueues_[index];
+  if (!signalQueue) {
+    // `every`: Deliver each signal
     try {
-      callInvoker_->invokeAsync([listener, payloadPtr](jsi::Runtime &rt) {
+      callInvoker_->invokeAsync([listeners, signalPtr, signalId](jsi::Runtime &rt) {
         try {
-          listener->call(rt, *payloadPtr);
+          auto data = signalPayload(rt, signalId, signalPtr.get());
+          for (auto& listener : listeners) {
+            listener->call(rt, data);
+          }
         } catch (const jsi::JSError &err) {
           throw err;
         } catch (const std::exception &err) {
@@ -139,6 +219,107 @@ void CxxCrabyTestModule::emit(std::string name, bridging::CrabyTestSignal* signa
     } catch (const std::exception& err) {
       // Noop
     }
+    return;
+  }
+
+  // `latest` and `batch`: Schedule a single flush for the pending signals
+  if (!signalQueue->push(std::move(signalPtr))) {
+    return;
+  }
+
+  try {
+    callInvoker_->invokeAsync([listeners, signalQueue, signalId](jsi::Runtime &rt) {
+      try {
+        auto signals = signalQueue->take();
+        if (signals.empty()) {
+          return;
+        }
+
+        jsi::Value data;
+        if (signalQueue->isLatest()) {
+          data = signalPayload(rt, signalId, signals.back().get());
+        } else {
+          auto arr = jsi::Array(rt, signals.size());
+          for (size_t i = 0; i < signals.size(); i++) {
+            arr.setValueAtIndex(rt, i, signalPayload(rt, signalId, signals[i].get()));
+          }
+          data = std::move(arr);
+        }
+
+        for (auto& listener : listeners) {
+          listener->call(rt, data);
+        }
+      } catch (const jsi::JSError &err) {
+        throw err;
+      } catch (const std::exception &err) {
+        throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+      }
+    });
+  } catch (const std::exception& err) {
+    // Noop
+  }
+}
+
+jsi::Value CxxCrabyTestModule::signalPayload(jsi::Runtime &rt,
+                                    SignalId signalId,
+                                    const bridging::CrabyTestSignal *signal) {
+  if (signal == nullptr) {
+    return jsi::Value::undefined();
+  }
+
+  switch (signalId) {
+    case SignalId::OnError: {
+      auto payload = craby::crabytest::bridging::get_on_error_payload(*signal);
+      return react::bridging::toJs(rt, std::move(payload));
+    }
+    case SignalId::OnProgress: {
+      auto payload = craby::crabytest::bridging::get_on_progress_payload(*signal);
+      return react::bridging::toJs(rt, std::move(payload));
+    }
+    default:
+      return jsi::Value::undefined();
+  }
+}
+
+jsi::Value CxxCrabyTestModule::abortablePromiseMethod(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (2 != count) {
+      throw jsi::JSError(rt, "Expected 2 arguments");
+    }
+
+    auto &it_ = thisModule.module();
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    auto arg1 = craby::crabytest::utils::AbortToken();
+    react::AsyncPromise<double> promise(rt, callInvoker);
+    arg1.bind(rt, args[1], promise);
+
+    thisModule.executor_->enqueue(craby::crabytest::utils::withCancel([it_, promise, arg0, arg1]() mutable {
+      try {
+        if (arg1.aborted()) {
+          return;
+        }
+        auto ret = craby::crabytest::bridging::abortablePromiseMethod(*it_, arg0, arg1);
+        promise.resolve(std::move(ret));
+      } catch (const jsi::JSError &err) {
+        promise.reject(err.getMessage());
+      } catch (const std::exception &err) {
+        promise.reject(craby::crabytest::utils::errorMessage(err));
+      }
+    }, [promise]() mutable {
+      promise.reject("Module is invalidated");
+    }));
+
+    return react::bridging::toJs(rt, promise);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
   }
 }
 
@@ -147,18 +328,19 @@ jsi::Value CxxCrabyTestModule::arrayBufferMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0 = react::bridging::fromJs<rust::Vec<uint8_t>>(rt, args[0], callInvoker);
+    auto &it_ = thisModule.module();
+    auto arg0Buf = args[0].asObject(rt).getArrayBuffer(rt);
+    auto arg0 = rust::Slice<uint8_t>(arg0Buf.data(rt), arg0Buf.size(rt));
     auto ret = craby::crabytest::bridging::arrayBufferMethod(*it_, arg0);
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -171,18 +353,50 @@ jsi::Value CxxCrabyTestModule::arrayMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<rust::Vec<double>>(rt, args[0], callInvoker);
-    auto ret = craby::crabytest::bridging::arrayMethod(*it_, arg0);
+    auto ret = craby::crabytest::bridging::arrayMethod(*it_, std::move(arg0));
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxCrabyTestModule::asyncPromiseMethod(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto &it_ = thisModule.module();
+    auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
+    react::AsyncPromise<double> promise(rt, callInvoker);
+    auto op = craby::crabytest::utils::promiseOp(promise, &craby::crabytest::bridging::asyncPromiseMethodResult);
+
+    try {
+      craby::crabytest::bridging::asyncPromiseMethod(*it_, arg0, reinterpret_cast<size_t>(op));
+    } catch (const std::exception &err) {
+      delete op;
+      promise.reject(craby::crabytest::utils::errorMessage(err));
+    }
+
+    return react::bridging::toJs(rt, promise);
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -195,14 +409,14 @@ jsi::Value CxxCrabyTestModule::booleanMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<bool>(rt, args[0], callInvoker);
     auto ret = craby::crabytest::bridging::booleanMethod(*it_, arg0);
 
@@ -219,14 +433,14 @@ jsi::Value CxxCrabyTestModule::camelMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     craby::crabytest::bridging::camelMethod(*it_);
 
     return jsi::Value::undefined();
@@ -237,24 +451,47 @@ jsi::Value CxxCrabyTestModule::camelMethod(jsi::Runtime &rt,
   }
 }
 
+jsi::Value CxxCrabyTestModule::createDataStream(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 arguments");
+    }
+
+    auto &it_ = thisModule.module();
+    auto ret = craby::crabytest::bridging::createDataStream(*it_);
+
+    return craby::crabytest::utils::byteStreamToJs(rt, std::move(ret), callInvoker);
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
 jsi::Value CxxCrabyTestModule::enumMethod(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (2 != count) {
       throw jsi::JSError(rt, "Expected 2 arguments");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<craby::crabytest::bridging::MyEnum>(rt, args[0], callInvoker);
     auto arg1 = react::bridging::fromJs<craby::crabytest::bridging::SwitchState>(rt, args[1], callInvoker);
     auto ret = craby::crabytest::bridging::enumMethod(*it_, arg0, arg1);
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -267,17 +504,17 @@ jsi::Value CxxCrabyTestModule::getDataPath(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     auto ret = craby::crabytest::bridging::getDataPath(*it_);
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -290,14 +527,14 @@ jsi::Value CxxCrabyTestModule::getState(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     auto ret = craby::crabytest::bridging::getState(*it_);
 
     return react::bridging::toJs(rt, ret);
@@ -308,23 +545,46 @@ jsi::Value CxxCrabyTestModule::getState(jsi::Runtime &rt,
   }
 }
 
+jsi::Value CxxCrabyTestModule::mapData(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 arguments");
+    }
+
+    auto &it_ = thisModule.module();
+    auto ret = craby::crabytest::bridging::mapData(*it_);
+
+    return craby::crabytest::utils::mappedFileToJs(rt, std::move(ret));
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
 jsi::Value CxxCrabyTestModule::nullableMethod(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<craby::crabytest::bridging::NullableNumber>(rt, args[0], callInvoker);
-    auto ret = craby::crabytest::bridging::nullableMethod(*it_, arg0);
+    auto ret = craby::crabytest::bridging::nullableMethod(*it_, std::move(arg0));
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -337,14 +597,14 @@ jsi::Value CxxCrabyTestModule::numericMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
     auto ret = craby::crabytest::bridging::numericMethod(*it_, arg0);
 
@@ -361,18 +621,41 @@ jsi::Value CxxCrabyTestModule::objectMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<craby::crabytest::bridging::TestObject>(rt, args[0], callInvoker);
-    auto ret = craby::crabytest::bridging::objectMethod(*it_, arg0);
+    auto ret = craby::crabytest::bridging::objectMethod(*it_, std::move(arg0));
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
+jsi::Value CxxCrabyTestModule::openDataStream(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 arguments");
+    }
+
+    auto &it_ = thisModule.module();
+    auto ret = craby::crabytest::bridging::openDataStream(*it_);
+
+    return craby::crabytest::utils::byteStreamToJs(rt, std::move(ret), callInvoker);
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -385,14 +668,14 @@ jsi::Value CxxCrabyTestModule::pascalMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     craby::crabytest::bridging::pascalMethod(*it_);
 
     return jsi::Value::undefined();
@@ -403,32 +686,57 @@ jsi::Value CxxCrabyTestModule::pascalMethod(jsi::Runtime &rt,
   }
 }
 
+jsi::Value CxxCrabyTestModule::positionState(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (0 != count) {
+      throw jsi::JSError(rt, "Expected 0 arguments");
+    }
+
+    auto &it_ = thisModule.module();
+    auto ret = craby::crabytest::bridging::positionState(*it_);
+
+    return craby::crabytest::utils::sharedStateToJs(rt, std::move(ret), {"x", "y"});
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
 jsi::Value CxxCrabyTestModule::promiseMethod(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
     react::AsyncPromise<double> promise(rt, callInvoker);
 
-    thisModule.threadPool_->enqueue([it_, promise, arg0]() mutable {
+    thisModule.executor_->enqueue(craby::crabytest::utils::withCancel([it_, promise, arg0]() mutable {
       try {
         auto ret = craby::crabytest::bridging::promiseMethod(*it_, arg0);
-        promise.resolve(ret);
+        promise.resolve(std::move(ret));
       } catch (const jsi::JSError &err) {
         promise.reject(err.getMessage());
       } catch (const std::exception &err) {
         promise.reject(craby::crabytest::utils::errorMessage(err));
       }
-    });
+    }, [promise]() mutable {
+      promise.reject("Module is invalidated");
+    }));
 
     return react::bridging::toJs(rt, promise);
   } catch (const jsi::JSError &err) {
@@ -443,17 +751,17 @@ jsi::Value CxxCrabyTestModule::readData(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     auto ret = craby::crabytest::bridging::readData(*it_);
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -466,14 +774,14 @@ jsi::Value CxxCrabyTestModule::setState(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto arg0 = react::bridging::fromJs<double>(rt, args[0], callInvoker);
     craby::crabytest::bridging::setState(*it_, arg0);
 
@@ -490,14 +798,14 @@ jsi::Value CxxCrabyTestModule::snakeMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     craby::crabytest::bridging::snakeMethod(*it_);
 
     return jsi::Value::undefined();
@@ -513,19 +821,18 @@ jsi::Value CxxCrabyTestModule::stringMethod(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0$raw = args[0].asString(rt).utf8(rt);
-    auto arg0 = rust::Str(arg0$raw.data(), arg0$raw.size());
+    auto &it_ = thisModule.module();
+    auto arg0 = craby::crabytest::utils::ScratchUtf8(rt, args[0].asString(rt));
     auto ret = craby::crabytest::bridging::stringMethod(*it_, arg0);
 
-    return react::bridging::toJs(rt, ret);
+    return react::bridging::toJs(rt, std::move(ret));
   } catch (const jsi::JSError &err) {
     throw err;
   } catch (const std::exception &err) {
@@ -538,17 +845,17 @@ jsi::Value CxxCrabyTestModule::triggerSignal(jsi::Runtime &rt,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (0 != count) {
-      throw jsi::JSError(rt, "Expected 0 argument");
+      throw jsi::JSError(rt, "Expected 0 arguments");
     }
 
+    auto &it_ = thisModule.module();
     react::AsyncPromise<std::monostate> promise(rt, callInvoker);
 
-    thisModule.threadPool_->enqueue([it_, promise]() mutable {
+    thisModule.executor_->enqueue(craby::crabytest::utils::withCancel([it_, promise]() mutable {
       try {
         craby::crabytest::bridging::triggerSignal(*it_);
         promise.resolve(std::monostate{});
@@ -557,7 +864,9 @@ jsi::Value CxxCrabyTestModule::triggerSignal(jsi::Runtime &rt,
       } catch (const std::exception &err) {
         promise.reject(craby::crabytest::utils::errorMessage(err));
       }
-    });
+    }, [promise]() mutable {
+      promise.reject("Module is invalidated");
+    }));
 
     return react::bridging::toJs(rt, promise);
   } catch (const jsi::JSError &err) {
@@ -567,21 +876,45 @@ jsi::Value CxxCrabyTestModule::triggerSignal(jsi::Runtime &rt,
   }
 }
 
+jsi::Value CxxCrabyTestModule::typedArrayMethod(jsi::Runtime &rt,
+                                react::TurboModule &turboModule,
+                                const jsi::Value args[],
+                                size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+  auto &callInvoker = thisModule.callInvoker_;
+
+  try {
+    if (1 != count) {
+      throw jsi::JSError(rt, "Expected 1 argument");
+    }
+
+    auto &it_ = thisModule.module();
+    auto arg0Obj = args[0].asObject(rt);
+    auto arg0 = craby::crabytest::utils::typedArraySlice<double>(rt, arg0Obj);
+    auto ret = craby::crabytest::bridging::typedArrayMethod(*it_, arg0);
+
+    return craby::crabytest::utils::typedArrayToJs(rt, std::move(ret), "Float64Array");
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
 jsi::Value CxxCrabyTestModule::writeData(jsi::Runtime &rt,
                                 react::TurboModule &turboModule,
                                 const jsi::Value args[],
                                 size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
-    auto arg0$raw = args[0].asString(rt).utf8(rt);
-    auto arg0 = rust::Str(arg0$raw.data(), arg0$raw.size());
+    auto &it_ = thisModule.module();
+    auto arg0 = craby::crabytest::utils::ScratchUtf8(rt, args[0].asString(rt));
     auto ret = craby::crabytest::bridging::writeData(*it_, arg0);
 
     return react::bridging::toJs(rt, ret);
@@ -597,38 +930,28 @@ jsi::Value CxxCrabyTestModule::onError(jsi::Runtime &rt,
                       const jsi::Value args[],
                       size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto callback = args[0].asObject(rt).asFunction(rt);
     auto callbackRef = std::make_shared<jsi::Function>(std::move(callback));
     auto id = thisModule.nextListenerId_.fetch_add(1);
-    auto name = "onError";
-
-    if (thisModule.listenersMap_.find(name) == thisModule.listenersMap_.end()) {
-      thisModule.listenersMap_[name] = std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>();
-    }
+    auto signalId = static_cast<size_t>(SignalId::OnError);
 
     {
       std::lock_guard<std::mutex> lock(thisModule.listenersMutex_);
-      thisModule.listenersMap_[name].emplace(id, callbackRef);
+      thisModule.listeners_[signalId].emplace(id, callbackRef);
     }
 
     auto modulePtr = &thisModule;
-    auto cleanup = [modulePtr, name, id] {
+    auto cleanup = [modulePtr, signalId, id] {
       std::lock_guard<std::mutex> lock(modulePtr->listenersMutex_);
-      auto eventMap = modulePtr->listenersMap_.find(name);
-      if (eventMap != modulePtr->listenersMap_.end()) {
-        auto it = eventMap->second.find(id);
-        if (it != eventMap->second.end()) {
-          eventMap->second.erase(it);
-        }
-      }
+      modulePtr->listeners_[signalId].erase(id);
       return jsi::Value::undefined();
     };
 
@@ -652,38 +975,28 @@ jsi::Value CxxCrabyTestModule::onProgress(jsi::Runtime &rt,
                       const jsi::Value args[],
                       size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto callback = args[0].asObject(rt).asFunction(rt);
     auto callbackRef = std::make_shared<jsi::Function>(std::move(callback));
     auto id = thisModule.nextListenerId_.fetch_add(1);
-    auto name = "onProgress";
-
-    if (thisModule.listenersMap_.find(name) == thisModule.listenersMap_.end()) {
-      thisModule.listenersMap_[name] = std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>();
-    }
+    auto signalId = static_cast<size_t>(SignalId::OnProgress);
 
     {
       std::lock_guard<std::mutex> lock(thisModule.listenersMutex_);
-      thisModule.listenersMap_[name].emplace(id, callbackRef);
+      thisModule.listeners_[signalId].emplace(id, callbackRef);
     }
 
     auto modulePtr = &thisModule;
-    auto cleanup = [modulePtr, name, id] {
+    auto cleanup = [modulePtr, signalId, id] {
       std::lock_guard<std::mutex> lock(modulePtr->listenersMutex_);
-      auto eventMap = modulePtr->listenersMap_.find(name);
-      if (eventMap != modulePtr->listenersMap_.end()) {
-        auto it = eventMap->second.find(id);
-        if (it != eventMap->second.end()) {
-          eventMap->second.erase(it);
-        }
-      }
+      modulePtr->listeners_[signalId].erase(id);
       return jsi::Value::undefined();
     };
 
@@ -707,38 +1020,28 @@ jsi::Value CxxCrabyTestModule::onSignal(jsi::Runtime &rt,
                       const jsi::Value args[],
                       size_t count) {
   auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
-  auto callInvoker = thisModule.callInvoker_;
-  auto it_ = thisModule.module_;
+  auto &callInvoker = thisModule.callInvoker_;
 
   try {
     if (1 != count) {
       throw jsi::JSError(rt, "Expected 1 argument");
     }
 
+    auto &it_ = thisModule.module();
     auto callback = args[0].asObject(rt).asFunction(rt);
     auto callbackRef = std::make_shared<jsi::Function>(std::move(callback));
     auto id = thisModule.nextListenerId_.fetch_add(1);
-    auto name = "onSignal";
-
-    if (thisModule.listenersMap_.find(name) == thisModule.listenersMap_.end()) {
-      thisModule.listenersMap_[name] = std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>();
-    }
+    auto signalId = static_cast<size_t>(SignalId::OnSignal);
 
     {
       std::lock_guard<std::mutex> lock(thisModule.listenersMutex_);
-      thisModule.listenersMap_[name].emplace(id, callbackRef);
+      thisModule.listeners_[signalId].emplace(id, callbackRef);
     }
 
     auto modulePtr = &thisModule;
-    auto cleanup = [modulePtr, name, id] {
+    auto cleanup = [modulePtr, signalId, id] {
       std::lock_guard<std::mutex> lock(modulePtr->listenersMutex_);
-      auto eventMap = modulePtr->listenersMap_.find(name);
-      if (eventMap != modulePtr->listenersMap_.end()) {
-        auto it = eventMap->second.find(id);
-        if (it != eventMap->second.end()) {
-          eventMap->second.erase(it);
-        }
-      }
+      modulePtr->listeners_[signalId].erase(id);
       return jsi::Value::undefined();
     };
 
@@ -757,6 +1060,55 @@ jsi::Value CxxCrabyTestModule::onSignal(jsi::Runtime &rt,
   }
 }
 
+jsi::Value CxxCrabyTestModule::batch(jsi::Runtime &rt,
+                      react::TurboModule &turboModule,
+                      const jsi::Value args[],
+                      size_t count) {
+  auto &thisModule = static_cast<CxxCrabyTestModule &>(turboModule);
+
+  if (1 != count) {
+    throw jsi::JSError(rt, "Expected 1 argument");
+  }
+
+  try {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<CxxCrabyTestModule>(rt, {"method", "args"});
+    auto ops = args[0].asObject(rt).asArray(rt);
+    auto size = ops.size(rt);
+    auto results = jsi::Array(rt, size);
+    std::vector<jsi::Value> opArgs;
+
+    for (size_t i = 0; i < size; i++) {
+      auto op = ops.getValueAtIndex(rt, i).asObject(rt);
+      auto method = op.getProperty(rt, (*props)[0]).asString(rt).utf8(rt);
+      auto entry = findMethod(method);
+      if (entry == nullptr) {
+        throw jsi::JSError(rt, "Unknown method: " + method);
+      }
+      // A nested `batch` or a `Promise` in the results would not run (or settle) within the batch
+      if (!entry->batchable) {
+        throw jsi::JSError(rt, "Method cannot be batched: " + method);
+      }
+
+      // Each call checks its arguments as if it was called directly
+      auto arr = op.getProperty(rt, (*props)[1]).asObject(rt).asArray(rt);
+      auto argCount = arr.size(rt);
+      opArgs.clear();
+      opArgs.reserve(argCount);
+      for (size_t j = 0; j < argCount; j++) {
+        opArgs.push_back(arr.getValueAtIndex(rt, j));
+      }
+
+      results.setValueAtIndex(rt, i, entry->invoker(rt, thisModule, opArgs.data(), argCount));
+    }
+
+    return results;
+  } catch (const jsi::JSError &err) {
+    throw err;
+  } catch (const std::exception &err) {
+    throw jsi::JSError(rt, craby::crabytest::utils::errorMessage(err));
+  }
+}
+
 } // namespace modules
 } // namespace crabytest
 } // namespace craby
@@ -4,8 +4,12 @@
 #include "CrabyUtils.hpp"
 #include "ffi.rs.h"
 #include <ReactCommon/TurboModule.h>
+#include <array>
 #include <jsi/jsi.h>
 #include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
 
 namespace craby {
 namespace crabytest {
@@ -15,12 +19,44 @@ class JSI_EXPORT CxxCrabyTestModule : public facebook::react::TurboModule {
 public:
   static constexpr const char *kModuleName = "CrabyTest";
   static std::string dataPath;
+  // Max number of running async tasks of this module (`0` = limited by the shared executor's worker count)
+  static size_t maxConcurrency;
+
+  enum class SignalId : uint32_t {
+    OnError = 0,
+    OnProgress = 1,
+    OnSignal = 2,
+  };
+  static constexpr size_t kSignalCount = 3;
+
+  struct MethodEntry {
+    std::string_view name;
+    size_t argCount;
+    facebook::jsi::Value (*invoker)(
+        facebook::jsi::Runtime &rt,
+        facebook::react::TurboModule &turboModule,
+        const facebook::jsi::Value args[], size_t count);
+    // `false` for `batch` and the methods returning a `Promise`, which `batch` rejects
+    bool batchable;
+  };
 
   CxxCrabyTestModule(std::shared_ptr<facebook::react::CallInvoker> jsInvoker);
   ~CxxCrabyTestModule();
 
   void invalidate();
-  void emit(std::string name, bridging::CrabyTestSignal* signal);
+  std::vector<facebook::jsi::PropNameID> getPropertyNames(facebook::jsi::Runtime &rt) override;
+  static const MethodEntry *findMethod(std::string_view name);
+  void emit(SignalId signalId, bridging::CrabyTestSignal* signal);
+
+  static facebook::jsi::Value
+  signalPayload(facebook::jsi::Runtime &rt,
+      SignalId signalId,
+      const bridging::CrabyTestSignal *signal);
+
+  static facebook::jsi::Value
+  abortablePromiseMethod(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
 
   static facebook::jsi::Value
   arrayBufferMethod(facebook::jsi::Runtime &rt,
@@ -32,6 +68,11 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  asyncPromiseMethod(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
   static facebook::jsi::Value
   booleanMethod(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
@@ -42,6 +83,11 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  createDataStream(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
   static facebook::jsi::Value
   enumMethod(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
@@ -57,6 +103,11 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  mapData(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
   static facebook::jsi::Value
   nullableMethod(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
@@ -72,11 +123,21 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  openDataStream(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
   static facebook::jsi::Value
   pascalMethod(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  positionState(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
   static facebook::jsi::Value
   promiseMethod(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
@@ -107,6 +168,11 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  typedArrayMethod(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
   static facebook::jsi::Value
   writeData(facebook::jsi::Runtime &rt,
       facebook::react::TurboModule &turboModule,
@@ -127,17 +193,36 @@ public:
       facebook::react::TurboModule &turboModule,
       const facebook::jsi::Value args[], size_t count);
 
+  static facebook::jsi::Value
+  batch(facebook::jsi::Runtime &rt,
+      facebook::react::TurboModule &turboModule,
+      const facebook::jsi::Value args[], size_t count);
+
 protected:
+  facebook::jsi::Value create(facebook::jsi::Runtime &rt, const facebook::jsi::PropNameID &propName) override;
+  std::shared_ptr<craby::crabytest::bridging::CrabyTest> &module();
+
   std::shared_ptr<facebook::react::CallInvoker> callInvoker_;
-  std::shared_ptr<craby::crabytest::bridging::CrabyTest> module_;
+  // Runtime the module is installed into (the main runtime or a worker runtime, see `CrabyRuntime.hpp`)
+  std::atomic<facebook::jsi::Runtime *> runtime_{nullptr};
+  // JSI values cached for `runtime_` (see `RuntimeCache`), released by `invalidate()`
+  std::shared_ptr<craby::crabytest::utils::RuntimeCache> runtimeCache_;
   std::atomic<bool> invalidated_{false};
   std::atomic<size_t> nextListenerId_{0};
+  std::shared_ptr<craby::crabytest::utils::ModuleExecutor> executor_;
   std::mutex listenersMutex_;
-  std::unordered_map<
-    std::string,
-    std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>>
-    listenersMap_;
-  std::shared_ptr<craby::crabytest::utils::ThreadPool> threadPool_;
+  std::array<
+    std::unordered_map<size_t, std::shared_ptr<facebook::jsi::Function>>,
+    kSignalCount>
+    listeners_;
+  std::array<
+    std::shared_ptr<craby::crabytest::utils::SignalQueue<bridging::CrabyTestSignal>>,
+    kSignalCount>
+    signalQueues_;
+
+private:
+  std::once_flag moduleOnce_;
+  std::shared_ptr<craby::crabytest::bridging::CrabyTest> module_;
 };
 
 } // namespace modules
@@ -1,10 +1,23 @@
 // Auto generated by Craby. DO NOT EDIT.
 #pragma once
 
+#include "CrabyUtils.hpp"
 #include "cxx.h"
 #include "ffi.rs.h"
 #include <react/bridging/Bridging.h>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 using namespace facebook;
 
@@ -15,7 +28,10 @@ public:
   explicit RustVecBuffer(rust::Vec<uint8_t> vec)
     : vec_(std::move(vec)) {}
 
-  ~RustVecBuffer() override = default;
+  // Give the buffer back to the Rust side buffer pool (`craby::pool`)
+  ~RustVecBuffer() override {
+    craby::crabytest::bridging::recycleBuffer(std::move(vec_));
+  }
 
   size_t size() const override {
     return vec_.size();
@@ -31,12 +47,438 @@ private:
 
 } // namespace crabytest
 
+namespace craby {
+namespace crabytest {
+namespace utils {
+
+template <typename T>
+class RustTypedVecBuffer : public jsi::MutableBuffer {
+public:
+  explicit RustTypedVecBuffer(rust::Vec<T> vec)
+    : vec_(std::move(vec)) {}
+
+  ~RustTypedVecBuffer() override = default;
+
+  size_t size() const override {
+    return vec_.size() * sizeof(T);
+  }
+
+  uint8_t* data() override {
+    return reinterpret_cast<uint8_t*>(const_cast<T*>(vec_.data()));
+  }
+
+private:
+  rust::Vec<T> vec_;
+};
+
+// Name of the typed array with elements of type `T` (eg. `Float64Array` for `double`)
+template <typename T>
+constexpr const char* typedArrayName() {
+  if constexpr (std::is_same_v<T, double>) {
+    return "Float64Array";
+  } else if constexpr (std::is_same_v<T, float>) {
+    return "Float32Array";
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return "Int32Array";
+  } else if constexpr (std::is_same_v<T, int16_t>) {
+    return "Int16Array";
+  } else {
+    static_assert(std::is_same_v<T, uint8_t>, "Unsupported typed array element type");
+    return "Uint8Array";
+  }
+}
+
+// Borrows the elements of a typed array (eg. `Float64Array`) from its underlying `ArrayBuffer`.
+// The slice is valid as long as the typed array object is alive.
+// Throws if the value is not a typed array of `T` or its view is out of the bounds of the buffer.
+template <typename T>
+rust::Slice<T> typedArraySlice(jsi::Runtime& rt, const jsi::Object& typedArray) {
+  constexpr auto name = typedArrayName<T>();
+  if (!typedArray.instanceOf(rt, rt.global().getPropertyAsFunction(rt, name))) {
+    throw jsi::JSError(rt, std::string("Expected ") + name);
+  }
+
+  auto buffer = typedArray.getProperty(rt, "buffer").asObject(rt).getArrayBuffer(rt);
+  auto byteOffset = static_cast<size_t>(typedArray.getProperty(rt, "byteOffset").asNumber());
+  auto length = static_cast<size_t>(typedArray.getProperty(rt, "length").asNumber());
+  auto size = buffer.size(rt);
+  if (byteOffset > size || length > (size - byteOffset) / sizeof(T) || byteOffset % alignof(T) != 0) {
+    throw jsi::JSError(rt, std::string("Out of bounds ") + name);
+  }
+
+  return rust::Slice<T>(reinterpret_cast<T*>(buffer.data(rt) + byteOffset), length);
+}
+
+// Mutable slices borrowed by the arguments of a call.
+// A slice overlapping a previous one (eg. two views of the same `ArrayBuffer`) is passed as a copy,
+// so the Rust side never receives aliasing `&mut` slices. Writes through the copy are not visible to JS.
+class BorrowedSlices {
+public:
+  template <typename T>
+  rust::Slice<T> borrow(rust::Slice<T> slice) {
+    if (slice.empty()) {
+      return slice;
+    }
+
+    auto begin = reinterpret_cast<uintptr_t>(slice.data());
+    auto end = begin + slice.size() * sizeof(T);
+    for (const auto& [otherBegin, otherEnd] : ranges_) {
+      if (begin < otherEnd && otherBegin < end) {
+        std::shared_ptr<T[]> copy(new T[slice.size()]);
+        std::copy(slice.begin(), slice.end(), copy.get());
+        copies_.push_back(copy);
+        return rust::Slice<T>(copy.get(), slice.size());
+      }
+    }
+
+    ranges_.emplace_back(begin, end);
+    return slice;
+  }
+
+private:
+  std::vector<std::pair<uintptr_t, uintptr_t>> ranges_;
+  std::vector<std::shared_ptr<void>> copies_;
+};
+
+// Copies the elements into a new `rust::Vec` with a single `memcpy` on the Rust side
+// (`push_back` makes two FFI calls per element: `reserve_total` and `set_len`)
+template <typename T>
+rust::Vec<T> vecFromSlice(rust::Slice<const T> slice) {
+  if constexpr (std::is_same_v<T, double>) {
+    return craby::crabytest::bridging::vecFromF64Slice(slice);
+  } else if constexpr (std::is_same_v<T, float>) {
+    return craby::crabytest::bridging::vecFromF32Slice(slice);
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return craby::crabytest::bridging::vecFromI32Slice(slice);
+  } else if constexpr (std::is_same_v<T, int16_t>) {
+    return craby::crabytest::bridging::vecFromI16Slice(slice);
+  } else {
+    static_assert(std::is_same_v<T, uint8_t>, "Unsupported typed array element type");
+    return craby::crabytest::bridging::vecFromU8Slice(slice);
+  }
+}
+
+template <typename T>
+rust::Vec<T> typedArrayFromJs(jsi::Runtime& rt, const jsi::Value& value) {
+  auto slice = typedArraySlice<T>(rt, value.asObject(rt));
+  return vecFromSlice<T>(rust::Slice<const T>(slice.data(), slice.size()));
+}
+
+// Creates a typed array (eg. `new Float64Array(buffer)`) backed by the `rust::Vec` without copying.
+template <typename T>
+jsi::Value typedArrayToJs(jsi::Runtime& rt, rust::Vec<T> vec, const char* name) {
+  std::shared_ptr<jsi::MutableBuffer> buffer;
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    buffer = std::make_shared<::crabytest::RustVecBuffer>(std::move(vec));
+  } else {
+    buffer = std::make_shared<RustTypedVecBuffer<T>>(std::move(vec));
+  }
+
+  auto arrayBuffer = jsi::ArrayBuffer(rt, buffer);
+  return rt.global().getPropertyAsFunction(rt, name).callAsConstructor(rt, arrayBuffer);
+}
+
+// UTF-8 copy of a JS string in the thread's `ScratchArena`, borrowed as `rust::Str` within the call.
+// Not movable: the copy is released when it goes out of scope, in reverse order of the allocations.
+// Non-ASCII strings (or all strings before JSI 14) are transcoded by the engine (`utf8`).
+class ScratchUtf8 {
+public:
+  ScratchUtf8(jsi::Runtime& rt, const jsi::String& str)
+    : arena_(ScratchArena::local()), mark_(arena_.mark()) {
+#if JSI_VERSION >= 14
+    bool ascii = true;
+    auto append = [&](bool isAscii, const void* chunk, size_t num) {
+      ascii = ascii && isAscii;
+      if (ascii) {
+        data_ = size_ == 0 ? arena_.allocate(num) : arena_.grow(data_, size_, size_ + num);
+        std::memcpy(data_ + size_, chunk, num);
+        size_ += num;
+      }
+    };
+    str.getStringData(rt, append);
+    if (ascii) {
+      return;
+    }
+    arena_.release(mark_);
+#endif
+    fallback_ = str.utf8(rt);
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+  }
+
+  ~ScratchUtf8() {
+    arena_.release(mark_);
+  }
+
+  ScratchUtf8(const ScratchUtf8&) = delete;
+  ScratchUtf8& operator=(const ScratchUtf8&) = delete;
+
+  operator rust::Str() const {
+    return rust::Str(data_, size_);
+  }
+
+private:
+  ScratchArena& arena_;
+  ScratchArena::Mark mark_;
+  char* data_ = nullptr;
+  size_t size_ = 0;
+  std::string fallback_;
+};
+
+// UTF-8 copy of a JS string, borrowed as `rust::Str` for the lifetime of the buffer.
+// Moved into the tasks of `Promise` methods, which outlive the call (`ScratchUtf8` is used otherwise).
+// ASCII strings are copied straight from the engine's string storage where JSI exposes it (`getStringData`),
+// the others are transcoded by the engine (`utf8`).
+class Utf8Buffer {
+public:
+  Utf8Buffer(jsi::Runtime& rt, const jsi::String& str) {
+#if JSI_VERSION >= 14
+    bool ascii = true;
+    auto append = [&](bool isAscii, const void* data, size_t num) {
+      ascii = ascii && isAscii;
+      if (ascii) {
+        data_.append(static_cast<const char*>(data), num);
+      }
+    };
+    str.getStringData(rt, append);
+    if (ascii) {
+      return;
+    }
+#endif
+    data_ = str.utf8(rt);
+  }
+
+  operator rust::Str() const {
+    return rust::Str(data_.data(), data_.size());
+  }
+
+private:
+  std::string data_;
+};
+
+// Converts a JS string into a `rust::String`.
+// A string delivered in a single chunk by `getStringData` is copied (or transcoded from UTF-16)
+// straight into the Rust allocation, without an intermediate `std::string`.
+inline rust::String stringFromJs(jsi::Runtime& rt, const jsi::String& str) {
+#if JSI_VERSION >= 14
+  std::optional<rust::String> ret;
+  bool chunked = false;
+  auto convert = [&](bool ascii, const void* data, size_t num) {
+    if (ret || chunked) {
+      chunked = true;
+      return;
+    }
+    ret = ascii ? rust::String(static_cast<const char*>(data), num)
+                : rust::String::lossy(static_cast<const char16_t*>(data), num);
+  };
+  str.getStringData(rt, convert);
+  if (!chunked) {
+    return ret ? std::move(*ret) : rust::String();
+  }
+#endif
+  auto utf8 = str.utf8(rt);
+  return rust::String(utf8.data(), utf8.size());
+}
+
+// JSI values reused across the calls of a module instance (eg. the `jsi::PropNameID` tables of the struct fields).
+//
+// The cache is owned by the module and bound to the runtime it is installed into, on the thread of that runtime.
+// Conversions find the cache of their runtime among the caches bound on the current thread, so lookups don't lock,
+// and the values are released with the module (`invalidate()`) instead of outliving the runtime.
+// Without a bound cache (eg. after `invalidate()`), the values are created for each conversion.
+class RuntimeCache {
+public:
+  using Table = std::vector<jsi::PropNameID>;
+
+  // Binds the cache to `rt`, called on the thread of the runtime
+  static void bind(jsi::Runtime& rt, const std::shared_ptr<RuntimeCache>& cache) {
+    auto& caches = boundCaches();
+    caches.erase(
+      std::remove_if(caches.begin(), caches.end(), [](const auto& entry) { return entry.second.expired(); }),
+      caches.end());
+    caches.emplace_back(&rt, cache);
+  }
+
+  // Cache bound to `rt` on the current thread (`nullptr` if none)
+  static std::shared_ptr<RuntimeCache> find(jsi::Runtime& rt) {
+    for (const auto& [runtime, cache] : boundCaches()) {
+      if (runtime != &rt) {
+        continue;
+      }
+      if (auto locked = cache.lock()) {
+        return locked;
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename T>
+  static std::shared_ptr<const Table> propNames(jsi::Runtime& rt, std::initializer_list<const char*> names) {
+    auto cache = find(rt);
+    if (cache) {
+      auto it = cache->tables_.find(std::type_index(typeid(T)));
+      if (it != cache->tables_.end()) {
+        return it->second;
+      }
+    }
+
+    auto table = std::make_shared<Table>();
+    table->reserve(names.size());
+    for (auto name : names) {
+      table->push_back(jsi::PropNameID::forUtf8(rt, name));
+    }
+
+    if (cache) {
+      cache->tables_.emplace(std::type_index(typeid(T)), table);
+    }
+    return table;
+  }
+
+  // Function evaluated from the JS `source`, once per cache (`name` identifies it)
+  static std::shared_ptr<jsi::Function> function(jsi::Runtime& rt, std::string_view name, const char* source) {
+    auto cache = find(rt);
+    if (cache) {
+      auto it = cache->functions_.find(name);
+      if (it != cache->functions_.end()) {
+        return it->second;
+      }
+    }
+
+    auto fn = std::make_shared<jsi::Function>(
+      rt.evaluateJavaScript(std::make_shared<jsi::StringBuffer>(source), std::string(name))
+        .asObject(rt)
+        .asFunction(rt));
+
+    if (cache) {
+      cache->functions_.emplace(name, fn);
+    }
+    return fn;
+  }
+
+private:
+  using BoundCaches = std::vector<std::pair<jsi::Runtime*, std::weak_ptr<RuntimeCache>>>;
+
+  static BoundCaches& boundCaches() {
+    thread_local BoundCaches caches;
+    return caches;
+  }
+
+  std::unordered_map<std::type_index, std::shared_ptr<const Table>> tables_;
+  std::unordered_map<std::string_view, std::shared_ptr<jsi::Function>> functions_;
+};
+
+// Host object of a `@lazy` struct.
+// Keeps the C++ value and converts a field (`Bridging<T>::getField`) only when it is read,
+// so large results are not materialized as JS objects up front.
+// The field is found by its name (`Bridging<T>::fieldIndex`) instead of comparing it with every field name.
+template <typename T>
+class StructHostObject : public jsi::HostObject {
+public:
+  explicit StructHostObject(T value)
+    : value_(std::make_shared<const T>(std::move(value))) {}
+
+  jsi::Value get(jsi::Runtime& rt, const jsi::PropNameID& name) override {
+    auto index = react::Bridging<T>::fieldIndex(name.utf8(rt));
+    if (!index.has_value()) {
+      return jsi::Value::undefined();
+    }
+
+    return react::Bridging<T>::getField(rt, *value_, *index);
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override {
+    auto props = react::Bridging<T>::fieldNames(rt);
+    std::vector<jsi::PropNameID> names;
+    names.reserve(props->size());
+    for (const auto& prop : *props) {
+      names.emplace_back(rt, prop);
+    }
+
+    return names;
+  }
+
+  const T& value() const {
+    return *value_;
+  }
+
+private:
+  std::shared_ptr<const T> value_;
+};
+
+// Host object of a `LazyArray<T>` result.
+// Keeps the `rust::Vec<T>` and converts an element only when its index is read.
+template <typename T>
+class LazyArrayHostObject : public jsi::HostObject {
+public:
+  explicit LazyArrayHostObject(rust::Vec<T> vec)
+    : vec_(std::move(vec)) {}
+
+  jsi::Value get(jsi::Runtime& rt, const jsi::PropNameID& name) override {
+    auto prop = name.utf8(rt);
+    if (prop == "length") {
+      return jsi::Value(static_cast<double>(vec_.size()));
+    }
+
+    auto index = toIndex(prop);
+    if (!index.has_value()) {
+      return jsi::Value::undefined();
+    }
+
+    // Converted from a reference to the element, eg. a `rust::String` is read in place by `jsi::String::createFromUtf8`
+    return react::bridging::toJs(rt, vec_[*index]);
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override {
+    std::vector<jsi::PropNameID> names;
+    names.reserve(vec_.size() + 1);
+    names.emplace_back(jsi::PropNameID::forAscii(rt, "length"));
+    for (size_t i = 0; i < vec_.size(); i++) {
+      names.emplace_back(jsi::PropNameID::forAscii(rt, std::to_string(i)));
+    }
+
+    return names;
+  }
+
+private:
+  rust::Vec<T> vec_;
+
+  // Canonical array index (`"0"`, `"1"`, ..., no leading zeros) within bounds
+  std::optional<size_t> toIndex(const std::string& prop) const {
+    if (prop.empty() || (prop.size() > 1 && prop[0] == '0')) {
+      return std::nullopt;
+    }
+
+    size_t index = 0;
+    for (char c : prop) {
+      if (c < '0' || c > '9') {
+        return std::nullopt;
+      }
+      index = index * 10 + (c - '0');
+      if (index >= vec_.size()) {
+        return std::nullopt;
+      }
+    }
+
+    return index;
+  }
+};
+
+template <typename T>
+jsi::Value lazyArrayToJs(jsi::Runtime& rt, rust::Vec<T> vec) {
+  auto hostObject = std::make_shared<LazyArrayHostObject<T>>(std::move(vec));
+  return jsi::Object::createFromHostObject(rt, std::move(hostObject));
+}
+
+} // namespace utils
+} // namespace crabytest
+} // namespace craby
+
 namespace facebook {
 namespace react {
 
 template <>
 struct Bridging<std::monostate> {
-  static std::monostate fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {
+  static std::monostate fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {
     return std::monostate{};
   }
 
@@ -45,45 +487,44 @@ struct Bridging<std::monostate> {
   }
 };
 
+// `rust::Str` arguments are borrowed from a scoped `Utf8Buffer` by the method wrappers,
+// so there is no `fromJs` that would return a `rust::Str` to a destroyed buffer.
 template <>
 struct Bridging<rust::Str> {
-  static rust::Str fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {
-    auto str = value.asString(rt).utf8(rt);
-    return rust::Str(str.data(), str.size());
-  }
-
   static jsi::Value toJs(jsi::Runtime& rt, const rust::Str& value) {
-    return react::bridging::toJs(rt, std::string(value.data(), value.size()));
+    return jsi::String::createFromUtf8(rt, reinterpret_cast<const uint8_t*>(value.data()), value.size());
   }
 };
 
 template <>
 struct Bridging<rust::String> {
-  static rust::String fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {
-    auto str = value.asString(rt).utf8(rt);
-    return rust::String(str.data(), str.size());
+  static rust::String fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    return craby::crabytest::utils::stringFromJs(rt, value.asString(rt));
   }
 
+  // Creates the JS string from the UTF-8 bytes without an intermediate `std::string` copy
   static jsi::Value toJs(jsi::Runtime& rt, const rust::String& value) {
-    return react::bridging::toJs(rt, std::string(value.data(), value.size()));
+    return jsi::String::createFromUtf8(rt, reinterpret_cast<const uint8_t*>(value.data()), value.size());
   }
 };
 
 template <>
 struct Bridging<rust::Vec<uint8_t>> {
-  static rust::Vec<uint8_t> fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {
+  static rust::Vec<uint8_t> fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {
     auto arrayBuffer = value.asObject(rt).getArrayBuffer(rt);
     uint8_t* data = arrayBuffer.data(rt);
     size_t size = arrayBuffer.size(rt);
     rust::Vec<uint8_t> vec;
     vec.reserve(size);
 
-    std::memcpy(vec.data(), data, size);
+    for (size_t i = 0; i < size; i++) {
+      vec.push_back(data[i]);
+    }
 
     return vec;
   }
 
-  static jsi::Value toJs(jsi::Runtime& rt, const rust::Vec<uint8_t>& vec) {
+  static jsi::Value toJs(jsi::Runtime& rt, rust::Vec<uint8_t> vec) {
     auto buffer = std::make_shared<crabytest::RustVecBuffer>(std::move(vec));
     return jsi::ArrayBuffer(rt, buffer);
   }
@@ -91,7 +532,7 @@ struct Bridging<rust::Vec<uint8_t>> {
 
 template <typename T>
 struct Bridging<rust::Vec<T>> {
-  static rust::Vec<T> fromJs(jsi::Runtime& rt, const jsi::Value &value, std::shared_ptr<CallInvoker> callInvoker) {
+  static rust::Vec<T> fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {
     auto arr = value.asObject(rt).asArray(rt);
     size_t len = arr.length(rt);
     rust::Vec<T> vec;
@@ -105,11 +546,12 @@ struct Bridging<rust::Vec<T>> {
     return vec;
   }
 
-  static jsi::Array toJs(jsi::Runtime& rt, const rust::Vec<T>& vec) {
+  // Takes the `rust::Vec` by value so owned elements (strings, structs) are moved instead of copied
+  static jsi::Array toJs(jsi::Runtime& rt, rust::Vec<T> vec) {
     auto arr = jsi::Array(rt, vec.size());
 
     for (size_t i = 0; i < vec.size(); i++) {
-      auto jsElement = react::bridging::toJs(rt, vec[i]);
+      auto jsElement = react::bridging::toJs(rt, std::move(vec[i]));
       arr.setValueAtIndex(rt, i, jsElement);
     }
 
@@ -117,9 +559,86 @@ struct Bridging<rust::Vec<T>> {
   }
 };
 
+// Large `Array<Number>` values are converted through a `Float64Array` in a single JSI call
+// instead of one `getValueAtIndex`/`setValueAtIndex` call per element, then copied into the
+// `rust::Vec` at once. JSI has no bulk read of array elements, so below `kBulkThreshold` the
+// per-element calls are cheaper than the call into the engine (see `bench/main.cpp`).
+// Both paths reject an element that is not a number, instead of coercing it.
+template <>
+struct Bridging<rust::Vec<double>> {
+  static constexpr size_t kBulkThreshold = 64;
+  static constexpr const char* kNotNumber = "Expected an array of numbers";
+  // Copies the elements into a `Float64Array`, `null` if an element is not a number
+  static constexpr const char* kToFloat64Array =
+    "(function (arr) {"
+    "  var len = arr.length;"
+    "  var out = new Float64Array(len);"
+    "  for (var i = 0; i < len; i++) {"
+    "    var value = arr[i];"
+    "    if (typeof value !== 'number') return null;"
+    "    out[i] = value;"
+    "  }"
+    "  return out;"
+    "})";
+
+  static rust::Vec<double> fromJs(jsi::Runtime& rt, const jsi::Value &value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    auto arr = value.asObject(rt).asArray(rt);
+    return arr.length(rt) < kBulkThreshold ? fromJsEach(rt, arr) : fromJsBulk(rt, arr);
+  }
+
+  // One `getValueAtIndex` call per element
+  static rust::Vec<double> fromJsEach(jsi::Runtime& rt, const jsi::Array& arr) {
+    size_t len = arr.length(rt);
+    rust::Vec<double> vec;
+    vec.reserve(len);
+
+    for (size_t i = 0; i < len; i++) {
+      auto element = arr.getValueAtIndex(rt, i);
+      if (!element.isNumber()) {
+        throw jsi::JSError(rt, kNotNumber);
+      }
+      vec.push_back(element.getNumber());
+    }
+
+    return vec;
+  }
+
+  // One call into the engine, then a single copy of the `Float64Array` elements
+  static rust::Vec<double> fromJsBulk(jsi::Runtime& rt, const jsi::Array& arr) {
+    auto toFloat64Array = craby::crabytest::utils::RuntimeCache::function(rt, "toFloat64Array", kToFloat64Array);
+    auto typedArray = toFloat64Array->call(rt, arr);
+    if (!typedArray.isObject()) {
+      throw jsi::JSError(rt, kNotNumber);
+    }
+
+    return craby::crabytest::utils::typedArrayFromJs<double>(rt, typedArray);
+  }
+
+  static jsi::Array toJs(jsi::Runtime& rt, rust::Vec<double> vec) {
+    if (vec.size() < kBulkThreshold) {
+      auto arr = jsi::Array(rt, vec.size());
+
+      for (size_t i = 0; i < vec.size(); i++) {
+        arr.setValueAtIndex(rt, i, jsi::Value(vec[i]));
+      }
+
+      return arr;
+    }
+
+    // `Array.from(new Float64Array(buffer))`
+    auto typedArray = craby::crabytest::utils::typedArrayToJs(rt, std::move(vec), "Float64Array");
+    auto array = rt.global().getPropertyAsObject(rt, "Array");
+
+    return array.getPropertyAsFunction(rt, "from")
+      .callWithThis(rt, array, typedArray)
+      .asObject(rt)
+      .asArray(rt);
+  }
+};
+
 template <>
 struct Bridging<craby::crabytest::bridging::MyEnum> {
-  static craby::crabytest::bridging::MyEnum fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::MyEnum fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     auto raw = value.asString(rt).utf8(rt);
     if (raw == "foo") {
       return craby::crabytest::bridging::MyEnum::Foo;
@@ -148,7 +667,7 @@ struct Bridging<craby::crabytest::bridging::MyEnum> {
 
 template <>
 struct Bridging<craby::crabytest::bridging::SwitchState> {
-  static craby::crabytest::bridging::SwitchState fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::SwitchState fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     auto raw = value.asNumber();
     if (raw == 0) {
       return craby::crabytest::bridging::SwitchState::Off;
@@ -173,24 +692,26 @@ struct Bridging<craby::crabytest::bridging::SwitchState> {
 
 template <>
 struct Bridging<craby::crabytest::bridging::MyModuleError> {
-  static craby::crabytest::bridging::MyModuleError fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::MyModuleError fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::MyModuleError>(rt, {"reason"});
     auto obj = value.asObject(rt);
-    auto obj$reason = obj.getProperty(rt, "reason");
+    auto objReason = obj.getProperty(rt, (*props)[0]);
 
-    auto _obj$reason = react::bridging::fromJs<rust::String>(rt, obj$reason, callInvoker);
+    auto _objReason = react::bridging::fromJs<rust::String>(rt, objReason, callInvoker);
 
     craby::crabytest::bridging::MyModuleError ret = {
-      _obj$reason
+      std::move(_objReason)
     };
 
     return ret;
   }
 
   static jsi::Value toJs(jsi::Runtime &rt, craby::crabytest::bridging::MyModuleError value) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::MyModuleError>(rt, {"reason"});
     jsi::Object obj = jsi::Object(rt);
-    auto _obj$reason = react::bridging::toJs(rt, value.reason);
+    auto _objReason = react::bridging::toJs(rt, std::move(value.reason));
 
-    obj.setProperty(rt, "reason", _obj$reason);
+    obj.setProperty(rt, (*props)[0], _objReason);
 
     return jsi::Value(rt, obj);
   }
@@ -198,13 +719,13 @@ struct Bridging<craby::crabytest::bridging::MyModuleError> {
 
 template <>
 struct Bridging<craby::crabytest::bridging::NullableString> {
-  static craby::crabytest::bridging::NullableString fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::NullableString fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     if (value.isNull()) {
       return craby::crabytest::bridging::NullableString{true, rust::String()};
     }
 
     auto val = react::bridging::fromJs<rust::String>(rt, value, callInvoker);
-    auto ret = craby::crabytest::bridging::NullableString{false, val};
+    auto ret = craby::crabytest::bridging::NullableString{false, std::move(val)};
 
     return ret;
   }
@@ -214,40 +735,42 @@ struct Bridging<craby::crabytest::bridging::NullableString> {
       return jsi::Value::null();
     }
 
-    return react::bridging::toJs(rt, value.val);
+    return react::bridging::toJs(rt, std::move(value.val));
   }
 };
 
 template <>
 struct Bridging<craby::crabytest::bridging::SubObject> {
-  static craby::crabytest::bridging::SubObject fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::SubObject fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::SubObject>(rt, {"a", "b", "c"});
     auto obj = value.asObject(rt);
-    auto obj$a = obj.getProperty(rt, "a");
-    auto obj$b = obj.getProperty(rt, "b");
-    auto obj$c = obj.getProperty(rt, "c");
+    auto objA = obj.getProperty(rt, (*props)[0]);
+    auto objB = obj.getProperty(rt, (*props)[1]);
+    auto objC = obj.getProperty(rt, (*props)[2]);
 
-    auto _obj$a = react::bridging::fromJs<craby::crabytest::bridging::NullableString>(rt, obj$a, callInvoker);
-    auto _obj$b = react::bridging::fromJs<double>(rt, obj$b, callInvoker);
-    auto _obj$c = react::bridging::fromJs<bool>(rt, obj$c, callInvoker);
+    auto _objA = react::bridging::fromJs<craby::crabytest::bridging::NullableString>(rt, objA, callInvoker);
+    auto _objB = react::bridging::fromJs<double>(rt, objB, callInvoker);
+    auto _objC = react::bridging::fromJs<bool>(rt, objC, callInvoker);
 
     craby::crabytest::bridging::SubObject ret = {
-      _obj$a,
-      _obj$b,
-      _obj$c
+      std::move(_objA),
+      _objB,
+      _objC
     };
 
     return ret;
   }
 
   static jsi::Value toJs(jsi::Runtime &rt, craby::crabytest::bridging::SubObject value) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::SubObject>(rt, {"a", "b", "c"});
     jsi::Object obj = jsi::Object(rt);
-    auto _obj$a = react::bridging::toJs(rt, value.a);
-    auto _obj$b = react::bridging::toJs(rt, value.b);
-    auto _obj$c = react::bridging::toJs(rt, value.c);
+    auto _objA = react::bridging::toJs(rt, std::move(value.a));
+    auto _objB = react::bridging::toJs(rt, value.b);
+    auto _objC = react::bridging::toJs(rt, value.c);
 
-    obj.setProperty(rt, "a", _obj$a);
-    obj.setProperty(rt, "b", _obj$b);
-    obj.setProperty(rt, "c", _obj$c);
+    obj.setProperty(rt, (*props)[0], _objA);
+    obj.setProperty(rt, (*props)[1], _objB);
+    obj.setProperty(rt, (*props)[2], _objC);
 
     return jsi::Value(rt, obj);
   }
@@ -255,13 +778,13 @@ struct Bridging<craby::crabytest::bridging::SubObject> {
 
 template <>
 struct Bridging<craby::crabytest::bridging::NullableSubObject> {
-  static craby::crabytest::bridging::NullableSubObject fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::NullableSubObject fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     if (value.isNull()) {
       return craby::crabytest::bridging::NullableSubObject{true, craby::crabytest::bridging::SubObject{}};
     }
 
     auto val = react::bridging::fromJs<craby::crabytest::bridging::SubObject>(rt, value, callInvoker);
-    auto ret = craby::crabytest::bridging::NullableSubObject{false, val};
+    auto ret = craby::crabytest::bridging::NullableSubObject{false, std::move(val)};
 
     return ret;
   }
@@ -271,30 +794,64 @@ struct Bridging<craby::crabytest::bridging::NullableSubObject> {
       return jsi::Value::null();
     }
 
-    return react::bridging::toJs(rt, value.val);
+    return react::bridging::toJs(rt, std::move(value.val));
+  }
+};
+
+template <>
+struct Bridging<craby::crabytest::bridging::Position> {
+  static craby::crabytest::bridging::Position fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::Position>(rt, {"x", "y"});
+    auto obj = value.asObject(rt);
+    auto objX = obj.getProperty(rt, (*props)[0]);
+    auto objY = obj.getProperty(rt, (*props)[1]);
+
+    auto _objX = react::bridging::fromJs<double>(rt, objX, callInvoker);
+    auto _objY = react::bridging::fromJs<double>(rt, objY, callInvoker);
+
+    craby::crabytest::bridging::Position ret = {
+      _objX,
+      _objY
+    };
+
+    return ret;
+  }
+
+  static jsi::Value toJs(jsi::Runtime &rt, craby::crabytest::bridging::Position value) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::Position>(rt, {"x", "y"});
+    jsi::Object obj = jsi::Object(rt);
+    auto _objX = react::bridging::toJs(rt, value.x);
+    auto _objY = react::bridging::toJs(rt, value.y);
+
+    obj.setProperty(rt, (*props)[0], _objX);
+    obj.setProperty(rt, (*props)[1], _objY);
+
+    return jsi::Value(rt, obj);
   }
 };
 
 template <>
 struct Bridging<craby::crabytest::bridging::ProgressEvent> {
-  static craby::crabytest::bridging::ProgressEvent fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::ProgressEvent fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::ProgressEvent>(rt, {"progress"});
     auto obj = value.asObject(rt);
-    auto obj$progress = obj.getProperty(rt, "progress");
+    auto objProgress = obj.getProperty(rt, (*props)[0]);
 
-    auto _obj$progress = react::bridging::fromJs<double>(rt, obj$progress, callInvoker);
+    auto _objProgress = react::bridging::fromJs<double>(rt, objProgress, callInvoker);
 
     craby::crabytest::bridging::ProgressEvent ret = {
-      _obj$progress
+      _objProgress
     };
 
     return ret;
   }
 
   static jsi::Value toJs(jsi::Runtime &rt, craby::crabytest::bridging::ProgressEvent value) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::ProgressEvent>(rt, {"progress"});
     jsi::Object obj = jsi::Object(rt);
-    auto _obj$progress = react::bridging::toJs(rt, value.progress);
+    auto _objProgress = react::bridging::toJs(rt, value.progress);
 
-    obj.setProperty(rt, "progress", _obj$progress);
+    obj.setProperty(rt, (*props)[0], _objProgress);
 
     return jsi::Value(rt, obj);
   }
@@ -302,54 +859,56 @@ struct Bridging<craby::crabytest::bridging::ProgressEvent> {
 
 template <>
 struct Bridging<craby::crabytest::bridging::TestObject> {
-  static craby::crabytest::bridging::TestObject fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::TestObject fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::TestObject>(rt, {"foo", "bar", "baz", "sub", "camelCase", "PascalCase", "snake_case"});
     auto obj = value.asObject(rt);
-    auto obj$foo = obj.getProperty(rt, "foo");
-    auto obj$bar = obj.getProperty(rt, "bar");
-    auto obj$baz = obj.getProperty(rt, "baz");
-    auto obj$sub = obj.getProperty(rt, "sub");
-    auto obj$camelCase = obj.getProperty(rt, "camelCase");
-    auto obj$pascalCase = obj.getProperty(rt, "PascalCase");
-    auto obj$snakeCase = obj.getProperty(rt, "snake_case");
-
-    auto _obj$foo = react::bridging::fromJs<rust::String>(rt, obj$foo, callInvoker);
-    auto _obj$bar = react::bridging::fromJs<double>(rt, obj$bar, callInvoker);
-    auto _obj$baz = react::bridging::fromJs<bool>(rt, obj$baz, callInvoker);
-    auto _obj$sub = react::bridging::fromJs<craby::crabytest::bridging::NullableSubObject>(rt, obj$sub, callInvoker);
-    auto _obj$camelCase = react::bridging::fromJs<double>(rt, obj$camelCase, callInvoker);
-    auto _obj$pascalCase = react::bridging::fromJs<double>(rt, obj$pascalCase, callInvoker);
-    auto _obj$snakeCase = react::bridging::fromJs<double>(rt, obj$snakeCase, callInvoker);
+    auto objFoo = obj.getProperty(rt, (*props)[0]);
+    auto objBar = obj.getProperty(rt, (*props)[1]);
+    auto objBaz = obj.getProperty(rt, (*props)[2]);
+    auto objSub = obj.getProperty(rt, (*props)[3]);
+    auto objCamelCase = obj.getProperty(rt, (*props)[4]);
+    auto objPascalCase = obj.getProperty(rt, (*props)[5]);
+    auto objSnakeCase = obj.getProperty(rt, (*props)[6]);
+
+    auto _objFoo = react::bridging::fromJs<rust::String>(rt, objFoo, callInvoker);
+    auto _objBar = react::bridging::fromJs<double>(rt, objBar, callInvoker);
+    auto _objBaz = react::bridging::fromJs<bool>(rt, objBaz, callInvoker);
+    auto _objSub = react::bridging::fromJs<craby::crabytest::bridging::NullableSubObject>(rt, objSub, callInvoker);
+    auto _objCamelCase = react::bridging::fromJs<double>(rt, objCamelCase, callInvoker);
+    auto _objPascalCase = react::bridging::fromJs<double>(rt, objPascalCase, callInvoker);
+    auto _objSnakeCase = react::bridging::fromJs<double>(rt, objSnakeCase, callInvoker);
 
     craby::crabytest::bridging::TestObject ret = {
-      _obj$foo,
-      _obj$bar,
-      _obj$baz,
-      _obj$sub,
-      _obj$camelCase,
-      _obj$pascalCase,
-      _obj$snakeCase
+      std::move(_objFoo),
+      _objBar,
+      _objBaz,
+      std::move(_objSub),
+      _objCamelCase,
+      _objPascalCase,
+      _objSnakeCase
     };
 
     return ret;
   }
 
   static jsi::Value toJs(jsi::Runtime &rt, craby::crabytest::bridging::TestObject value) {
+    auto props = craby::crabytest::utils::RuntimeCache::propNames<craby::crabytest::bridging::TestObject>(rt, {"foo", "bar", "baz", "sub", "camelCase", "PascalCase", "snake_case"});
     jsi::Object obj = jsi::Object(rt);
-    auto _obj$foo = react::bridging::toJs(rt, value.foo);
-    auto _obj$bar = react::bridging::toJs(rt, value.bar);
-    auto _obj$baz = react::bridging::toJs(rt, value.baz);
-    auto _obj$sub = react::bridging::toJs(rt, value.sub);
-    auto _obj$camelCase = react::bridging::toJs(rt, value.camel_case);
-    auto _obj$pascalCase = react::bridging::toJs(rt, value.pascal_case);
-    auto _obj$snakeCase = react::bridging::toJs(rt, value.snake_case);
-
-    obj.setProperty(rt, "foo", _obj$foo);
-    obj.setProperty(rt, "bar", _obj$bar);
-    obj.setProperty(rt, "baz", _obj$baz);
-    obj.setProperty(rt, "sub", _obj$sub);
-    obj.setProperty(rt, "camelCase", _obj$camelCase);
-    obj.setProperty(rt, "PascalCase", _obj$pascalCase);
-    obj.setProperty(rt, "snake_case", _obj$snakeCase);
+    auto _objFoo = react::bridging::toJs(rt, std::move(value.foo));
+    auto _objBar = react::bridging::toJs(rt, value.bar);
+    auto _objBaz = react::bridging::toJs(rt, value.baz);
+    auto _objSub = react::bridging::toJs(rt, std::move(value.sub));
+    auto _objCamelCase = react::bridging::toJs(rt, value.camel_case);
+    auto _objPascalCase = react::bridging::toJs(rt, value.pascal_case);
+    auto _objSnakeCase = react::bridging::toJs(rt, value.snake_case);
+
+    obj.setProperty(rt, (*props)[0], _objFoo);
+    obj.setProperty(rt, (*props)[1], _objBar);
+    obj.setProperty(rt, (*props)[2], _objBaz);
+    obj.setProperty(rt, (*props)[3], _objSub);
+    obj.setProperty(rt, (*props)[4], _objCamelCase);
+    obj.setProperty(rt, (*props)[5], _objPascalCase);
+    obj.setProperty(rt, (*props)[6], _objSnakeCase);
 
     return jsi::Value(rt, obj);
   }
@@ -357,13 +916,13 @@ struct Bridging<craby::crabytest::bridging::TestObject> {
 
 template <>
 struct Bridging<craby::crabytest::bridging::NullableNumber> {
-  static craby::crabytest::bridging::NullableNumber fromJs(jsi::Runtime &rt, const jsi::Value& value, std::shared_ptr<CallInvoker> callInvoker) {
+  static craby::crabytest::bridging::NullableNumber fromJs(jsi::Runtime &rt, const jsi::Value& value, const std::shared_ptr<CallInvoker>& callInvoker) {
     if (value.isNull()) {
       return craby::crabytest::bridging::NullableNumber{true, 0.0};
     }
 
     auto val = react::bridging::fromJs<double>(rt, value, callInvoker);
-    auto ret = craby::crabytest::bridging::NullableNumber{false, val};
+    auto ret = craby::crabytest::bridging::NullableNumber{false, std::move(val)};
 
     return ret;
   }
@@ -373,9 +932,341 @@ struct Bridging<craby::crabytest::bridging::NullableNumber> {
       return jsi::Value::null();
     }
 
-    return react::bridging::toJs(rt, value.val);
+    return react::bridging::toJs(rt, std::move(value.val));
   }
 };
 
 } // namespace react
 } // namespace facebook
+
+namespace craby {
+namespace crabytest {
+namespace utils {
+
+using ByteStreamRef = std::shared_ptr<rust::Box<craby::crabytest::bridging::ByteStream>>;
+
+// Pending `read(size)`, resolves with up to `size` bytes (an empty `ArrayBuffer` at the end of the stream)
+class StreamReadOp : public craby::crabytest::streams::StreamOp {
+public:
+  StreamReadOp(ByteStreamRef stream, size_t size, react::AsyncPromise<rust::Vec<uint8_t>> promise)
+    : stream_(std::move(stream)), size_(size), promise_(std::move(promise)) {}
+
+  void complete() noexcept override {
+    try {
+      promise_.resolve(craby::crabytest::bridging::streamTake(**stream_, size_));
+    } catch (const std::exception& err) {
+      promise_.reject(err.what());
+    }
+  }
+
+private:
+  ByteStreamRef stream_;
+  size_t size_;
+  react::AsyncPromise<rust::Vec<uint8_t>> promise_;
+};
+
+// Pending `write(chunk)`, resolves once the chunk is queued
+class StreamWriteOp : public craby::crabytest::streams::StreamOp {
+public:
+  StreamWriteOp(ByteStreamRef stream, react::AsyncPromise<std::monostate> promise)
+    : stream_(std::move(stream)), promise_(std::move(promise)) {}
+
+  void complete() noexcept override {
+    try {
+      craby::crabytest::bridging::streamFinishWrite(**stream_);
+      promise_.resolve(std::monostate{});
+    } catch (const std::exception& err) {
+      promise_.reject(err.what());
+    }
+  }
+
+private:
+  ByteStreamRef stream_;
+  react::AsyncPromise<std::monostate> promise_;
+};
+
+// Host object of a `ByteStream` result (`read(size)`, `write(chunk)` and `close()`).
+// Pending operations keep the stream alive, it is closed when the last reference is released.
+class ByteStreamHostObject : public jsi::HostObject {
+public:
+  ByteStreamHostObject(rust::Box<craby::crabytest::bridging::ByteStream> stream, std::shared_ptr<react::CallInvoker> callInvoker)
+    : stream_(std::make_shared<rust::Box<craby::crabytest::bridging::ByteStream>>(std::move(stream))),
+      callInvoker_(std::move(callInvoker)) {}
+
+  jsi::Value get(jsi::Runtime& rt, const jsi::PropNameID& name) override {
+    auto prop = name.utf8(rt);
+    if (prop == "read") {
+      return jsi::Function::createFromHostFunction(rt, name, 1, [stream = stream_, callInvoker = callInvoker_](
+        jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {
+        if (count != 1 || !args[0].isNumber() || args[0].asNumber() < 1) {
+          throw jsi::JSError(rt, "Expected a positive size");
+        }
+
+        react::AsyncPromise<rust::Vec<uint8_t>> promise(rt, callInvoker);
+        auto op = new StreamReadOp(stream, static_cast<size_t>(args[0].asNumber()), promise);
+        try {
+          // Not ready: the Rust side owns `op` and completes it, possibly right away on another thread
+          if (craby::crabytest::bridging::streamPollRead(**stream, reinterpret_cast<size_t>(op))) {
+            op->complete();
+            delete op;
+          }
+        } catch (const std::exception& err) {
+          delete op;
+          promise.reject(err.what());
+        }
+
+        return react::bridging::toJs(rt, promise);
+      });
+    }
+
+    if (prop == "write") {
+      return jsi::Function::createFromHostFunction(rt, name, 1, [stream = stream_, callInvoker = callInvoker_](
+        jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {
+        if (count != 1 || !args[0].isObject() || !args[0].asObject(rt).isArrayBuffer(rt)) {
+          throw jsi::JSError(rt, "Expected an ArrayBuffer");
+        }
+
+        // Copied into a pooled buffer before `write` returns
+        auto buffer = args[0].asObject(rt).getArrayBuffer(rt);
+        rust::Slice<const uint8_t> chunk(buffer.data(rt), buffer.size(rt));
+
+        react::AsyncPromise<std::monostate> promise(rt, callInvoker);
+        auto op = new StreamWriteOp(stream, promise);
+        try {
+          if (craby::crabytest::bridging::streamWrite(**stream, chunk, reinterpret_cast<size_t>(op))) {
+            op->complete();
+            delete op;
+          }
+        } catch (const std::exception& err) {
+          delete op;
+          promise.reject(err.what());
+        }
+
+        return react::bridging::toJs(rt, promise);
+      });
+    }
+
+    if (prop == "close") {
+      return jsi::Function::createFromHostFunction(rt, name, 0, [stream = stream_](
+        jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) -> jsi::Value {
+        craby::crabytest::bridging::streamClose(**stream);
+        return jsi::Value::undefined();
+      });
+    }
+
+    return jsi::Value::undefined();
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override {
+    std::vector<jsi::PropNameID> names;
+    names.emplace_back(jsi::PropNameID::forAscii(rt, "read"));
+    names.emplace_back(jsi::PropNameID::forAscii(rt, "write"));
+    names.emplace_back(jsi::PropNameID::forAscii(rt, "close"));
+
+    return names;
+  }
+
+private:
+  ByteStreamRef stream_;
+  std::shared_ptr<react::CallInvoker> callInvoker_;
+};
+
+inline jsi::Value byteStreamToJs(jsi::Runtime& rt,
+                                 rust::Box<craby::crabytest::bridging::ByteStream> stream,
+                                 const std::shared_ptr<react::CallInvoker>& callInvoker) {
+  auto hostObject = std::make_shared<ByteStreamHostObject>(std::move(stream), callInvoker);
+  return jsi::Object::createFromHostObject(rt, std::move(hostObject));
+}
+
+} // namespace utils
+} // namespace crabytest
+} // namespace craby
+
+namespace craby {
+namespace crabytest {
+namespace utils {
+
+// Cancellation token of an `AbortSignal` parameter, shared by the task and the `abort` listener.
+// Converts to the `AbortSignal` of the Rust side when passed to the FFI function.
+class AbortToken {
+public:
+  AbortToken()
+    : signal_(std::make_shared<rust::Box<craby::crabytest::bridging::AbortSignal>>(craby::crabytest::bridging::createAbortSignal())) {}
+
+  // Aborts the token and rejects the promise once the JS `AbortSignal` is aborted (`null` and `undefined` are never aborted).
+  template <typename T>
+  void bind(jsi::Runtime& rt, const jsi::Value& value, react::AsyncPromise<T> promise) {
+    if (value.isUndefined() || value.isNull()) {
+      return;
+    }
+
+    auto signal = value.asObject(rt);
+    if (signal.getProperty(rt, "aborted").asBool()) {
+      abort(promise);
+      return;
+    }
+
+    auto signalRef = std::make_shared<jsi::Object>(std::move(signal));
+    auto listener = std::make_shared<jsi::Function>(jsi::Function::createFromHostFunction(
+      rt, jsi::PropNameID::forAscii(rt, "onabort"), 0,
+      [token = *this, promise](jsi::Runtime&, const jsi::Value&, const jsi::Value*, size_t) mutable -> jsi::Value {
+        token.abort(promise);
+        return jsi::Value::undefined();
+      }));
+    auto addEventListener = signalRef->getPropertyAsFunction(rt, "addEventListener");
+    addEventListener.callWithThis(rt, *signalRef, jsi::String::createFromAscii(rt, "abort"), *listener);
+
+    // Remove the listener once the promise settles, it would otherwise live (with the promise) as long as the signal
+    auto unbind = jsi::Function::createFromHostFunction(
+      rt, jsi::PropNameID::forAscii(rt, "unbind"), 0,
+      [signalRef, listener](jsi::Runtime& rt, const jsi::Value&, const jsi::Value*, size_t) -> jsi::Value {
+        auto removeEventListener = signalRef->getPropertyAsFunction(rt, "removeEventListener");
+        removeEventListener.callWithThis(rt, *signalRef, jsi::String::createFromAscii(rt, "abort"), *listener);
+        return jsi::Value::undefined();
+      });
+    auto jsPromise = promise.get(rt);
+    jsPromise.getPropertyAsFunction(rt, "then").callWithThis(rt, jsPromise, unbind, unbind);
+  }
+
+  bool aborted() const {
+    return craby::crabytest::bridging::abortSignalAborted(**signal_);
+  }
+
+  operator const craby::crabytest::bridging::AbortSignal &() const {
+    return **signal_;
+  }
+
+private:
+  template <typename T>
+  void abort(react::AsyncPromise<T>& promise) {
+    craby::crabytest::bridging::abortSignalAbort(**signal_);
+    promise.reject("This operation was aborted");
+  }
+
+  std::shared_ptr<rust::Box<craby::crabytest::bridging::AbortSignal>> signal_;
+};
+
+} // namespace utils
+} // namespace crabytest
+} // namespace craby
+
+namespace craby {
+namespace crabytest {
+namespace utils {
+
+// Resolves the promise of an `@executor async` method with the result taken by `take` (its `{method}Result` FFI function)
+template <typename T, typename R>
+class PromiseOp : public craby::crabytest::futures::FutureOp {
+public:
+  PromiseOp(react::AsyncPromise<T> promise, R (*take)(size_t)) : promise_(std::move(promise)), take_(take) {}
+
+  void complete(size_t ret) noexcept override {
+    try {
+      if constexpr (std::is_void_v<R>) {
+        take_(ret);
+        promise_.resolve(std::monostate{});
+      } else {
+        promise_.resolve(take_(ret));
+      }
+    } catch (const std::exception& err) {
+      promise_.reject(err.what());
+    }
+  }
+
+private:
+  react::AsyncPromise<T> promise_;
+  R (*take_)(size_t);
+};
+
+template <typename T, typename R>
+PromiseOp<T, R>* promiseOp(react::AsyncPromise<T> promise, R (*take)(size_t)) {
+  return new PromiseOp<T, R>(std::move(promise), take);
+}
+
+} // namespace utils
+} // namespace crabytest
+} // namespace craby
+
+namespace craby {
+namespace crabytest {
+namespace utils {
+
+// Memory of a `SharedState`, written by the Rust side (the buffer holds a reference, not a copy)
+class SharedMemoryBuffer : public jsi::MutableBuffer {
+public:
+  explicit SharedMemoryBuffer(rust::Box<craby::crabytest::bridging::SharedMemory> memory)
+    : memory_(std::move(memory)) {}
+
+  size_t size() const override {
+    return craby::crabytest::bridging::sharedMemorySize(*memory_);
+  }
+
+  uint8_t* data() override {
+    return reinterpret_cast<uint8_t*>(craby::crabytest::bridging::sharedMemoryData(*memory_));
+  }
+
+private:
+  rust::Box<craby::crabytest::bridging::SharedMemory> memory_;
+};
+
+// `{ sequence, values, fields }`: separate views of the `[sequence, ...fields]` memory (see `readSharedState` of `craby-modules`)
+inline jsi::Value sharedStateToJs(jsi::Runtime& rt,
+                                  rust::Box<craby::crabytest::bridging::SharedMemory> memory,
+                                  std::initializer_list<const char*> fields) {
+  auto buffer = std::make_shared<SharedMemoryBuffer>(std::move(memory));
+  auto arrayBuffer = jsi::ArrayBuffer(rt, buffer);
+  auto global = rt.global();
+  // Low half of the `u64` sequence (the supported targets are little-endian), enough to detect a write
+  auto sequence = global.getPropertyAsFunction(rt, "Int32Array").callAsConstructor(rt, arrayBuffer, 0, 1);
+  auto values = global.getPropertyAsFunction(rt, "Float64Array")
+                  .callAsConstructor(rt, arrayBuffer, static_cast<int>(sizeof(uint64_t)));
+
+  auto names = jsi::Array(rt, fields.size());
+  size_t index = 0;
+  for (auto field : fields) {
+    names.setValueAtIndex(rt, index++, jsi::String::createFromAscii(rt, field));
+  }
+
+  auto state = jsi::Object(rt);
+  state.setProperty(rt, "sequence", std::move(sequence));
+  state.setProperty(rt, "values", std::move(values));
+  state.setProperty(rt, "fields", std::move(names));
+
+  return state;
+}
+
+} // namespace utils
+} // namespace crabytest
+} // namespace craby
+
+namespace craby {
+namespace crabytest {
+namespace utils {
+
+// Copy-on-write pages of a memory-mapped file (JS writes never reach the file), unmapped by the Rust side when the
+// buffer is released (no copy)
+class MappedFileBuffer : public jsi::MutableBuffer {
+public:
+  explicit MappedFileBuffer(rust::Box<craby::crabytest::bridging::MappedFile> file)
+    : file_(std::move(file)) {}
+
+  size_t size() const override {
+    return craby::crabytest::bridging::mappedFileSize(*file_);
+  }
+
+  uint8_t* data() override {
+    return reinterpret_cast<uint8_t*>(craby::crabytest::bridging::mappedFileData(*file_));
+  }
+
+private:
+  rust::Box<craby::crabytest::bridging::MappedFile> file_;
+};
+
+inline jsi::Value mappedFileToJs(jsi::Runtime& rt, rust::Box<craby::crabytest::bridging::MappedFile> file) {
+  auto buffer = std::make_shared<MappedFileBuffer>(std::move(file));
+  return jsi::ArrayBuffer(rt, buffer);
+}
+
+} // namespace utils
+} // namespace crabytest
+} // namespace craby
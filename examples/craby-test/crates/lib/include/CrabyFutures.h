@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace craby {
+namespace crabytest {
+namespace futures {
+
+// Pending `Promise` of an `@executor async` method
+class FutureOp {
+public:
+  virtual ~FutureOp() = default;
+  // Called on the executor thread that completed the future (must not throw into the Rust side).
+  // `ret` must be passed to the `{method}Result` FFI function of the method exactly once.
+  virtual void complete(size_t ret) noexcept = 0;
+};
+
+// Called by the Rust side with the address of the pending `FutureOp`, which it owned until now
+inline void onFutureReady(size_t op, size_t ret) {
+  std::unique_ptr<FutureOp> pending(reinterpret_cast<FutureOp*>(op));
+  pending->complete(ret);
+}
+
+} // namespace futures
+} // namespace crabytest
+} // namespace craby
@@ -1,10 +1,11 @@
 #pragma once
 
 #include "rust/cxx.h"
+#include <array>
+#include <atomic>
 #include <functional>
-#include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <thread>
 
 namespace craby {
 namespace crabytest {
@@ -21,7 +22,7 @@ namespace craby {
 namespace crabytest {
 namespace signals {
 
-using Delegate = std::function<void(const std::string& signalName, void* signal)>;
+using Delegate = std::function<void(uint32_t signalId, void* signal)>;
 
 class SignalManager {
 public:
@@ -30,27 +31,89 @@ public:
     return instance;
   }
 
-  void emit(uintptr_t id, rust::Str name, craby::crabytest::bridging::CrabyTestSignal* signal) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = delegates_.find(id);
-    if (it != delegates_.end()) {
-      it->second(std::string(name), reinterpret_cast<void*>(signal));
+  void emit(uintptr_t id, uint32_t signalId, craby::crabytest::bridging::CrabyTestSignal* signal) const {
+    for (auto block = &head_; block != nullptr; block = block->next.load()) {
+      for (auto& slot : block->slots) {
+        if (slot.id.load() != id) {
+          continue;
+        }
+        slot.readers.fetch_add(1);
+        ReaderGuard guard{slot};
+        // Re-check after pinning the slot: the delegate may have been released in between
+        if (slot.id.load() == id) {
+          slot.delegate(signalId, reinterpret_cast<void*>(signal));
+          return;
+        }
+      }
     }
   }
 
   void registerDelegate(uintptr_t id, Delegate delegate) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    delegates_.insert_or_assign(id, delegate);
+    release(id);
+    for (auto block = &head_;; block = block->next.load()) {
+      for (auto& slot : block->slots) {
+        if (slot.id.load() == 0) {
+          // Publish the id after the delegate so that emit never sees a partial delegate
+          slot.delegate = std::move(delegate);
+          slot.id.store(id);
+          return;
+        }
+      }
+      if (block->next.load() == nullptr) {
+        // Every slot is taken: grow the table by a block
+        block->next.store(new Block());
+      }
+    }
   }
 
   void unregisterDelegate(uintptr_t id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    delegates_.erase(id);
+    release(id);
   }
 
 private:
+  // Slots per block of the table, the table grows by a block when every slot is taken
+  static constexpr size_t kBlockSize = 32;
+
+  struct Slot {
+    std::atomic<uintptr_t> id{0};
+    std::atomic<uint32_t> readers{0};
+    Delegate delegate;
+  };
+
+  // Blocks are never freed (the manager lives as long as the process), so emit can walk them without locking
+  struct Block {
+    std::array<Slot, kBlockSize> slots;
+    std::atomic<Block*> next{nullptr};
+  };
+
+  struct ReaderGuard {
+    Slot& slot;
+    ~ReaderGuard() {
+      slot.readers.fetch_sub(1);
+    }
+  };
+
   SignalManager() = default;
-  mutable std::unordered_map<uintptr_t, Delegate> delegates_;
+
+  void release(uintptr_t id) const {
+    for (auto block = &head_; block != nullptr; block = block->next.load()) {
+      for (auto& slot : block->slots) {
+        if (slot.id.load() != id) {
+          continue;
+        }
+        slot.id.store(0);
+        // Wait for in-flight emits to leave the delegate before releasing it
+        while (slot.readers.load() != 0) {
+          std::this_thread::yield();
+        }
+        slot.delegate = nullptr;
+      }
+    }
+  }
+
+  mutable Block head_;
   mutable std::mutex mutex_;
 };
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace craby {
+namespace crabytest {
+namespace streams {
+
+// Pending `read()`/`write()` of a `ByteStream`
+class StreamOp {
+public:
+  virtual ~StreamOp() = default;
+  // Called on the thread that made the stream ready (must not throw into the Rust side)
+  virtual void complete() noexcept = 0;
+};
+
+// Called by the Rust side with the address of the pending `StreamOp`, which it owned until now
+inline void onStreamReady(size_t op) {
+  std::unique_ptr<StreamOp> pending(reinterpret_cast<StreamOp*>(op));
+  pending->complete();
+}
+
+} // namespace streams
+} // namespace crabytest
+} // namespace craby
@@ -1,6 +1,12 @@
-use std::path::PathBuf;
+use std::{
+    fs::File,
+    io,
+    path::PathBuf,
+    thread,
+    time::{Duration, Instant},
+};
 
-use craby::{prelude::*, throw};
+use craby::{prelude::*, stream, throw};
 
 use crate::ffi::bridging::*;
 use crate::generated::*;
@@ -8,6 +14,7 @@ use crate::generated::*;
 pub struct CrabyTest {
     ctx: Context,
     state: Option<Number>,
+    position: SharedState<Position>,
 }
 
 impl CrabyTest {
@@ -19,7 +26,11 @@ impl CrabyTest {
 #[craby_module]
 impl CrabyTestSpec for CrabyTest {
     fn new(ctx: Context) -> Self {
-        CrabyTest { ctx, state: None }
+        CrabyTest {
+            ctx,
+            state: None,
+            position: SharedState::new(),
+        }
     }
 
     fn numeric_method(&mut self, arg: Number) -> Number {
@@ -44,9 +55,9 @@ impl CrabyTestSpec for CrabyTest {
         arg
     }
 
-    fn array_buffer_method(&mut self, mut arg: Vec<u8>) -> Vec<u8> {
+    fn array_buffer_method(&mut self, arg: &mut [u8]) -> ArrayBuffer {
         arg.iter_mut().for_each(|x| *x ^= 255);
-        arg
+        arg.to_vec()
     }
 
     fn array_method(&mut self, mut arg: Array<Number>) -> Array<Number> {
@@ -55,6 +66,11 @@ impl CrabyTestSpec for CrabyTest {
         arg
     }
 
+    fn typed_array_method(&mut self, arg: &mut [f64]) -> Float64Array {
+        arg.iter_mut().for_each(|x| *x *= 2.0);
+        arg.to_vec()
+    }
+
     fn enum_method(&mut self, arg0: MyEnum, arg1: SwitchState) -> String {
         let arg0 = match arg0 {
             MyEnum::Foo => "Enum Foo!",
@@ -98,8 +114,26 @@ impl CrabyTestSpec for CrabyTest {
         }
     }
 
+    fn abortable_promise_method(&mut self, ms: Number, signal: AbortSignal) -> Promise<Number> {
+        let started = Instant::now();
+        while started.elapsed() < Duration::from_millis(ms as u64) {
+            signal.throw_if_aborted()?;
+            thread::sleep(Duration::from_millis(10));
+        }
+
+        promise::resolve(started.elapsed().as_millis() as f64)
+    }
+
+    fn async_promise_method(&mut self, ms: Number) -> AsyncPromise<Number> {
+        Box::pin(async move {
+            craby::executor::sleep(Duration::from_millis(ms as u64)).await;
+            promise::resolve(ms)
+        })
+    }
+
     fn set_state(&mut self, arg: Number) -> Void {
         self.state = Some(arg);
+        self.position.write(&Position { x: arg, y: -arg });
     }
 
     fn get_state(&mut self) -> Number {
@@ -111,7 +145,12 @@ impl CrabyTestSpec for CrabyTest {
     }
 
     fn write_data(&mut self, value: &str) -> Boolean {
-        std::fs::write(self.get_file_path(), value).is_ok()
+        // Replaced instead of rewritten in place, the file may be mapped by `map_data`
+        let path = self.get_file_path();
+        let temp_path = path.with_extension("txt.tmp");
+        std::fs::write(&temp_path, value)
+            .and_then(|_| std::fs::rename(&temp_path, &path))
+            .is_ok()
     }
 
     fn read_data(&mut self) -> Nullable<String> {
@@ -121,6 +160,45 @@ impl CrabyTestSpec for CrabyTest {
         }
     }
 
+    fn map_data(&mut self) -> MappedFile {
+        match self.ctx.map_file("data.txt") {
+            Ok(file) => file,
+            Err(e) => throw!("{e}"),
+        }
+    }
+
+    fn open_data_stream(&mut self) -> ByteStream {
+        let (mut writer, stream) = stream::readable(4);
+        let path = self.get_file_path();
+
+        thread::spawn(move || {
+            let copied = File::open(path).and_then(|mut file| io::copy(&mut file, &mut writer));
+            if let Err(err) = copied {
+                writer.abort(err);
+            }
+        });
+
+        stream
+    }
+
+    fn create_data_stream(&mut self) -> ByteStream {
+        let (mut reader, stream) = stream::writable(4);
+        let path = self.get_file_path();
+
+        thread::spawn(move || {
+            // Dropping the reader on failure closes the stream, rejecting the pending `write()`
+            if let Ok(mut file) = File::create(path) {
+                let _ = io::copy(&mut reader, &mut file);
+            }
+        });
+
+        stream
+    }
+
+    fn position_state(&mut self) -> SharedState<Position> {
+        self.position.clone()
+    }
+
     fn trigger_signal(&mut self) -> Promise<Void> {
         self.emit(CrabyTestSignal::OnSignal);
         for i in 0..10 {
@@ -10,6 +10,11 @@ use bridging::*;
 
 #[cxx::bridge(namespace = "craby::crabytest::bridging")]
 pub mod bridging {
+    #[derive(Clone)]
+    struct MyModuleError {
+        reason: String,
+    }
+
     #[derive(Clone)]
     struct NullableString {
         null: bool,
@@ -17,31 +22,31 @@ pub mod bridging {
     }
 
     #[derive(Clone)]
-    struct TestObject {
-        foo: String,
-        bar: f64,
-        baz: bool,
-        sub: NullableSubObject,
-        camel_case: f64,
-        pascal_case: f64,
-        snake_case: f64,
+    struct NullableNumber {
+        null: bool,
+        val: f64,
     }
 
     #[derive(Clone)]
-    struct ProgressEvent {
-        progress: f64,
+    struct Position {
+        x: f64,
+        y: f64,
     }
 
     #[derive(Clone)]
-    struct MyModuleError {
-        reason: String,
+    struct ProgressEvent {
+        progress: f64,
     }
 
     #[derive(Clone)]
-    struct SubObject {
-        a: NullableString,
-        b: f64,
-        c: bool,
+    struct TestObject {
+        foo: String,
+        bar: f64,
+        baz: bool,
+        sub: NullableSubObject,
+        camel_case: f64,
+        pascal_case: f64,
+        snake_case: f64,
     }
 
     #[derive(Clone)]
@@ -51,9 +56,10 @@ pub mod bridging {
     }
 
     #[derive(Clone)]
-    struct NullableNumber {
-        null: bool,
-        val: f64,
+    struct SubObject {
+        a: NullableString,
+        b: f64,
+        c: bool,
     }
 
     enum MyEnum {
@@ -76,32 +82,44 @@ pub mod bridging {
         fn create_calculator(id: usize, data_path: &str) -> Box<Calculator>;
 
         #[cxx_name = "add"]
-        fn calculator_add(it_: &mut Calculator, a: f64, b: f64) -> Result<f64>;
+        fn calculator_add(it_: &mut Calculator, a: f64, b: f64) -> f64;
 
         #[cxx_name = "divide"]
         fn calculator_divide(it_: &mut Calculator, a: f64, b: f64) -> Result<f64>;
 
         #[cxx_name = "multiply"]
-        fn calculator_multiply(it_: &mut Calculator, a: f64, b: f64) -> Result<f64>;
+        fn calculator_multiply(it_: &mut Calculator, a: f64, b: f64) -> f64;
 
         #[cxx_name = "subtract"]
-        fn calculator_subtract(it_: &mut Calculator, a: f64, b: f64) -> Result<f64>;
+        fn calculator_subtract(it_: &mut Calculator, a: f64, b: f64) -> f64;
 
         #[cxx_name = "createCrabyTest"]
         fn create_craby_test(id: usize, data_path: &str) -> Box<CrabyTest>;
 
+        #[cxx_name = "abortablePromiseMethod"]
+        fn craby_test_abortable_promise_method(it_: &mut CrabyTest, ms: f64, signal: &AbortSignal) -> Result<f64>;
+
         #[cxx_name = "arrayBufferMethod"]
-        fn craby_test_array_buffer_method(it_: &mut CrabyTest, arg: Vec<u8>) -> Result<Vec<u8>>;
+        fn craby_test_array_buffer_method(it_: &mut CrabyTest, arg: &mut [u8]) -> Result<Vec<u8>>;
 
         #[cxx_name = "arrayMethod"]
         fn craby_test_array_method(it_: &mut CrabyTest, arg: Vec<f64>) -> Result<Vec<f64>>;
 
+        #[cxx_name = "asyncPromiseMethod"]
+        fn craby_test_async_promise_method(it_: &mut CrabyTest, ms: f64, op: usize) -> Result<()>;
+
+        #[cxx_name = "asyncPromiseMethodResult"]
+        fn craby_test_async_promise_method_result(ret: usize) -> Result<f64>;
+
         #[cxx_name = "booleanMethod"]
         fn craby_test_boolean_method(it_: &mut CrabyTest, arg: bool) -> Result<bool>;
 
         #[cxx_name = "camelMethod"]
         fn craby_test_camel_method(it_: &mut CrabyTest) -> Result<()>;
 
+        #[cxx_name = "createDataStream"]
+        fn craby_test_create_data_stream(it_: &mut CrabyTest) -> Result<Box<ByteStream>>;
+
         #[cxx_name = "enumMethod"]
         fn craby_test_enum_method(it_: &mut CrabyTest, arg_0: MyEnum, arg_1: SwitchState) -> Result<String>;
 
@@ -111,6 +129,9 @@ pub mod bridging {
         #[cxx_name = "getState"]
         fn craby_test_get_state(it_: &mut CrabyTest) -> Result<f64>;
 
+        #[cxx_name = "mapData"]
+        fn craby_test_map_data(it_: &mut CrabyTest) -> Result<Box<MappedFile>>;
+
         #[cxx_name = "nullableMethod"]
         fn craby_test_nullable_method(it_: &mut CrabyTest, arg: NullableNumber) -> Result<NullableNumber>;
 
@@ -120,9 +141,15 @@ pub mod bridging {
         #[cxx_name = "objectMethod"]
         fn craby_test_object_method(it_: &mut CrabyTest, arg: TestObject) -> Result<TestObject>;
 
+        #[cxx_name = "openDataStream"]
+        fn craby_test_open_data_stream(it_: &mut CrabyTest) -> Result<Box<ByteStream>>;
+
         #[cxx_name = "pascalMethod"]
         fn craby_test_pascal_method(it_: &mut CrabyTest) -> Result<()>;
 
+        #[cxx_name = "positionState"]
+        fn craby_test_position_state(it_: &mut CrabyTest) -> Result<Box<SharedMemory>>;
+
         #[cxx_name = "promiseMethod"]
         fn craby_test_promise_method(it_: &mut CrabyTest, arg: f64) -> Result<f64>;
 
@@ -141,8 +168,73 @@ pub mod bridging {
         #[cxx_name = "triggerSignal"]
         fn craby_test_trigger_signal(it_: &mut CrabyTest) -> Result<()>;
 
+        #[cxx_name = "typedArrayMethod"]
+        fn craby_test_typed_array_method(it_: &mut CrabyTest, arg: &mut [f64]) -> Result<Vec<f64>>;
+
         #[cxx_name = "writeData"]
         fn craby_test_write_data(it_: &mut CrabyTest, value: &str) -> Result<bool>;
+
+        #[cxx_name = "recycleBuffer"]
+        fn recycle_buffer(buf: Vec<u8>);
+
+        #[cxx_name = "vecFromF64Slice"]
+        fn vec_from_f64_slice(slice: &[f64]) -> Vec<f64>;
+
+        #[cxx_name = "vecFromF32Slice"]
+        fn vec_from_f32_slice(slice: &[f32]) -> Vec<f32>;
+
+        #[cxx_name = "vecFromI32Slice"]
+        fn vec_from_i32_slice(slice: &[i32]) -> Vec<i32>;
+
+        #[cxx_name = "vecFromI16Slice"]
+        fn vec_from_i16_slice(slice: &[i16]) -> Vec<i16>;
+
+        #[cxx_name = "vecFromU8Slice"]
+        fn vec_from_u8_slice(slice: &[u8]) -> Vec<u8>;
+
+        type ByteStream;
+
+        #[cxx_name = "streamPollRead"]
+        fn stream_poll_read(stream: &ByteStream, op: usize) -> Result<bool>;
+
+        #[cxx_name = "streamTake"]
+        fn stream_take(stream: &ByteStream, size: usize) -> Result<Vec<u8>>;
+
+        #[cxx_name = "streamWrite"]
+        fn stream_write(stream: &ByteStream, chunk: &[u8], op: usize) -> Result<bool>;
+
+        #[cxx_name = "streamFinishWrite"]
+        fn stream_finish_write(stream: &ByteStream) -> Result<()>;
+
+        #[cxx_name = "streamClose"]
+        fn stream_close(stream: &ByteStream);
+
+        type AbortSignal;
+
+        #[cxx_name = "createAbortSignal"]
+        fn create_abort_signal() -> Box<AbortSignal>;
+
+        #[cxx_name = "abortSignalAbort"]
+        fn abort_signal_abort(signal: &AbortSignal);
+
+        #[cxx_name = "abortSignalAborted"]
+        fn abort_signal_aborted(signal: &AbortSignal) -> bool;
+
+        type SharedMemory;
+
+        #[cxx_name = "sharedMemoryData"]
+        fn shared_memory_data(memory: &SharedMemory) -> usize;
+
+        #[cxx_name = "sharedMemorySize"]
+        fn shared_memory_size(memory: &SharedMemory) -> usize;
+
+        type MappedFile;
+
+        #[cxx_name = "mappedFileData"]
+        fn mapped_file_data(file: &MappedFile) -> usize;
+
+        #[cxx_name = "mappedFileSize"]
+        fn mapped_file_size(file: &MappedFile) -> usize;
     }
 
     extern "Rust" {
@@ -158,11 +250,27 @@ pub mod bridging {
 
         type SignalManager;
 
-        unsafe fn emit(self: &SignalManager, id: usize, name: &str, signal: *mut CrabyTestSignal);
+        unsafe fn emit(self: &SignalManager, id: usize, signal_id: u32, signal: *mut CrabyTestSignal);
     
         #[rust_name = "get_signal_manager"]
         fn getSignalManager() -> &'static SignalManager;
     }
+
+    #[namespace = "craby::crabytest::streams"]
+    unsafe extern "C++" {
+        include!("CrabyStreams.h");
+
+        #[rust_name = "on_stream_ready"]
+        fn onStreamReady(op: usize);
+    }
+
+    #[namespace = "craby::crabytest::futures"]
+    unsafe extern "C++" {
+        include!("CrabyFutures.h");
+
+        #[rust_name = "on_future_ready"]
+        fn onFutureReady(op: usize, ret: usize);
+    }
 }
 
 fn create_calculator(id: usize, data_path: &str) -> Box<Calculator> {
@@ -170,11 +278,8 @@ fn create_calculator(id: usize, data_path: &str) -> Box<Calculator> {
     Box::new(Calculator::new(ctx))
 }
 
-fn calculator_add(it_: &mut Calculator, a: f64, b: f64) -> Result<f64, anyhow::Error> {
-    craby::catch_panic!({
-        let ret = it_.add(a, b);
-        ret
-    })
+fn calculator_add(it_: &mut Calculator, a: f64, b: f64) -> f64 {
+    it_.add(a, b)
 }
 
 fn calculator_divide(it_: &mut Calculator, a: f64, b: f64) -> Result<f64, anyhow::Error> {
@@ -184,18 +289,12 @@ fn calculator_divide(it_: &mut Calculator, a: f64, b: f64) -> Result<f64, anyhow
     })
 }
 
-fn calculator_multiply(it_: &mut Calculator, a: f64, b: f64) -> Result<f64, anyhow::Error> {
-    craby::catch_panic!({
-        let ret = it_.multiply(a, b);
-        ret
-    })
+fn calculator_multiply(it_: &mut Calculator, a: f64, b: f64) -> f64 {
+    it_.multiply(a, b)
 }
 
-fn calculator_subtract(it_: &mut Calculator, a: f64, b: f64) -> Result<f64, anyhow::Error> {
-    craby::catch_panic!({
-        let ret = it_.subtract(a, b);
-        ret
-    })
+fn calculator_subtract(it_: &mut Calculator, a: f64, b: f64) -> f64 {
+    it_.subtract(a, b)
 }
 
 fn create_craby_test(id: usize, data_path: &str) -> Box<CrabyTest> {
@@ -203,7 +302,14 @@ fn create_craby_test(id: usize, data_path: &str) -> Box<CrabyTest> {
     Box::new(CrabyTest::new(ctx))
 }
 
-fn craby_test_array_buffer_method(it_: &mut CrabyTest, arg: Vec<u8>) -> Result<Vec<u8>, anyhow::Error> {
+fn craby_test_abortable_promise_method(it_: &mut CrabyTest, ms: f64, signal: &AbortSignal) -> Result<f64, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.abortable_promise_method(ms, signal.clone());
+        ret
+    }).and_then(|r| r)
+}
+
+fn craby_test_array_buffer_method(it_: &mut CrabyTest, arg: &mut [u8]) -> Result<Vec<u8>, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.array_buffer_method(arg);
         ret
@@ -217,6 +323,20 @@ fn craby_test_array_method(it_: &mut CrabyTest, arg: Vec<f64>) -> Result<Vec<f64
     })
 }
 
+fn craby_test_async_promise_method(it_: &mut CrabyTest, ms: f64, op: usize) -> Result<(), anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.async_promise_method(ms);
+        craby::executor::spawn_promise(ret, move |ret: Result<f64, anyhow::Error>| {
+            on_future_ready(op, Box::into_raw(Box::new(ret)) as usize);
+        });
+    })
+}
+
+fn craby_test_async_promise_method_result(ret: usize) -> Result<f64, anyhow::Error> {
+    // Leaked by `craby_test_async_promise_method` when the future is ready, taken once by its `FutureOp`
+    *unsafe { Box::from_raw(ret as *mut Result<f64, anyhow::Error>) }
+}
+
 fn craby_test_boolean_method(it_: &mut CrabyTest, arg: bool) -> Result<bool, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.boolean_method(arg);
@@ -231,6 +351,13 @@ fn craby_test_camel_method(it_: &mut CrabyTest) -> Result<(), anyhow::Error> {
     })
 }
 
+fn craby_test_create_data_stream(it_: &mut CrabyTest) -> Result<Box<ByteStream>, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.create_data_stream();
+        Box::new(ret)
+    })
+}
+
 fn craby_test_enum_method(it_: &mut CrabyTest, arg_0: MyEnum, arg_1: SwitchState) -> Result<String, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.enum_method(arg_0, arg_1);
@@ -252,6 +379,13 @@ fn craby_test_get_state(it_: &mut CrabyTest) -> Result<f64, anyhow::Error> {
     })
 }
 
+fn craby_test_map_data(it_: &mut CrabyTest) -> Result<Box<MappedFile>, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.map_data();
+        Box::new(ret)
+    })
+}
+
 fn craby_test_nullable_method(it_: &mut CrabyTest, arg: NullableNumber) -> Result<NullableNumber, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.nullable_method(arg.into());
@@ -273,6 +407,13 @@ fn craby_test_object_method(it_: &mut CrabyTest, arg: TestObject) -> Result<Test
     })
 }
 
+fn craby_test_open_data_stream(it_: &mut CrabyTest) -> Result<Box<ByteStream>, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.open_data_stream();
+        Box::new(ret)
+    })
+}
+
 fn craby_test_pascal_method(it_: &mut CrabyTest) -> Result<(), anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.pascal_method();
@@ -280,6 +421,13 @@ fn craby_test_pascal_method(it_: &mut CrabyTest) -> Result<(), anyhow::Error> {
     })
 }
 
+fn craby_test_position_state(it_: &mut CrabyTest) -> Result<Box<SharedMemory>, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.position_state();
+        Box::new(ret.into())
+    })
+}
+
 fn craby_test_promise_method(it_: &mut CrabyTest, arg: f64) -> Result<f64, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.promise_method(arg);
@@ -322,6 +470,13 @@ fn craby_test_trigger_signal(it_: &mut CrabyTest) -> Result<(), anyhow::Error> {
     }).and_then(|r| r)
 }
 
+fn craby_test_typed_array_method(it_: &mut CrabyTest, arg: &mut [f64]) -> Result<Vec<f64>, anyhow::Error> {
+    craby::catch_panic!({
+        let ret = it_.typed_array_method(arg);
+        ret
+    })
+}
+
 fn craby_test_write_data(it_: &mut CrabyTest, value: &str) -> Result<bool, anyhow::Error> {
     craby::catch_panic!({
         let ret = it_.write_data(value);
@@ -329,6 +484,80 @@ fn craby_test_write_data(it_: &mut CrabyTest, value: &str) -> Result<bool, anyho
     })
 }
 
+fn recycle_buffer(buf: Vec<u8>) {
+    craby::pool::recycle(buf);
+}
+
+fn vec_from_f64_slice(slice: &[f64]) -> Vec<f64> {
+    slice.to_vec()
+}
+
+fn vec_from_f32_slice(slice: &[f32]) -> Vec<f32> {
+    slice.to_vec()
+}
+
+fn vec_from_i32_slice(slice: &[i32]) -> Vec<i32> {
+    slice.to_vec()
+}
+
+fn vec_from_i16_slice(slice: &[i16]) -> Vec<i16> {
+    slice.to_vec()
+}
+
+fn vec_from_u8_slice(slice: &[u8]) -> Vec<u8> {
+    let mut buf = craby::pool::take(slice.len());
+    buf.extend_from_slice(slice);
+    buf
+}
+
+fn stream_poll_read(stream: &ByteStream, op: usize) -> Result<bool, anyhow::Error> {
+    stream.poll_read(Box::new(move || on_stream_ready(op)))
+}
+
+fn stream_take(stream: &ByteStream, size: usize) -> Result<Vec<u8>, anyhow::Error> {
+    stream.take(size)
+}
+
+fn stream_write(stream: &ByteStream, chunk: &[u8], op: usize) -> Result<bool, anyhow::Error> {
+    stream.write(chunk, Box::new(move || on_stream_ready(op)))
+}
+
+fn stream_finish_write(stream: &ByteStream) -> Result<(), anyhow::Error> {
+    stream.finish_write()
+}
+
+fn stream_close(stream: &ByteStream) {
+    stream.close();
+}
+
+fn create_abort_signal() -> Box<AbortSignal> {
+    Box::new(AbortSignal::new())
+}
+
+fn abort_signal_abort(signal: &AbortSignal) {
+    signal.abort();
+}
+
+fn abort_signal_aborted(signal: &AbortSignal) -> bool {
+    signal.aborted()
+}
+
+fn shared_memory_data(memory: &SharedMemory) -> usize {
+    memory.data()
+}
+
+fn shared_memory_size(memory: &SharedMemory) -> usize {
+    memory.size()
+}
+
+fn mapped_file_data(file: &MappedFile) -> usize {
+    file.data()
+}
+
+fn mapped_file_size(file: &MappedFile) -> usize {
+    file.size()
+}
+
 fn get_on_error_payload(s: &CrabyTestSignal) -> MyModuleError {
     match s {
         CrabyTestSignal::OnError(payload) => (*payload).clone(),
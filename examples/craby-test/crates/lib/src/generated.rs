@@ -1,5 +1,5 @@
 // Auto generated by Craby. DO NOT EDIT.
-// Hash: 8742d8c38b968c19
+// Hash: cd5578c3aeeac84e
 #[rustfmt::skip]
 use craby::prelude::*;
 
@@ -24,40 +24,47 @@ pub trait CrabyTestSpec {
                 let signal = Box::new(CrabyTestSignal::OnError(data));
                 let signal_ptr = Box::into_raw(signal);
                 unsafe {
-                    manager.emit(self.id(), "onError", signal_ptr);
+                    manager.emit(self.id(), 0, signal_ptr);
                 }
             }
             CrabyTestSignal::OnProgress(data) => {
                 let signal = Box::new(CrabyTestSignal::OnProgress(data));
                 let signal_ptr = Box::into_raw(signal);
                 unsafe {
-                    manager.emit(self.id(), "onProgress", signal_ptr);
+                    manager.emit(self.id(), 1, signal_ptr);
                 }
             }
             CrabyTestSignal::OnSignal => {
                 unsafe {
-                    manager.emit(self.id(), "onSignal", std::ptr::null_mut());
+                    manager.emit(self.id(), 2, std::ptr::null_mut());
                 }
             }
         }
     }
-    fn array_buffer_method(&mut self, arg: Vec<u8>) -> Vec<u8>; // TODO: update codegen
+    fn abortable_promise_method(&mut self, ms: Number, signal: AbortSignal) -> Promise<Number>;
+    fn array_buffer_method(&mut self, arg: &mut [u8]) -> ArrayBuffer;
     fn array_method(&mut self, arg: Array<Number>) -> Array<Number>;
+    fn async_promise_method(&mut self, ms: Number) -> AsyncPromise<Number>;
     fn boolean_method(&mut self, arg: Boolean) -> Boolean;
     fn camel_method(&mut self) -> Void;
+    fn create_data_stream(&mut self) -> ByteStream;
     fn enum_method(&mut self, arg_0: MyEnum, arg_1: SwitchState) -> String;
     fn get_data_path(&mut self) -> String;
     fn get_state(&mut self) -> Number;
+    fn map_data(&mut self) -> MappedFile;
     fn nullable_method(&mut self, arg: Nullable<Number>) -> Nullable<Number>;
     fn numeric_method(&mut self, arg: Number) -> Number;
     fn object_method(&mut self, arg: TestObject) -> TestObject;
+    fn open_data_stream(&mut self) -> ByteStream;
     fn pascal_method(&mut self) -> Void;
+    fn position_state(&mut self) -> SharedState<Position>;
     fn promise_method(&mut self, arg: Number) -> Promise<Number>;
     fn read_data(&mut self) -> Nullable<String>;
     fn set_state(&mut self, arg: Number) -> Void;
     fn snake_method(&mut self) -> Void;
     fn string_method(&mut self, arg: &str) -> String;
     fn trigger_signal(&mut self) -> Promise<Void>;
+    fn typed_array_method(&mut self, arg: &mut [f64]) -> Float64Array;
     fn write_data(&mut self, value: &str) -> Boolean;
 }
 
@@ -67,10 +74,11 @@ pub enum CrabyTestSignal {
     OnSignal,
 }
 
-impl Default for ProgressEvent {
+impl Default for Position {
     fn default() -> Self {
-        ProgressEvent {
-            progress: 0.0
+        Position {
+            x: 0.0,
+            y: 0.0
         }
     }
 }
@@ -107,32 +115,6 @@ impl Default for SwitchState {
     }
 }
 
-impl Default for NullableString {
-    fn default() -> Self {
-        NullableString {
-            null: true,
-            val: String::default(),
-        }
-    }
-}
-
-impl From<NullableString> for Nullable<String> {
-    fn from(val: NullableString) -> Self {
-        Nullable::new(if val.null { None } else { Some(val.val) })
-    }
-}
-
-impl From<Nullable<String>> for NullableString {
-    fn from(val: Nullable<String>) -> Self {
-        let val = val.into_value();
-        let null = val.is_none();
-        NullableString {
-            val: val.unwrap_or(String::default()),
-            null,
-        }
-    }
-}
-
 impl Default for NullableNumber {
     fn default() -> Self {
         NullableNumber {
@@ -159,6 +141,20 @@ impl From<Nullable<Number>> for NullableNumber {
     }
 }
 
+impl Default for MyEnum {
+    fn default() -> Self {
+        MyEnum::Foo
+    }
+}
+
+impl Default for MyModuleError {
+    fn default() -> Self {
+        MyModuleError {
+            reason: String::default()
+        }
+    }
+}
+
 impl Default for TestObject {
     fn default() -> Self {
         TestObject {
@@ -173,26 +169,62 @@ impl Default for TestObject {
     }
 }
 
-impl Default for MyModuleError {
+impl Default for SubObject {
     fn default() -> Self {
-        MyModuleError {
-            reason: String::default()
+        SubObject {
+            a: NullableString::default(),
+            b: 0.0,
+            c: false
         }
     }
 }
 
-impl Default for MyEnum {
+impl craby::shared::SharedFields for Position {
+    const COUNT: usize = 2;
+
+    fn store_fields(&self, mut store: impl FnMut(usize, f64)) {
+        store(0, self.x);
+        store(1, self.y);
+    }
+
+    fn load_fields(mut load: impl FnMut(usize) -> f64) -> Self {
+        Position {
+            x: load(0),
+            y: load(1),
+        }
+    }
+}
+
+impl Default for ProgressEvent {
     fn default() -> Self {
-        MyEnum::Foo
+        ProgressEvent {
+            progress: 0.0
+        }
     }
 }
 
-impl Default for SubObject {
+impl Default for NullableString {
     fn default() -> Self {
-        SubObject {
-            a: NullableString::default(),
-            b: 0.0,
-            c: false
+        NullableString {
+            null: true,
+            val: String::default(),
+        }
+    }
+}
+
+impl From<NullableString> for Nullable<String> {
+    fn from(val: NullableString) -> Self {
+        Nullable::new(if val.null { None } else { Some(val.val) })
+    }
+}
+
+impl From<Nullable<String>> for NullableString {
+    fn from(val: Nullable<String>) -> Self {
+        let val = val.into_value();
+        let null = val.is_none();
+        NullableString {
+            val: val.unwrap_or(String::default()),
+            null,
         }
     }
 }
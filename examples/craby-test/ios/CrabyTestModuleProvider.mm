@@ -10,24 +10,32 @@
 @implementation CrabyTestModuleProvider
 
 + (void)load {
-  const char *cDataPath = [[self getDataPath] UTF8String];
-  std::string dataPath(cDataPath);
-
-  craby::crabytest::modules::CxxCalculatorModule::dataPath = dataPath;
-  craby::crabytest::modules::CxxCrabyTestModule::dataPath = dataPath;
-
   facebook::react::registerCxxModuleToGlobalModuleMap(
       craby::crabytest::modules::CxxCalculatorModule::kModuleName,
       [](std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
+        [CrabyTestModuleProvider prepareDataPath];
         return std::make_shared<craby::crabytest::modules::CxxCalculatorModule>(jsInvoker);
       });
   facebook::react::registerCxxModuleToGlobalModuleMap(
       craby::crabytest::modules::CxxCrabyTestModule::kModuleName,
       [](std::shared_ptr<facebook::react::CallInvoker> jsInvoker) {
+        [CrabyTestModuleProvider prepareDataPath];
         return std::make_shared<craby::crabytest::modules::CxxCrabyTestModule>(jsInvoker);
       });
 }
 
+// Resolved once the first module is created instead of on `+load`, which runs before `main`
++ (void)prepareDataPath {
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    const char *cDataPath = [[self getDataPath] UTF8String];
+    std::string dataPath(cDataPath);
+
+    craby::crabytest::modules::CxxCalculatorModule::dataPath = dataPath;
+    craby::crabytest::modules::CxxCrabyTestModule::dataPath = dataPath;
+  });
+}
+
 + (NSString *)getDataPath {
   NSString *appGroupID = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"AppGroupID"];
   NSString *dataPath = nil;
@@ -2,8 +2,11 @@ import type { NativeModule } from 'craby-modules';
 import { NativeModuleRegistry } from 'craby-modules';
 
 export interface Spec extends NativeModule {
+  /** @pure */
   add(a: number, b: number): number;
+  /** @pure */
   subtract(a: number, b: number): number;
+  /** @pure */
   multiply(a: number, b: number): number;
   divide(a: number, b: number): number;
 }
@@ -1,4 +1,4 @@
-import type { NativeModule, Signal } from 'craby-modules';
+import type { ByteStream, MappedFile, NativeModule, SharedState, Signal } from 'craby-modules';
 import { NativeModuleRegistry } from 'craby-modules';
 
 export interface TestObject {
@@ -25,6 +25,11 @@ export interface MyModuleError {
   reason: string;
 }
 
+export interface Position {
+  x: number;
+  y: number;
+}
+
 export type MaybeNumber = number | null;
 
 export enum MyEnum {
@@ -45,9 +50,13 @@ export interface Spec extends NativeModule {
   objectMethod(arg: TestObject): TestObject;
   arrayBufferMethod(arg: ArrayBuffer): ArrayBuffer;
   arrayMethod(arg: number[]): number[];
+  typedArrayMethod(arg: Float64Array): Float64Array;
   enumMethod(arg0: MyEnum, arg1: SwitchState): string;
   nullableMethod(arg: number | null): MaybeNumber;
   promiseMethod(arg: number): Promise<number>;
+  abortablePromiseMethod(ms: number, signal: AbortSignal): Promise<number>;
+  /** @executor async */
+  asyncPromiseMethod(ms: number): Promise<number>;
   // Stateful methods
   setState(arg: number): void;
   getState(): number;
@@ -55,6 +64,11 @@ export interface Spec extends NativeModule {
   getDataPath(): string;
   writeData(value: string): boolean;
   readData(): string | null;
+  mapData(): MappedFile;
+  openDataStream(): ByteStream;
+  createDataStream(): ByteStream;
+  // Shared state (written by `setState`)
+  positionState(): SharedState<Position>;
   // Naming conventions
   camelMethod(): void;
   PascalMethod(): void;
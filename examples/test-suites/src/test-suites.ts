@@ -107,6 +107,20 @@ const TEST_SUITES: TestSuite[] = [
     label: 'Array',
     action: () => Module.CrabyTestModule.arrayMethod([1, 2, 3]),
   },
+  {
+    label: 'TypedArray',
+    action: () => {
+      const result = Module.CrabyTestModule.typedArrayMethod(new Float64Array([1, 2, 3]));
+      const type = result instanceof Float64Array ? 'Float64Array' : '';
+
+      assert(type === 'Float64Array', '`typedArrayMethod` result is not a Float64Array');
+
+      return {
+        type,
+        data: Array.from(result),
+      };
+    },
+  },
   {
     label: 'Array',
     action: () => Module.CrabyTestModule.arrayMethod([1, 2, 3]),
@@ -199,6 +213,22 @@ const TEST_SUITES: TestSuite[] = [
       return { write: writeResult, read: readData };
     },
   },
+  {
+    label: 'File I/O',
+    description: '(Memory-mapped)',
+    action: () => {
+      const data = 'Hello, World!';
+
+      const writeResult = Module.CrabyTestModule.writeData(data);
+      assert(writeResult, '`writeData` result is false');
+
+      const buffer = Module.CrabyTestModule.mapData();
+      const mappedData = String.fromCharCode(...new Uint8Array(buffer));
+      assert(mappedData === data, '`mapData` result is incorrect');
+
+      return { byteLength: buffer.byteLength, read: mappedData };
+    },
+  },
   {
     label: 'Panics',
     action: () => {
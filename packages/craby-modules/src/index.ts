@@ -1,9 +1,133 @@
 import { Platform, TurboModuleRegistry } from 'react-native';
 
-type NativeModule = {};
+/**
+ * Call of a module method, run by `batch()`.
+ */
+type BatchOp = {
+  method: string;
+  args: unknown[];
+};
+
+type NativeModule = {
+  /**
+   * Runs the calls in one native call and returns their results in the same order.
+   *
+   * Each call behaves as if it was called directly (e.g. `Promise` methods return their promises).
+   * Throws on the first failing call, the calls before it have already run.
+   */
+  batch(ops: BatchOp[]): unknown[];
+  /**
+   * Latency stats of the module methods and signals, keyed by name.
+   *
+   * Only available when the modules are generated with `[codegen] stats` of `craby.toml`.
+   */
+  __crabyStats?(): Record<string, MethodStats>;
+};
+
+/**
+ * Durations of a call phase in milliseconds.
+ *
+ * Percentiles are the upper bounds of log2 histogram buckets, so they are approximate.
+ */
+type PhaseStats = {
+  count: number;
+  total: number;
+  max: number;
+  p50: number;
+  p90: number;
+  p99: number;
+};
+
+/**
+ * Stats of a method (or signal), phases without records are omitted.
+ */
+type MethodStats = {
+  count: number;
+  errors: number;
+  fromJs?: PhaseStats;
+  rust?: PhaseStats;
+  toJs?: PhaseStats;
+  queue?: PhaseStats;
+  signal?: PhaseStats;
+};
 
 type Signal<T = void> = (handler: (data: T) => void) => () => void;
 
+/**
+ * Read-only array returned from native without converting its elements up front.
+ *
+ * Elements are converted when their index is read. Use `Array.from()` to get a plain array.
+ * Only supported as the return type of sync methods.
+ */
+type LazyArray<T> = {
+  readonly length: number;
+  readonly [index: number]: T;
+};
+
+/**
+ * One end of a byte stream returned from native, for transferring large payloads in chunks.
+ *
+ * - `read(size)` resolves with up to `size` bytes, or an empty `ArrayBuffer` at the end of the stream.
+ * - `write(chunk)` resolves once the chunk is queued, so it waits while the native side is behind.
+ * - `close()` releases the stream, the native side sees it as closed.
+ *
+ * Only supported as the return type of sync methods.
+ */
+type ByteStream = {
+  read(size: number): Promise<ArrayBuffer>;
+  write(chunk: ArrayBuffer): Promise<void>;
+  close(): void;
+};
+
+/**
+ * File memory-mapped by native, viewed as an `ArrayBuffer` without copying the file.
+ *
+ * The buffer is read-only, writing it crashes the app. Only supported as the return type of sync methods.
+ */
+type MappedFile = ArrayBuffer;
+
+/**
+ * State written by native and read by JS without a native call, returned from native once.
+ *
+ * `sequence` and `values` are separate views of the native memory `[sequence, ...fields]`.
+ * Read them with `readSharedState()`, which returns a copy of the fields. Don't write the views:
+ * native overwrites them on its next write. Only supported as the return type of sync methods.
+ */
+type SharedState<T> = {
+  readonly sequence: Int32Array;
+  readonly values: Float64Array;
+  readonly fields: readonly (keyof T & string)[];
+};
+
+// Falls back to a plain read on engines without `Atomics`
+const loadSequence: (sequence: Int32Array) => number =
+  typeof Atomics !== 'undefined' ? (sequence) => Atomics.load(sequence, 0) : (sequence) => sequence[0];
+
+/**
+ * Reads the latest value of the shared state.
+ *
+ * The sequence is odd while native writes the state and changes on every write,
+ * so the read is retried instead of returning fields of different writes.
+ * Each field is a single aligned 64-bit load, so a field is never torn.
+ */
+export function readSharedState<T>(state: SharedState<T>): T {
+  const { sequence, values, fields } = state;
+
+  for (;;) {
+    const seq = loadSequence(sequence);
+    if ((seq & 1) === 0) {
+      const value = {} as Record<string, number>;
+      for (let i = 0; i < fields.length; i++) {
+        value[fields[i]] = values[i];
+      }
+
+      if (loadSequence(sequence) === seq) {
+        return value as T;
+      }
+    }
+  }
+}
+
 /**
  * Android JNI initialization workaround
  *
@@ -27,6 +151,18 @@ function prepareJNI(moduleName: string) {
   TurboModuleRegistry.get(`__craby${moduleName}_JNI_prepare__`);
 }
 
+/**
+ * Returns the module installed into the current runtime by `installModules()` of `CrabyRuntime.hpp`
+ * (e.g. a worklet or worker runtime), or `null` if it's not installed.
+ *
+ * The module has its own native instance, separate from the one returned by `NativeModuleRegistry` on the main runtime.
+ */
+export function getRuntimeModule<T extends NativeModule>(moduleName: string): T | null {
+  'worklet';
+  const modules = (globalThis as { __crabyModules?: Record<string, unknown> }).__crabyModules;
+  return (modules?.[moduleName] as T | undefined) ?? null;
+}
+
 interface NativeModuleRegistry {
   get<T extends NativeModule>(moduleName: string): T | null;
   getEnforcing<T extends NativeModule>(moduleName: string): T;
@@ -43,4 +179,14 @@ export const NativeModuleRegistry: NativeModuleRegistry = {
   },
 };
 
-export type { NativeModule, Signal };
+export type {
+  BatchOp,
+  ByteStream,
+  LazyArray,
+  MappedFile,
+  MethodStats,
+  NativeModule,
+  PhaseStats,
+  SharedState,
+  Signal,
+};
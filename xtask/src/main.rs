@@ -13,8 +13,9 @@ fn main() -> Result<()> {
         Some("publish") => tasks::publish::run(),
         Some("prepare") => tasks::prepare::run(opt.as_deref()),
         Some("build") => tasks::build::run(),
+        Some("bench") => tasks::bench::run(opt.as_deref()),
         _ => {
-            eprintln!("Usage: cargo xtask [version|publish]");
+            eprintln!("Usage: cargo xtask [version|publish|bench]");
             std::process::exit(1);
         }
     }
@@ -0,0 +1,136 @@
+use anyhow::Result;
+use std::env;
+use std::path::Path;
+use std::process::{Command, Stdio};
+
+use crate::utils::run_command;
+
+const TEST_PROJECT_DIR: &str = "examples/craby-test";
+
+/// Crates of this repository that `craby-test` depends on through crates.io
+const PATCHED_CRATES: [(&str, &str); 2] = [
+    ("craby", "crates/craby"),
+    ("craby_build", "crates/craby_build"),
+];
+
+pub fn run(opt: Option<&str>) -> Result<()> {
+    // `--build-only` checks that the benchmark still builds, `--smoke` also runs every case a few times (CI).
+    // Otherwise `opt` filters the cases
+    let build_only = opt == Some("--build-only");
+    let smoke = opt == Some("--smoke");
+    let filter = opt.filter(|_| !build_only && !smoke);
+
+    println!("Benchmarking...");
+
+    let project_dir = Path::new(TEST_PROJECT_DIR);
+    let bench_dir = project_dir.join("bench");
+    let build_dir = bench_dir.join("build");
+
+    // Host build of the Rust library (same profile as the shipped binaries)
+    let out_dir = build_host_lib(project_dir)?;
+    let lib_path = project_dir.join("target/release/libcrabytest.a");
+
+    let mut configure_args = vec![
+        "-S".to_string(),
+        bench_dir.to_string_lossy().to_string(),
+        "-B".to_string(),
+        build_dir.to_string_lossy().to_string(),
+        "-DCMAKE_BUILD_TYPE=Release".to_string(),
+        format!("-DCRABY_LIB={}", lib_path.canonicalize()?.display()),
+        format!("-DCRABY_CXXBRIDGE_DIR={}/cxxbridge", out_dir),
+    ];
+    if let Ok(hermes_dir) = env::var("HERMES_DIR") {
+        configure_args.push(format!("-DHERMES_DIR={}", hermes_dir));
+    }
+
+    run_command(
+        "cmake",
+        &configure_args
+            .iter()
+            .map(|s| s.as_str())
+            .collect::<Vec<_>>(),
+        None,
+    )?;
+    run_command(
+        "cmake",
+        &[
+            "--build",
+            build_dir.to_string_lossy().as_ref(),
+            "--config",
+            "Release",
+        ],
+        None,
+    )?;
+
+    if build_only {
+        println!("Benchmark built");
+        return Ok(());
+    }
+
+    let bench_bin = build_dir.join("craby-bench");
+    let suite_path = bench_dir.join("suite.js");
+    let mut bench_args = vec![suite_path.to_string_lossy().to_string()];
+    if let Some(filter) = filter {
+        bench_args.push("--filter".to_string());
+        bench_args.push(filter.to_string());
+    }
+    if smoke {
+        bench_args.extend(["--iterations", "10", "--warmup", "1"].map(String::from));
+    }
+
+    run_command(
+        bench_bin.to_string_lossy().as_ref(),
+        &bench_args.iter().map(|s| s.as_str()).collect::<Vec<_>>(),
+        None,
+    )?;
+
+    println!("Benchmark completed");
+
+    Ok(())
+}
+
+/// Builds the Rust library for the host and returns the `OUT_DIR` of its build script,
+/// which holds the `cxxbridge` headers.
+///
+/// The `craby` crates are patched with the ones of this repository, so the benchmark measures
+/// the runtime that matches the generated code instead of the published release.
+fn build_host_lib(project_dir: &Path) -> Result<String> {
+    let mut args = vec![
+        "build".to_string(),
+        "--release".to_string(),
+        "--message-format=json".to_string(),
+    ];
+    for (name, path) in PATCHED_CRATES {
+        let path = Path::new(path).canonicalize()?;
+        args.push("--config".to_string());
+        args.push(format!(
+            "patch.crates-io.{name}.path={:?}",
+            path.to_string_lossy()
+        ));
+    }
+
+    let output = Command::new("cargo")
+        .args(&args)
+        .current_dir(project_dir)
+        .stderr(Stdio::inherit())
+        .output()?;
+
+    if !output.status.success() {
+        anyhow::bail!(
+            "Command exited with code {}",
+            output.status.code().unwrap_or(-1)
+        );
+    }
+
+    String::from_utf8(output.stdout)?
+        .lines()
+        .filter_map(|line| serde_json::from_str::<serde_json::Value>(line).ok())
+        .find(|message| {
+            message["reason"] == "build-script-executed"
+                && message["package_id"]
+                    .as_str()
+                    .is_some_and(|id| id.contains("craby_test"))
+        })
+        .and_then(|message| message["out_dir"].as_str().map(String::from))
+        .ok_or_else(|| anyhow::anyhow!("Build script output of `craby_test` not found"))
+}